@@ -0,0 +1,93 @@
+// 任务调度器扩展性基准: 线程数从1增加到N,分别测量parallelFor计算吞吐和小任务调度开销
+// 用法: job_system_bench [最大线程数]
+#include "engine/core/job_system.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr size_t ELEMENT_COUNT = 1 << 22;
+    constexpr int BATCH_COUNT = 200;
+    constexpr int BATCH_SIZE = 512;
+    constexpr int REPEAT = 5;
+
+    double elapsedMs(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    /// @brief 每个元素做一点浮点运算,模拟动画/粒子之类的逐元素更新
+    double runParallelFor(engine::core::JobSystem &job_system, std::vector<float> &values)
+    {
+        const auto start = Clock::now();
+        job_system.parallelFor(0, values.size(), [&values](size_t i)
+                               {
+                                   float value = values[i];
+                                   for (int k = 0; k < 16; ++k)
+                                   {
+                                       value = std::sqrt(value * value + 1.0f) * 0.5f;
+                                   }
+                                   values[i] = value; });
+        return elapsedMs(start);
+    }
+
+    /// @brief 分批提交大量几乎不做事的任务,测量调度本身的开销
+    double runTinyJobs(engine::core::JobSystem &job_system, std::atomic<int> &sink)
+    {
+        const auto start = Clock::now();
+        for (int batch = 0; batch < BATCH_COUNT; ++batch)
+        {
+            engine::core::JobCounter counter;
+            for (int i = 0; i < BATCH_SIZE; ++i)
+            {
+                job_system.schedule([&sink]()
+                                    { sink.fetch_add(1, std::memory_order_relaxed); },
+                                    &counter);
+            }
+            job_system.wait(counter);
+        }
+        return elapsedMs(start);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const unsigned hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+    const unsigned max_threads = argc > 1 ? static_cast<unsigned>(std::stoul(argv[1])) : hardware_threads;
+    spdlog::set_level(spdlog::level::warn);
+
+    std::printf("hardware threads: %u, parallelFor over %zu elements, %d x %d tiny jobs, best of %d\n",
+                hardware_threads, ELEMENT_COUNT, BATCH_COUNT, BATCH_SIZE, REPEAT);
+    std::printf("%7s %14s %8s %14s %12s\n", "threads", "parallelFor ms", "speedup", "tiny jobs ms", "ns per job");
+
+    std::vector<float> values(ELEMENT_COUNT, 1.0f);
+    std::atomic<int> sink{0};
+    double base_ms = 0.0;
+    for (unsigned threads = 1; threads <= max_threads; ++threads)
+    {
+        engine::core::JobSystem job_system(threads);
+        double parallel_ms = 1e30;
+        double tiny_ms = 1e30;
+        for (int repeat = 0; repeat < REPEAT; ++repeat)
+        {
+            parallel_ms = std::min(parallel_ms, runParallelFor(job_system, values));
+            tiny_ms = std::min(tiny_ms, runTinyJobs(job_system, sink));
+        }
+        if (threads == 1)
+        {
+            base_ms = parallel_ms;
+        }
+        std::printf("%7u %14.2f %7.2fx %14.2f %12.1f\n", threads, parallel_ms, base_ms / parallel_ms, tiny_ms,
+                    tiny_ms * 1e6 / (BATCH_COUNT * BATCH_SIZE));
+    }
+    return sink.load() > 0 ? 0 : 1;
+}
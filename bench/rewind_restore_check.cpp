@@ -0,0 +1,162 @@
+// 快照/回溯恢复检查: 恢复到不含某个播放中动画对象的帧后,该对象不应再被动画系统推进
+// 用法: rewind_restore_check,需在项目根目录运行(读取特效纹理);失败时返回1。建议在AddressSanitizer下构建运行
+#include "engine/component/animation_component.h"
+#include "engine/core/config.h"
+#include "engine/core/context.h"
+#include "engine/core/headless_runner.h"
+#include "engine/object/game_object.h"
+#include "engine/object/prefab.h"
+#include "engine/render/animation_system.h"
+#include "engine/scene/scene.h"
+#include "engine/scene/scene_manager.h"
+#include <spdlog/spdlog.h>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /// @brief 循环播放的特效对象,创建后即登记到动画系统
+    engine::object::Prefab makeEffectPrefab()
+    {
+        engine::object::Prefab prefab;
+        prefab.name = "check_effect";
+        prefab.sprite = engine::render::Sprite("assets/textures/FX/enemy-deadth.png");
+        engine::object::PrefabAnimation animation;
+        animation.name = "effect";
+        for (int i = 0; i < 5; ++i)
+        {
+            animation.frames.push_back({{i * 40, 0, 40, 41}, 0.1f});
+        }
+        prefab.animations.push_back(std::move(animation));
+        prefab.autoplay_animation = "effect";
+        return prefab;
+    }
+
+    class RewindRestoreCheckScene final : public engine::scene::Scene
+    {
+        engine::object::Prefab _prefab;
+        uint64_t _frame{0};
+        std::vector<std::string> &_failures;
+
+    public:
+        RewindRestoreCheckScene(engine::core::Context &context, engine::scene::SceneManager &scene_manager, std::vector<std::string> &failures)
+            : Scene("RewindRestoreCheckScene", context, scene_manager), _prefab(makeEffectPrefab()), _failures(failures)
+        {
+        }
+
+        void init() override
+        {
+            spawn();
+            Scene::init();
+            enableRewind(1.0f, 1024 * 1024);
+        }
+
+        void update(float dt) override
+        {
+            switch (_frame)
+            {
+            case 0:
+                captureSnapshot();
+                break;
+            case 2:
+                // 快照和前几帧回溯记录中都没有这个对象
+                spawn();
+                break;
+            case 5:
+                // 回到新对象加入之前: 它被回溯历史引用而暂存,不应继续播放
+                while (countPlaying() > 1)
+                {
+                    if (!rewindStep())
+                    {
+                        _failures.push_back("rewind: history ran out before the spawned object");
+                        break;
+                    }
+                }
+                expectBatched("rewind");
+                break;
+            case 8:
+                spawn();
+                break;
+            case 10:
+                // 快照恢复: 快照之后加入的对象被销毁,动画系统不能再持有它们
+                restoreSnapshot();
+                expectBatched("snapshot restore");
+                break;
+            default:
+                break;
+            }
+            // 恢复后继续推进几帧,销毁对象残留在动画系统中时会访问已释放的内存
+            Scene::update(dt);
+            ++_frame;
+        }
+
+        bool isDone() const { return _frame > 14; }
+
+    private:
+        void spawn()
+        {
+            addGameObject(engine::object::PrefabRegistry::instantiate(_prefab, _context, {0.0f, 0.0f}));
+        }
+
+        size_t countPlaying() const
+        {
+            size_t playing = 0;
+            for (const auto &game_object : _game_objects)
+            {
+                auto *animation = game_object ? game_object->getComponent<engine::component::AnimationComponent>() : nullptr;
+                if (animation && animation->isPlaying())
+                {
+                    ++playing;
+                }
+            }
+            return playing;
+        }
+
+        void expectBatched(const char *step)
+        {
+            const size_t expected = countPlaying();
+            const size_t batched = getAnimationSystem().size();
+            std::printf("%-16s objects: %zu, playing: %zu, batched: %zu\n", step, _game_objects.size(), expected, batched);
+            if (expected != 1 || batched != expected)
+            {
+                _failures.push_back(std::string(step) + ": animation system out of sync with scene objects");
+            }
+        }
+    };
+}
+
+int main()
+{
+    spdlog::set_level(spdlog::level::warn);
+
+    engine::core::Config config((std::filesystem::temp_directory_path() / "engine_bench_config.json").string());
+    engine::core::HeadlessRunner runner(config);
+    engine::core::HeadlessRunner::Settings settings;
+    settings.instance_count = 1;
+    settings.max_frames = 30;
+
+    std::vector<std::string> failures;
+    RewindRestoreCheckScene *scene = nullptr;
+    auto scene_factory = [&](size_t, engine::core::Context &context, engine::scene::SceneManager &scene_manager)
+    {
+        auto check_scene = std::make_unique<RewindRestoreCheckScene>(context, scene_manager, failures);
+        scene = check_scene.get();
+        return check_scene;
+    };
+    auto input_script = [&](const engine::core::HeadlessFrame &)
+    { return !scene || !scene->isDone(); };
+    const auto results = runner.run(settings, scene_factory, input_script);
+    if (results.empty() || !results.front().ok)
+    {
+        std::fprintf(stderr, "check failed: %s\n", results.empty() ? "no result" : results.front().error.c_str());
+        return 1;
+    }
+    for (const auto &failure : failures)
+    {
+        std::fprintf(stderr, "FAILED %s\n", failure.c_str());
+    }
+    std::printf("%s\n", failures.empty() ? "rewind restore check passed" : "rewind restore check failed");
+    return failures.empty() ? 0 : 1;
+}
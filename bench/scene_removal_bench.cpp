@@ -0,0 +1,200 @@
+// 场景对象删除基准: 1万个特效对象在场景中持续生成和删除,统计每帧更新和压缩的耗时
+// 用法: scene_removal_bench [对象数] [帧数],需在项目根目录运行(读取特效纹理)
+#include "engine/core/config.h"
+#include "engine/core/context.h"
+#include "engine/core/headless_runner.h"
+#include "engine/object/game_object.h"
+#include "engine/object/prefab.h"
+#include "engine/scene/scene.h"
+#include "engine/scene/scene_manager.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double elapsedUs(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    }
+
+    struct Timings
+    {
+        std::vector<double> churn_update_us;  ///< @brief 每帧删除并补充1%时的更新耗时(不含压缩)
+        std::vector<double> churn_compact_us; ///< @brief 同一帧的压缩耗时
+        double steady_update_us{0.0};         ///< @brief 没有删除时的平均更新耗时
+        double front_compact_us{0.0};         ///< @brief 只删除最前面一个对象(整体前移)的压缩耗时
+        double burst_compact_us{0.0};         ///< @brief 一次删除一半的压缩耗时
+        double drain_compact_us{0.0};         ///< @brief 一次删除全部的压缩耗时
+    };
+
+    double mean(const std::vector<double> &values)
+    {
+        return values.empty() ? 0.0 : std::accumulate(values.begin(), values.end(), 0.0) / static_cast<double>(values.size());
+    }
+
+    /// @brief 与游戏中死亡特效相同的对象: 变换、精灵和循环动画
+    engine::object::Prefab makeEffectPrefab()
+    {
+        engine::object::Prefab prefab;
+        prefab.name = "bench_effect";
+        prefab.sprite = engine::render::Sprite("assets/textures/FX/enemy-deadth.png");
+        prefab.sprite_alignment = engine::utils::Alignment::CENTER;
+        engine::object::PrefabAnimation animation;
+        animation.name = "effect";
+        for (int i = 0; i < 5; ++i)
+        {
+            animation.frames.push_back({{i * 40, 0, 40, 41}, 0.1f});
+        }
+        prefab.animations.push_back(std::move(animation));
+        prefab.autoplay_animation = "effect";
+        return prefab;
+    }
+
+    class RemovalBenchScene final : public engine::scene::Scene
+    {
+        engine::object::Prefab _prefab;
+        size_t _object_count;
+        uint64_t _frames;
+        uint64_t _frame{0};
+        std::mt19937 _random{12345};
+        Timings &_timings;
+        std::vector<engine::object::GameObject *> _victims;
+
+    public:
+        RemovalBenchScene(engine::core::Context &context, engine::scene::SceneManager &scene_manager, size_t object_count, uint64_t frames, Timings &timings)
+            : Scene("RemovalBenchScene", context, scene_manager), _prefab(makeEffectPrefab()), _object_count(object_count), _frames(frames), _timings(timings)
+        {
+        }
+
+        void init() override
+        {
+            spawn(_object_count);
+            Scene::init();
+        }
+
+        void update(float dt) override
+        {
+            if (_frame < 10)
+            {
+                // 预热: 不删除
+                timedUpdate(dt);
+            }
+            else if (_frame < 10 + _frames)
+            {
+                // 每帧删除1%的随机对象并补充同样数量
+                markRandom(_object_count / 100);
+                _timings.churn_compact_us.push_back(timedCompact());
+                _timings.churn_update_us.push_back(timedUpdate(dt));
+                spawn(_object_count / 100);
+            }
+            else if (_frame < 10 + _frames * 2)
+            {
+                _timings.steady_update_us += timedUpdate(dt) / static_cast<double>(_frames);
+            }
+            else if (_frame == 10 + _frames * 2)
+            {
+                safeRemoveGameObject(_game_objects.front().get());
+                _timings.front_compact_us = timedCompact();
+
+                markRandom(_game_objects.size() / 2);
+                _timings.burst_compact_us = timedCompact();
+
+                for (const auto &game_object : _game_objects)
+                {
+                    safeRemoveGameObject(game_object.get());
+                }
+                _timings.drain_compact_us = timedCompact();
+            }
+            ++_frame;
+        }
+
+        bool isDone() const { return _frame > 10 + _frames * 2; }
+
+    private:
+        void spawn(size_t count)
+        {
+            std::uniform_real_distribution<float> position(0.0f, 2000.0f);
+            for (size_t i = 0; i < count; ++i)
+            {
+                addGameObject(engine::object::PrefabRegistry::instantiate(_prefab, _context, {position(_random), position(_random)}));
+            }
+        }
+
+        void markRandom(size_t count)
+        {
+            _victims.clear();
+            for (const auto &game_object : _game_objects)
+            {
+                _victims.push_back(game_object.get());
+            }
+            std::shuffle(_victims.begin(), _victims.end(), _random);
+            _victims.resize(std::min(count, _victims.size()));
+            for (auto *victim : _victims)
+            {
+                safeRemoveGameObject(victim);
+            }
+        }
+
+        double timedCompact()
+        {
+            const auto start = Clock::now();
+            compactGameObjects();
+            return elapsedUs(start);
+        }
+
+        double timedUpdate(float dt)
+        {
+            const auto start = Clock::now();
+            Scene::update(dt);
+            return elapsedUs(start);
+        }
+    };
+}
+
+int main(int argc, char **argv)
+{
+    const size_t object_count = argc > 1 ? std::stoul(argv[1]) : 10000;
+    const uint64_t frames = argc > 2 ? std::stoull(argv[2]) : 300;
+    spdlog::set_level(spdlog::level::warn);
+
+    engine::core::Config config((std::filesystem::temp_directory_path() / "engine_bench_config.json").string());
+    engine::core::HeadlessRunner runner(config);
+    engine::core::HeadlessRunner::Settings settings;
+    settings.instance_count = 1;
+    settings.max_frames = frames * 2 + 20;
+
+    Timings timings;
+    RemovalBenchScene *scene = nullptr;
+    auto scene_factory = [&](size_t, engine::core::Context &context, engine::scene::SceneManager &scene_manager)
+    {
+        auto bench_scene = std::make_unique<RemovalBenchScene>(context, scene_manager, object_count, frames, timings);
+        scene = bench_scene.get();
+        return bench_scene;
+    };
+    auto input_script = [&](const engine::core::HeadlessFrame &)
+    { return !scene || !scene->isDone(); };
+    const auto results = runner.run(settings, scene_factory, input_script);
+    if (results.empty() || !results.front().ok)
+    {
+        std::fprintf(stderr, "bench failed: %s\n", results.empty() ? "no result" : results.front().error.c_str());
+        return 1;
+    }
+
+    std::printf("objects: %zu, frames per phase: %llu\n", object_count, static_cast<unsigned long long>(frames));
+    std::printf("update, no removals:          %9.1f us/frame\n", timings.steady_update_us);
+    std::printf("update, 1%% removed + added:   %9.1f us/frame\n", mean(timings.churn_update_us));
+    std::printf("compact, 1%% removed:          %9.1f us/frame\n", mean(timings.churn_compact_us));
+    std::printf("compact, first object removed: %9.1f us\n", timings.front_compact_us);
+    std::printf("compact, half removed:         %9.1f us\n", timings.burst_compact_us);
+    std::printf("compact, all removed:          %9.1f us\n", timings.drain_compact_us);
+    return 0;
+}
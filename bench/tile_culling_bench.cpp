@@ -0,0 +1,173 @@
+// 瓦片层裁剪基准: 在生成的1000x200地图上平移相机,统计每帧渲染耗时和实际遍历、绘制的瓦片数
+// 用法: tile_culling_bench [帧数],需在项目根目录运行(读取瓦片集纹理)
+#include "engine/component/tilelayer_component.h"
+#include "engine/component/transform_component.h"
+#include "engine/core/config.h"
+#include "engine/core/context.h"
+#include "engine/core/headless_runner.h"
+#include "engine/object/game_object.h"
+#include "engine/render/camera.h"
+#include "engine/scene/scene.h"
+#include "engine/scene/scene_manager.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    const glm::ivec2 MAP_SIZE{1000, 200};
+    const glm::ivec2 TILE_SIZE{16, 16};
+    constexpr const char *TILESET = "assets/textures/Layers/tileset.png";
+
+    double elapsedUs(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    }
+
+    struct Timings
+    {
+        std::vector<double> render_us;  ///< @brief 每帧Scene::render的耗时
+        size_t max_visited_tiles{0};    ///< @brief 单帧遍历的最多格子数
+        size_t max_drawn_tiles{0};      ///< @brief 单帧提交的最多瓦片数
+        size_t max_drawn_chunks{0};     ///< @brief 单帧绘制的最多区块数
+        size_t baked_chunks{0};         ///< @brief 累计预渲染的区块数
+        size_t chunk_memory{0};         ///< @brief 结束时区块纹理占用的显存(字节)
+    };
+
+    /// @brief 生成地图: 底部若干行地面,上方随机分布的平台,其余为空
+    std::vector<engine::component::TileInfo> generateTiles()
+    {
+        std::mt19937 random(12345);
+        std::uniform_int_distribution<int> platform_length(3, 12);
+        std::uniform_int_distribution<int> tile_column(0, 7);
+        std::vector<engine::component::TileInfo> tiles(static_cast<size_t>(MAP_SIZE.x) * MAP_SIZE.y);
+        auto tile_at = [&](int x, int y) -> engine::component::TileInfo &
+        { return tiles[static_cast<size_t>(y) * MAP_SIZE.x + x]; };
+        auto make_tile = [&](int column, int row, engine::component::TileType type)
+        {
+            return engine::component::TileInfo(engine::render::Sprite(TILESET, SDL_Rect{column * TILE_SIZE.x, row * TILE_SIZE.y, TILE_SIZE.x, TILE_SIZE.y}), type);
+        };
+
+        for (int y = MAP_SIZE.y - 8; y < MAP_SIZE.y; ++y)
+        {
+            for (int x = 0; x < MAP_SIZE.x; ++x)
+            {
+                tile_at(x, y) = make_tile(tile_column(random), 1, engine::component::TileType::SOLID);
+            }
+        }
+        // 每隔几行放置平台,约占地图上方的1/8
+        for (int y = 4; y < MAP_SIZE.y - 10; y += 3)
+        {
+            for (int x = 0; x < MAP_SIZE.x;)
+            {
+                const int length = platform_length(random);
+                for (int i = 0; i < length && x + i < MAP_SIZE.x; ++i)
+                {
+                    tile_at(x + i, y) = make_tile(tile_column(random), 0, engine::component::TileType::NORMAL);
+                }
+                x += length * 3;
+            }
+        }
+        return tiles;
+    }
+
+    class TileCullingBenchScene final : public engine::scene::Scene
+    {
+        uint64_t _frames;
+        uint64_t _frame{0};
+        Timings &_timings;
+        engine::component::TileLayerComponent *_layer = nullptr;
+
+    public:
+        TileCullingBenchScene(engine::core::Context &context, engine::scene::SceneManager &scene_manager, uint64_t frames, Timings &timings)
+            : Scene("TileCullingBenchScene", context, scene_manager), _frames(frames), _timings(timings)
+        {
+        }
+
+        void init() override
+        {
+            auto game_object = std::make_unique<engine::object::GameObject>("bench_tiles");
+            game_object->addComponent<engine::component::TransformComponent>();
+            _layer = game_object->addComponent<engine::component::TileLayerComponent>(TILE_SIZE, MAP_SIZE, generateTiles());
+            addGameObject(std::move(game_object));
+            Scene::init();
+        }
+
+        void update(float dt) override
+        {
+            Scene::update(dt);
+            // 相机沿对角线往返扫过整张地图
+            auto &camera = _context.getCamera();
+            const glm::vec2 travel = glm::vec2(MAP_SIZE * TILE_SIZE) - camera.getViewportSize();
+            const float t = static_cast<float>(_frame % _frames) / static_cast<float>(std::max<uint64_t>(1, _frames - 1));
+            camera.setPosition(travel * t);
+
+            const auto start = Clock::now();
+            Scene::render();
+            _timings.render_us.push_back(elapsedUs(start));
+            _timings.max_visited_tiles = std::max(_timings.max_visited_tiles, _layer->getLastVisitedTiles());
+            _timings.max_drawn_tiles = std::max(_timings.max_drawn_tiles, _layer->getLastDrawnTiles());
+            _timings.max_drawn_chunks = std::max(_timings.max_drawn_chunks, _layer->getLastDrawnChunks());
+            _timings.baked_chunks += _layer->getLastBakedChunks();
+            _timings.chunk_memory = _layer->getChunkMemory();
+            ++_frame;
+        }
+
+        bool isDone() const { return _frame >= _frames; }
+    };
+}
+
+int main(int argc, char **argv)
+{
+    const uint64_t frames = argc > 1 ? std::stoull(argv[1]) : 600;
+    spdlog::set_level(spdlog::level::warn);
+
+    engine::core::Config config((std::filesystem::temp_directory_path() / "engine_bench_config.json").string());
+    engine::core::HeadlessRunner runner(config);
+    engine::core::HeadlessRunner::Settings settings;
+    settings.instance_count = 1;
+    settings.max_frames = frames + 10;
+
+    Timings timings;
+    TileCullingBenchScene *scene = nullptr;
+    auto scene_factory = [&](size_t, engine::core::Context &context, engine::scene::SceneManager &scene_manager)
+    {
+        auto bench_scene = std::make_unique<TileCullingBenchScene>(context, scene_manager, frames, timings);
+        scene = bench_scene.get();
+        return bench_scene;
+    };
+    auto input_script = [&](const engine::core::HeadlessFrame &)
+    { return !scene || !scene->isDone(); };
+    const auto results = runner.run(settings, scene_factory, input_script);
+    if (results.empty() || !results.front().ok || timings.render_us.empty())
+    {
+        std::fprintf(stderr, "bench failed: %s\n", results.empty() ? "no result" : results.front().error.c_str());
+        return 1;
+    }
+
+    auto sorted = timings.render_us;
+    std::sort(sorted.begin(), sorted.end());
+    double total = 0.0;
+    for (double us : sorted)
+    {
+        total += us;
+    }
+    std::printf("map: %dx%d tiles (%zu cells), frames: %zu\n", MAP_SIZE.x, MAP_SIZE.y,
+                static_cast<size_t>(MAP_SIZE.x) * MAP_SIZE.y, sorted.size());
+    std::printf("render avg:    %9.1f us/frame\n", total / static_cast<double>(sorted.size()));
+    std::printf("render median: %9.1f us/frame\n", sorted[sorted.size() / 2]);
+    std::printf("render p99:    %9.1f us/frame\n", sorted[sorted.size() * 99 / 100]);
+    std::printf("render max:    %9.1f us/frame\n", sorted.back());
+    std::printf("max visited tiles per frame: %zu\n", timings.max_visited_tiles);
+    std::printf("max drawn tiles per frame:   %zu\n", timings.max_drawn_tiles);
+    std::printf("max drawn chunks per frame:  %zu, chunks baked: %zu, chunk memory: %zu KB\n",
+                timings.max_drawn_chunks, timings.baked_chunks, timings.chunk_memory / 1024);
+    return 0;
+}
@@ -2,15 +2,21 @@
 #include "../resource/resource_manager.h"
 #include <SDL3_mixer/SDL_mixer.h>
 #include <spdlog/spdlog.h>
+#include "../utils/log.h"
 #include <glm/glm.hpp>
 
-engine::audio::AudioPlayer::AudioPlayer(engine::resource::ResourceManager *resource_manager)
+engine::audio::AudioPlayer::AudioPlayer(engine::resource::ResourceManager *resource_manager, bool enabled)
     : _resource_manager(resource_manager)
 {
     if (!_resource_manager)
     {
         throw std::runtime_error("ResourceManager is nullptr");
     }
+    if (!enabled)
+    {
+        spdlog::info("AudioPlayer disabled");
+        return;
+    }
     _mixer = _resource_manager->getMixer();
     if (!_mixer)
     {
@@ -46,6 +52,10 @@ engine::audio::AudioPlayer::~AudioPlayer()
 
 int engine::audio::AudioPlayer::playSound(const std::string &sound_path, int channel)
 {
+    if (!_mixer)
+    {
+        return -1;
+    }
     MIX_Audio *audio = _resource_manager->loadSound(sound_path);
     if (!audio)
     {
@@ -92,12 +102,16 @@ int engine::audio::AudioPlayer::playSound(const std::string &sound_path, int cha
     }
 
     SDL_DestroyProperties(props);
-    spdlog::info("Playing sound: {}", sound_path);
+    ENGINE_LOG_DEBUG("Playing sound: {}", sound_path);
     return 0;
 }
 
 int engine::audio::AudioPlayer::playMusic(const std::string &music_path, int loops, int fade_in_ms)
 {
+    if (!_mixer)
+    {
+        return -1;
+    }
     if (music_path == _current_music)
     {
         return true;
@@ -150,7 +164,7 @@ int engine::audio::AudioPlayer::playMusic(const std::string &music_path, int loo
 
     SDL_DestroyProperties(props);
     _current_music = music_path;
-    spdlog::info("Playing music: {}", music_path);
+    ENGINE_LOG_DEBUG("Playing music: {}", music_path);
     return 0;
 }
 
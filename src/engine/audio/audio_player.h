@@ -24,7 +24,9 @@ namespace engine::audio
         std::string _current_music;
 
     public:
-        explicit AudioPlayer(engine::resource::ResourceManager *resource_manager);
+        /// @param resource_manager 资源管理器
+        /// @param enabled 为false时不使用混音器,所有播放请求直接忽略(无头运行)
+        explicit AudioPlayer(engine::resource::ResourceManager *resource_manager, bool enabled = true);
         ~AudioPlayer();
 
         AudioPlayer(const AudioPlayer &) = delete;
@@ -2,6 +2,11 @@
 #include "sprite_component.h"
 #include "../object/game_object.h"
 #include "../render/animation.h"
+#include "../utils/binary_stream.h"
+#include "../scene/scene.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
 
 engine::component::AnimationComponent::~AnimationComponent() = default;
 
@@ -44,14 +49,15 @@ void engine::component::AnimationComponent::playAnimation(const std::string &nam
 
     _current_animation = it->second.get();
     _animation_timer = 0.0f; // 重置计时器
-    _is_playing = true;
+    _current_frame_index = NO_FRAME;
 
     // 立即将精灵更新到第一帧
     if (_sprite_component && !_current_animation->isEmpty())
     {
-        const auto &first_frame = _current_animation->getFrame(0.0f);
-        _sprite_component->setSourceRect(first_frame.source_rect);
+        _current_frame_index = 0;
+        _sprite_component->setSourceRect(_current_animation->getFrame(size_t{0}).source_rect);
     }
+    setPlaying(true);
 }
 
 std::string engine::component::AnimationComponent::getCurrentAnimationName() const
@@ -74,6 +80,24 @@ bool engine::component::AnimationComponent::isAnimationFinished() const
 }
 
 void engine::component::AnimationComponent::update(float delta_time, engine::core::Context &)
+{
+    // 在场景中时由AnimationSystem统一推进
+    if (_batch_index == NOT_BATCHED)
+    {
+        advance(delta_time);
+    }
+}
+
+void engine::component::AnimationComponent::clean()
+{
+    if (_batch_index != NOT_BATCHED)
+    {
+        _is_playing = false;
+        notifyPlaybackChanged();
+    }
+}
+
+void engine::component::AnimationComponent::advance(float delta_time)
 {
     if (!_is_playing || !_current_animation || !_sprite_component || _current_animation->isEmpty())
     {
@@ -81,20 +105,82 @@ void engine::component::AnimationComponent::update(float delta_time, engine::cor
     }
 
     // 推进计时器
+    const float total_duration = _current_animation->getTotalDuration();
     _animation_timer += delta_time;
+    bool finished = false;
+    if (_animation_timer >= total_duration)
+    {
+        if (_current_animation->isLooping() && total_duration > 0.0f)
+        {
+            _animation_timer -= total_duration;
+            if (_animation_timer >= total_duration)
+            {
+                _animation_timer = std::fmod(_animation_timer, total_duration);
+            }
+        }
+        else
+        {
+            finished = true;
+        }
+    }
 
-    // 根据时间获取当前帧
-    const auto &current_frame = _current_animation->getFrame(_animation_timer);
-
-    // 更新精灵组件的源矩形
-    _sprite_component->setSourceRect(current_frame.source_rect);
-    if (!_current_animation->isLooping() && _animation_timer >= _current_animation->getTotalDuration())
+    // 只在帧变化时更新精灵组件的源矩形
+    const size_t frame_index = finished ? _current_animation->getFrameCount() - 1 : _current_animation->getFrameIndexInRange(_animation_timer);
+    if (frame_index != _current_frame_index)
     {
+        _current_frame_index = frame_index;
+        _sprite_component->setSourceRect(_current_animation->getFrame(frame_index).source_rect);
+    }
+    if (finished)
+    {
+        // 批量推进时由AnimationSystem检查播放状态并移除,这里不再通知
         _is_playing = false;
-        _animation_timer = _current_animation->getTotalDuration();
+        _animation_timer = total_duration;
         if (_is_one_shot_removal)
         {
             _owner->setNeedRemove(true);
         }
     }
 }
+
+void engine::component::AnimationComponent::notifyPlaybackChanged()
+{
+    if (_owner && _owner->getScene())
+    {
+        _owner->getScene()->onAnimationPlaybackChanged(this);
+    }
+}
+
+void engine::component::AnimationComponent::saveState(engine::utils::BinaryWriter &writer) const
+{
+    // 按名称保存当前动画,未播放过任何动画时写入空名称
+    writer.writeString(_current_animation ? std::string_view(_current_animation->getName()) : std::string_view());
+    writer.write(_animation_timer);
+    writer.write(_is_playing);
+    writer.write(_is_one_shot_removal);
+}
+
+void engine::component::AnimationComponent::loadState(engine::utils::BinaryReader &reader)
+{
+    const auto name = reader.readString();
+    _current_animation = nullptr;
+    if (!name.empty())
+    {
+        auto it = std::find_if(_animations.begin(), _animations.end(), [name](const auto &pair)
+                               { return pair.first == name; });
+        if (it != _animations.end())
+        {
+            _current_animation = it->second.get();
+        }
+        else
+        {
+            spdlog::warn("AnimationComponent: snapshot animation {} not found on {}", name, _owner ? _owner->getName() : "");
+        }
+    }
+    reader.read(_animation_timer);
+    reader.read(_is_playing);
+    reader.read(_is_one_shot_removal);
+    // 精灵的源矩形由精灵组件自己恢复,下次推进时按计时器重新确定当前帧
+    _current_frame_index = NO_FRAME;
+    notifyPlaybackChanged();
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "component.h"
+#include <cstddef>
 #include <string>
 #include <unordered_map>
 #include <memory>
@@ -7,6 +8,7 @@
 namespace engine::render
 {
     class Animation;
+    class AnimationSystem;
 }
 
 namespace engine::component
@@ -16,16 +18,29 @@ namespace engine::component
 
 namespace engine::component
 {
+    /// @brief 播放精灵帧动画。在场景中时由场景的AnimationSystem批量推进,只在帧切换时更新精灵
     class AnimationComponent : public Component
     {
         friend class engine::object::GameObject;
+        friend class engine::render::AnimationSystem;
+
+    public:
+        static constexpr std::string_view TYPE_NAME = "Animation";
+        static constexpr size_t NOT_BATCHED = static_cast<size_t>(-1);
+        /// @brief 精灵尚未显示任何帧,下次推进时重新设置源矩形
+        static constexpr size_t NO_FRAME = static_cast<size_t>(-1);
 
     private:
         std::unordered_map<std::string, std::unique_ptr<engine::render::Animation>> _animations;
         SpriteComponent *_sprite_component = nullptr;
         engine::render::Animation *_current_animation = nullptr;
 
+        /// @brief 循环动画的计时器保持在[0, 总时长)内
         float _animation_timer = 0.0f;
+        /// @brief 精灵当前显示的帧,NO_FRAME表示需要重新设置
+        size_t _current_frame_index = NO_FRAME;
+        /// @brief 在AnimationSystem中的下标,未登记时为NOT_BATCHED
+        size_t _batch_index = NOT_BATCHED;
         bool _is_playing = false;
         bool _is_one_shot_removal = false;
 
@@ -40,8 +55,8 @@ namespace engine::component
         void addAnimation(std::unique_ptr<engine::render::Animation> &&animation);
         void playAnimation(const std::string &name);
 
-        void stopAnimation() { _is_playing = false; }
-        void resumeAnimation() { _is_playing = true; }
+        void stopAnimation() { setPlaying(false); }
+        void resumeAnimation() { setPlaying(true); }
 
         std::string getCurrentAnimationName() const;
         bool isPlaying() const { return _is_playing; }
@@ -52,5 +67,22 @@ namespace engine::component
     protected:
         void init() override;
         void update(float dt, engine::core::Context &) override;
+        void clean() override;
+        void saveState(engine::utils::BinaryWriter &writer) const override;
+        void loadState(engine::utils::BinaryReader &reader) override;
+
+    private:
+        /// @brief 推进计时器,帧变化时才更新精灵
+        void advance(float dt);
+        void setPlaying(bool playing)
+        {
+            if (playing != _is_playing)
+            {
+                _is_playing = playing;
+                notifyPlaybackChanged();
+            }
+        }
+        /// @brief 通知所在场景更新批量推进的登记
+        void notifyPlaybackChanged();
     };
 }
\ No newline at end of file
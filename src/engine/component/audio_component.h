@@ -20,6 +20,9 @@ namespace engine::component
     {
         friend class engine::object::GameObject;
 
+    public:
+        static constexpr std::string_view TYPE_NAME = "Audio";
+
     private:
         engine::audio::AudioPlayer *_audio_player;
         engine::render::Camera *_camera;
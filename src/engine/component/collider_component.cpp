@@ -4,6 +4,7 @@
 #include "transform_component.h"
 #include "../object/game_object.h"
 #include "../physics/physics_engine.h"
+#include "../utils/binary_stream.h"
 engine::component::ColliderComponent::ColliderComponent(std::unique_ptr<engine::physics::Collider> collider, engine::utils::Alignment alignment, bool is_trigger, bool is_active)
     : _collider(std::move(collider)), _alignment(alignment), _is_trigger(is_trigger), _is_active(is_active)
 {
@@ -19,6 +20,7 @@ void engine::component::ColliderComponent::updateOffset()
     {
         return;
     }
+    _world_aabb_version = 0;
     // 获取碰撞盒的大小
     auto collider_size = _collider->getAABBSize();
 
@@ -63,17 +65,20 @@ void engine::component::ColliderComponent::updateOffset()
     }
 }
 
-engine::utils::Rect engine::component::ColliderComponent::getWorldAABB() const
+const engine::utils::Rect &engine::component::ColliderComponent::getWorldAABB() const
 {
     if (!_transform || !_collider)
     {
-        return {glm::vec2(0.0f, 0.0f), glm::vec2(0.0f, 0.0f)};
+        static const engine::utils::Rect empty{glm::vec2(0.0f, 0.0f), glm::vec2(0.0f, 0.0f)};
+        return empty;
     }
-    const glm::vec2 top_left_pos = _transform->getPosition() + _offset;
-    const glm::vec2 base_size = _collider->getAABBSize();
-    const glm::vec2 scale = _transform->getScale();
-    glm::vec2 scaled_size = base_size * scale;
-    return {top_left_pos, scaled_size};
+    if (_world_aabb_version != _transform->getVersion())
+    {
+        _world_aabb.position = _transform->getPosition() + _offset;
+        _world_aabb.size = _collider->getAABBSize() * _transform->getScale();
+        _world_aabb_version = _transform->getVersion();
+    }
+    return _world_aabb;
 }
 
 void engine::component::ColliderComponent::setAlignment(engine::utils::Alignment alignment)
@@ -102,3 +107,15 @@ void engine::component::ColliderComponent::init()
 
     updateOffset();
 }
+
+void engine::component::ColliderComponent::saveState(engine::utils::BinaryWriter &writer) const
+{
+    writer.write(_is_trigger);
+    writer.write(_is_active);
+}
+
+void engine::component::ColliderComponent::loadState(engine::utils::BinaryReader &reader)
+{
+    reader.read(_is_trigger);
+    reader.read(_is_active);
+}
@@ -3,6 +3,7 @@
 #include "../physics/collider.h"
 #include "../utils/math.h"
 #include "../utils/alignment.h"
+#include <cstdint>
 #include <memory>
 
 namespace engine::component
@@ -17,6 +18,9 @@ namespace engine::component
     {
         friend class engine::object::GameObject;
 
+    public:
+        static constexpr std::string_view TYPE_NAME = "Collider";
+
     private:
         TransformComponent *_transform = nullptr;
         /// @brief 碰撞器对象
@@ -29,6 +33,11 @@ namespace engine::component
         /// @brief 是否激活
         bool _is_active = true;
 
+        /// @brief 缓存的世界AABB,变换版本号不变时直接返回
+        mutable engine::utils::Rect _world_aabb{};
+        /// @brief 缓存对应的变换版本号, 0表示缓存无效(变换版本号从1开始)
+        mutable uint32_t _world_aabb_version{0};
+
     public:
         explicit ColliderComponent(std::unique_ptr<engine::physics::Collider> collider,
                                    engine::utils::Alignment alignment = engine::utils::Alignment::NONE,
@@ -42,17 +51,24 @@ namespace engine::component
         const engine::physics::Collider *getCollider() const { return _collider.get(); }
         const glm::vec2 &getOffset() const { return _offset; }
         engine::utils::Alignment getAlignment() const { return _alignment; }
-        engine::utils::Rect getWorldAABB() const;
+        /// @brief 世界坐标下的AABB,变换或偏移未改变时返回缓存
+        const engine::utils::Rect &getWorldAABB() const;
         bool isTrigger() const { return _is_trigger; }
         bool isActive() const { return _is_active; }
 
         void setAlignment(engine::utils::Alignment alignment);
-        void setOffset(const glm::vec2 &offset) { _offset = offset; }
+        void setOffset(const glm::vec2 &offset)
+        {
+            _offset = offset;
+            _world_aabb_version = 0;
+        }
         void setTrigger(bool is_trigger) { _is_trigger = is_trigger; }
         void setActive(bool is_active) { _is_active = is_active; }
 
     private:
         void init() override;
         void update(float, engine::core::Context &) override {}
+        void saveState(engine::utils::BinaryWriter &writer) const override;
+        void loadState(engine::utils::BinaryReader &reader) override;
     };
 }
\ No newline at end of file
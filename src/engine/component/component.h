@@ -1,4 +1,7 @@
 #pragma once
+#include <cstdint>
+#include <string_view>
+
 namespace engine::object
 {
     class GameObject;
@@ -7,9 +10,25 @@ namespace engine::core
 {
     class Context;
 }
+namespace engine::utils
+{
+    class BinaryWriter;
+    class BinaryReader;
+}
 namespace engine::component
 {
+    /// @brief 组件类型名的FNV-1a哈希,跨进程、跨构建不变,用作快照中的组件ID
+    constexpr uint32_t makeComponentTypeId(std::string_view type_name)
+    {
+        uint32_t hash = 2166136261u;
+        for (char c : type_name)
+        {
+            hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+        }
+        return hash;
+    }
 
+    /// @brief 派生组件须声明 static constexpr std::string_view TYPE_NAME,同一对象上的组件名称不能重复
     class Component
     {
         friend class engine::object::GameObject;
@@ -18,7 +37,9 @@ namespace engine::component
         engine::object::GameObject *_owner{nullptr};
 
     private:
-        /* data */
+        /// @brief 由GameObject::addComponent按TYPE_NAME设置
+        uint32_t _type_id{0};
+
     public:
         Component(/* args */) = default;
         virtual ~Component() = default;
@@ -29,6 +50,7 @@ namespace engine::component
 
         void setOwner(engine::object::GameObject *owner) { _owner = owner; }
         engine::object::GameObject *getOwner() const { return _owner; }
+        uint32_t getTypeId() const { return _type_id; }
 
     protected:
         virtual void init() {}
@@ -37,10 +59,20 @@ namespace engine::component
         /// @brief 更新
         /// @param dt
         virtual void update(float dt, engine::core::Context &) {}
+        /// @brief 绘制队列开启之前调用,用于需要直接切换渲染目标的工作(如预渲染到目标纹理)
+        virtual void prepareRender(engine::core::Context &) {}
         /// @brief 渲染
         virtual void render(engine::core::Context &) {}
         /// @brief 清除
         virtual void clean() {}
+        /// @brief 把运行时会变化的状态写入场景快照
+        virtual void saveState(engine::utils::BinaryWriter &) const {}
+        /// @brief 从场景快照恢复状态,读取顺序与saveState写入顺序一致
+        virtual void loadState(engine::utils::BinaryReader &) {}
+        /// @brief 对象被移出场景但为快照保留时调用,解除在引擎模块中的注册
+        virtual void deactivate() {}
+        /// @brief 保留的对象随快照恢复回场景时调用,重新注册到引擎模块
+        virtual void reactivate() {}
     };
 
 } // namespace engine::component
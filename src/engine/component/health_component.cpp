@@ -1,6 +1,7 @@
 #include "health_component.h"
 #include "../../engine/object/game_object.h"
 #include <spdlog/spdlog.h>
+#include "../utils/binary_stream.h"
 #include <glm/common.hpp>
 engine::component::HealthComponent::HealthComponent(int max_health, float invincible_duration)
     : _max_health(glm::max(max_health, 1)), _invincible_duration(invincible_duration), _current_health(max_health)
@@ -73,3 +74,19 @@ void engine::component::HealthComponent::update(float delta_time, engine::core::
         }
     }
 }
+
+void engine::component::HealthComponent::saveState(engine::utils::BinaryWriter &writer) const
+{
+    writer.write(_max_health);
+    writer.write(_current_health);
+    writer.write(_is_invincible);
+    writer.write(_invincible_timer);
+}
+
+void engine::component::HealthComponent::loadState(engine::utils::BinaryReader &reader)
+{
+    reader.read(_max_health);
+    reader.read(_current_health);
+    reader.read(_is_invincible);
+    reader.read(_invincible_timer);
+}
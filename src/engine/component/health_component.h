@@ -8,6 +8,9 @@ namespace engine::component
     {
         friend class engine::object::GameObject;
 
+    public:
+        static constexpr std::string_view TYPE_NAME = "Health";
+
     private:
         int _max_health = 1;
         int _current_health = 1;
@@ -39,5 +42,7 @@ namespace engine::component
 
     protected:
         void update(float delta_time, engine::core::Context &) override;
+        void saveState(engine::utils::BinaryWriter &writer) const override;
+        void loadState(engine::utils::BinaryReader &reader) override;
     };
 } // namespace engine::component
@@ -36,5 +36,5 @@ void engine::component::ParallaxComponent::render(engine::core::Context &context
         /* code */
         return;
     }
-    context.getRender().drawParallx(context.getCamera(), _sprite, _transform->getPosition(), _scroll_factor, _repeat);
+    context.getRender().drawParallx(context.getCamera(), _sprite, _transform->getPosition(), _scroll_factor, _repeat, {1.0f, 1.0f}, _render_order);
 }
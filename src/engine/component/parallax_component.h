@@ -1,6 +1,7 @@
 #pragma once
 #include "component.h"
 #include "../render/sprite.h"
+#include "../render/render_queue.h"
 #include <string>
 #include <glm/vec2.hpp>
 
@@ -12,6 +13,9 @@ namespace engine::component
     {
         friend class engine::object::GameObject;
 
+    public:
+        static constexpr std::string_view TYPE_NAME = "Parallax";
+
     private:
         /// @brief 缓存变换组件
         TransformComponent *_transform{nullptr};
@@ -20,6 +24,7 @@ namespace engine::component
         glm::vec2 _scroll_factor{1.0f, 1.0f};
         glm::bvec2 _repeat;
         bool _is_hidden = false;
+        engine::render::RenderOrder _render_order;
 
     public:
         ParallaxComponent(const std::string &texture_id, const glm::vec2 &scroll_factor, const glm::bvec2 &repeat);
@@ -28,11 +33,14 @@ namespace engine::component
         void setScrollFactor(const glm::vec2 &scroll_factor) { _scroll_factor = scroll_factor; }
         void setRepeat(const glm::bvec2 &repeat) { _repeat = repeat; }
         void setIsHidden(bool is_hidden) { _is_hidden = is_hidden; }
+        void setRenderLayer(uint8_t layer) { _render_order.layer = layer; }
+        void setRenderDepth(int16_t depth) { _render_order.depth = depth; }
 
         const engine::render::Sprite &getSprite() const { return _sprite; }
         const glm::vec2 &getScrollFactor() const { return _scroll_factor; }
         const glm::bvec2 &getRepeat() const { return _repeat; }
         bool getIsHidden() const { return _is_hidden; }
+        const engine::render::RenderOrder &getRenderOrder() const { return _render_order; }
 
     protected:
         void update(float dt, engine::core::Context &) override {}
@@ -2,7 +2,9 @@
 #include "transform_component.h"
 #include "../object/game_object.h"
 #include <spdlog/spdlog.h>
+#include "../utils/log.h"
 #include "../physics/physics_engine.h"
+#include "../utils/binary_stream.h"
 
 engine::component::PhysicsComponent::PhysicsComponent(engine::physics::PhysicsEngine *physics_engine, bool use_gravity, float mass)
     : _physics_engine(physics_engine), _use_gravity(use_gravity), _mass(mass >= 0.0f ? mass : 1.0f)
@@ -11,7 +13,7 @@ engine::component::PhysicsComponent::PhysicsComponent(engine::physics::PhysicsEn
     {
         spdlog::error("Physics engine is null");
     }
-    spdlog::info("Physics component created, useGravity={}", _use_gravity);
+    ENGINE_LOG_TRACE("Physics component created, useGravity={}", _use_gravity);
 }
 
 void engine::component::PhysicsComponent::init()
@@ -33,11 +35,38 @@ void engine::component::PhysicsComponent::init()
         return;
     }
     _physics_engine->registerComponent(this);
-    spdlog::info("Physics component initialized");
+    ENGINE_LOG_TRACE("Physics component initialized");
 }
 
 void engine::component::PhysicsComponent::clean()
 {
     _physics_engine->unregisterComponent(this);
-    spdlog::info("Physics component cleaned");
+    ENGINE_LOG_TRACE("Physics component cleaned");
+}
+
+void engine::component::PhysicsComponent::saveState(engine::utils::BinaryWriter &writer) const
+{
+    writer.write(_velocity);
+    writer.write(_force);
+    writer.write(_use_gravity);
+    writer.write(_enabled);
+}
+
+void engine::component::PhysicsComponent::loadState(engine::utils::BinaryReader &reader)
+{
+    reader.read(_velocity);
+    reader.read(_force);
+    reader.read(_use_gravity);
+    reader.read(_enabled);
+    resetCollidedFlags();
+}
+
+void engine::component::PhysicsComponent::deactivate()
+{
+    _physics_engine->unregisterComponent(this);
+}
+
+void engine::component::PhysicsComponent::reactivate()
+{
+    _physics_engine->registerComponent(this);
 }
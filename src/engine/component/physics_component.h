@@ -16,6 +16,8 @@ namespace engine::component
         friend class engine::object::GameObject;
 
     public:
+        static constexpr std::string_view TYPE_NAME = "Physics";
+
         glm::vec2 _velocity{0.0f, 0.0f}; // 移动速度
 
     private:
@@ -93,5 +95,9 @@ namespace engine::component
         void init() override;
         void update(float dt, engine::core::Context &) override {}
         void clean() override;
+        void saveState(engine::utils::BinaryWriter &writer) const override;
+        void loadState(engine::utils::BinaryReader &reader) override;
+        void deactivate() override;
+        void reactivate() override;
     };
 }
@@ -6,6 +6,7 @@
 #include "../render/camera.h"
 #include "../core/context.h"
 #include "../object/game_object.h"
+#include "../utils/binary_stream.h"
 engine::component::SpriteComponent::SpriteComponent(const std::string &texture_id, engine::resource::ResourceManager &resource_manager, engine::utils::Alignment alignment, std::optional<SDL_Rect> source_rect_opt, bool is_flipped)
     : _resourceManager(&resource_manager), _alignment(alignment), _sprite(texture_id, source_rect_opt, is_flipped)
 {
@@ -26,6 +27,7 @@ engine::component::SpriteComponent::SpriteComponent(engine::render::Sprite &&spr
 
 void engine::component::SpriteComponent::updateOffset()
 {
+    _world_bounds_version = 0;
     if (_sprite_size.x <= 0 || _sprite_size.y <= 0)
     {
         /* code */
@@ -67,6 +69,22 @@ void engine::component::SpriteComponent::updateOffset()
     }
 }
 
+const engine::utils::Rect &engine::component::SpriteComponent::getWorldBounds() const
+{
+    if (!_transform)
+    {
+        static const engine::utils::Rect empty{glm::vec2(0.0f, 0.0f), glm::vec2(0.0f, 0.0f)};
+        return empty;
+    }
+    if (_world_bounds_version != _transform->getVersion())
+    {
+        _world_bounds.position = _transform->getPosition() + _offset;
+        _world_bounds.size = _sprite_size * _transform->getScale();
+        _world_bounds_version = _transform->getVersion();
+    }
+    return _world_bounds;
+}
+
 void engine::component::SpriteComponent::setSpriteById(const std::string &texture_id, const std::optional<SDL_Rect> &source_rect)
 {
     _sprite.setTextureId(texture_id);
@@ -95,14 +113,20 @@ void engine::component::SpriteComponent::updateSpriteSize()
         spdlog::error("ResourceManager is not initialized.");
         return;
     }
+    // 纹理ID改变后在这里解析一次句柄,绘制时不再按字符串查找
+    _sprite.setTextureHandle(_resourceManager->getTextureHandle(_sprite.getTextureId()));
     if (_sprite.getSourceRect().has_value())
     {
         const auto &src_rect = _sprite.getSourceRect().value();
         _sprite_size = {src_rect.w, src_rect.h};
     }
+    else if (const auto *region = _resourceManager->resolveTexture(_sprite.getTextureHandle()); region)
+    {
+        _sprite_size = {region->rect.w, region->rect.h};
+    }
     else
     {
-        _sprite_size = _resourceManager->getTextureSize(_sprite.getTextureId());
+        _sprite_size = {0.0f, 0.0f};
     }
 }
 
@@ -130,8 +154,26 @@ void engine::component::SpriteComponent::render(engine::core::Context &context)
         return;
     }
 
-    const glm::vec2 &position = _transform->getPosition() + _offset;
+    const glm::vec2 &position = getWorldBounds().position;
     const glm::vec2 &scale = _transform->getScale();
     const float rotation = _transform->getRotation();
-    context.getRender().drawSprite(context.getCamera(), _sprite, position, scale, rotation);
+    context.getRender().drawSprite(context.getCamera(), _sprite, position, scale, rotation, _render_order);
+}
+
+void engine::component::SpriteComponent::saveState(engine::utils::BinaryWriter &writer) const
+{
+    // 纹理在运行时不变,只保存动画和翻转会修改的部分
+    writer.write(_sprite.getSourceRect().has_value());
+    writer.write(_sprite.getSourceRect().value_or(SDL_Rect{}));
+    writer.write(_sprite.isFlipped());
+    writer.write(_is_hidden);
+}
+
+void engine::component::SpriteComponent::loadState(engine::utils::BinaryReader &reader)
+{
+    const bool has_source_rect = reader.read<bool>();
+    const auto source_rect = reader.read<SDL_Rect>();
+    setSourceRect(has_source_rect ? std::make_optional(source_rect) : std::nullopt);
+    _sprite.setFlipped(reader.read<bool>());
+    reader.read(_is_hidden);
 }
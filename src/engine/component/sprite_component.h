@@ -1,7 +1,10 @@
 #pragma once
 #include "../render/sprite.h"
+#include "../render/render_queue.h"
 #include "component.h"
 #include "../utils/alignment.h"
+#include "../utils/math.h"
+#include <cstdint>
 #include <optional>
 #include <SDL3/SDL_rect.h>
 #include <glm/vec2.hpp>
@@ -23,6 +26,9 @@ namespace engine::component
     {
         friend class engine::object::GameObject;
 
+    public:
+        static constexpr std::string_view TYPE_NAME = "Sprite";
+
     private:
         engine::resource::ResourceManager *_resourceManager{nullptr};
         TransformComponent *_transform{nullptr};
@@ -33,8 +39,14 @@ namespace engine::component
         engine::utils::Alignment _alignment = engine::utils::Alignment::NONE;
         glm::vec2 _sprite_size{0.0f, 0.0f};
         glm::vec2 _offset{0.0f, 0.0f};
+        /// @brief 缓存的世界包围盒,变换版本号不变时直接返回
+        mutable engine::utils::Rect _world_bounds{};
+        /// @brief 缓存对应的变换版本号, 0表示缓存无效
+        mutable uint32_t _world_bounds_version{0};
         /// @brief 是否隐藏
         bool _is_hidden = false;
+        /// @brief 绘制的层和深度,未设置时画在关卡图层之上
+        engine::render::RenderOrder _render_order;
 
     public:
         SpriteComponent(const std::string &texture_id,
@@ -62,12 +74,18 @@ namespace engine::component
         const glm::vec2 &getOffset() const { return _offset; }
         const glm::vec2 &getSpriteSize() const { return _sprite_size; }
         engine::utils::Alignment getAlignment() const { return _alignment; }
+        const engine::render::RenderOrder &getRenderOrder() const { return _render_order; }
+        /// @brief 世界坐标下的绘制区域(位置含偏移,尺寸含缩放),变换未改变时返回缓存
+        const engine::utils::Rect &getWorldBounds() const;
 
         void setSpriteById(const std::string &texture_id, const std::optional<SDL_Rect> &source_rect = std::nullopt);
         void setSourceRect(const std::optional<SDL_Rect> &source_rect_opt);
         void setFlipped(bool is_flipped) { _sprite.setFlipped(is_flipped); };
         void setAlignment(engine::utils::Alignment anchor);
         void setHidden(bool is_hidden) { _is_hidden = is_hidden; };
+        void setRenderLayer(uint8_t layer) { _render_order.layer = layer; }
+        /// @brief 同层内的先后,数值大的画在上面
+        void setRenderDepth(int16_t depth) { _render_order.depth = depth; }
 
     private:
         void updateSpriteSize();
@@ -75,6 +93,8 @@ namespace engine::component
         void init() override;
         void update(float dt, engine::core::Context &context) override {};
         void render(engine::core::Context &context) override;
+        void saveState(engine::utils::BinaryWriter &writer) const override;
+        void loadState(engine::utils::BinaryReader &reader) override;
     };
 
 }
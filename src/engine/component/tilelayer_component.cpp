@@ -5,6 +5,10 @@
 #include "../render/camera.h"
 #include "../physics/physics_engine.h"
 #include <spdlog/spdlog.h>
+#include <SDL3/SDL_render.h>
+#include <functional>
+#include <algorithm>
+#include <cmath>
 
 engine::component::TileLayerComponent::TileLayerComponent(const glm::ivec2 &tile_size, const glm::ivec2 &map_size, std::vector<TileInfo> &&tiles)
     : _tile_size(tile_size), _map_size(map_size), _tiles(std::move(tiles))
@@ -16,6 +20,27 @@ engine::component::TileLayerComponent::TileLayerComponent(const glm::ivec2 &tile
         tiles.clear();
         _map_size = {0, 0};
     }
+    // 按最大的瓦片图像估算越出格子的范围(高度不等于格子的瓦片会向下偏移自身高度)
+    if (_tile_size.x > 0 && _tile_size.y > 0)
+    {
+        for (const auto &tile : _tiles)
+        {
+            const auto &source_rect = tile.sprite.getSourceRect();
+            if (tile.type == TileType::EMPTY || !source_rect.has_value())
+            {
+                continue;
+            }
+            _overdraw_cells.x = std::max(_overdraw_cells.x, (source_rect->w + _tile_size.x - 1) / _tile_size.x);
+            _overdraw_cells.y = std::max(_overdraw_cells.y, (2 * source_rect->h + _tile_size.y - 1) / _tile_size.y);
+        }
+    }
+    if (_tile_size.x > 0 && _tile_size.y > 0 && _map_size.x > 0 && _map_size.y > 0)
+    {
+        _chunk_tiles = {std::max(1, CHUNK_PIXELS / _tile_size.x), std::max(1, CHUNK_PIXELS / _tile_size.y)};
+        _chunk_count = {(_map_size.x + _chunk_tiles.x - 1) / _chunk_tiles.x, (_map_size.y + _chunk_tiles.y - 1) / _chunk_tiles.y};
+        _chunk_padding = _overdraw_cells * _tile_size;
+        _chunks.resize(static_cast<size_t>(_chunk_count.x) * _chunk_count.y);
+    }
     spdlog::info("TileLayerComponent created");
 }
 
@@ -42,6 +67,38 @@ engine::component::TileType engine::component::TileLayerComponent::getTileTypeAt
     return info ? info->type : TileType::EMPTY;
 }
 
+bool engine::component::TileLayerComponent::setTileAt(glm::ivec2 pos, TileInfo tile)
+{
+    if (pos.x < 0 || pos.x >= _map_size.x || pos.y < 0 || pos.y >= _map_size.y)
+    {
+        return false;
+    }
+    _tiles[static_cast<size_t>(pos.y) * _map_size.x + pos.x] = std::move(tile);
+    // 瓦片图像可能越出格子,相邻区块也一并重新预渲染
+    const int first_x = std::max(0, (pos.x - _overdraw_cells.x) / _chunk_tiles.x);
+    const int first_y = std::max(0, (pos.y - _overdraw_cells.y) / _chunk_tiles.y);
+    const int last_x = std::min(_chunk_count.x - 1, (pos.x + _overdraw_cells.x) / _chunk_tiles.x);
+    const int last_y = std::min(_chunk_count.y - 1, (pos.y + _overdraw_cells.y) / _chunk_tiles.y);
+    for (int y = first_y; y <= last_y; ++y)
+    {
+        for (int x = first_x; x <= last_x; ++x)
+        {
+            _chunks[static_cast<size_t>(y) * _chunk_count.x + x].dirty = true;
+        }
+    }
+    return true;
+}
+
+void engine::component::TileLayerComponent::releaseChunks()
+{
+    for (auto &chunk : _chunks)
+    {
+        chunk.texture.reset();
+        chunk.dirty = true;
+    }
+    _chunk_memory = 0;
+}
+
 engine::component::TileType engine::component::TileLayerComponent::getTileTypeAtWorldPos(const glm::vec2 &pos) const
 {
     glm::vec2 relative_pos = pos - _offset;
@@ -61,45 +118,264 @@ void engine::component::TileLayerComponent::init()
     spdlog::info("TileLayerComponent initialized");
 }
 
+void engine::component::TileLayerComponent::TextureDeleter::operator()(SDL_Texture *texture) const
+{
+    SDL_DestroyTexture(texture);
+}
+
+void engine::component::TileLayerComponent::prepareRender(engine::core::Context &context)
+{
+    _last_baked_chunks = 0;
+    if (!_chunk_cache_enabled || _chunks.empty())
+    {
+        return;
+    }
+    auto &renderer = context.getRender();
+    // 无头后端不提交绘制,区块纹理只会白白占用内存
+    if (!renderer.isDrawingEnabled())
+    {
+        releaseChunks();
+        _chunk_cache_enabled = false;
+        return;
+    }
+    // 渲染目标或设备重置后目标纹理的内容已丢失
+    if (const uint32_t resets = renderer.getRenderTargetResets(); resets != _render_target_resets)
+    {
+        _render_target_resets = resets;
+        for (auto &chunk : _chunks)
+        {
+            chunk.dirty = true;
+        }
+    }
+
+    ++_render_frame;
+    const auto &camera = context.getCamera();
+    const ChunkRange range = getVisibleChunks(camera);
+    for (int y = range.first.y; y <= range.last.y; ++y)
+    {
+        for (int x = range.first.x; x <= range.last.x; ++x)
+        {
+            auto &chunk = _chunks[static_cast<size_t>(y) * _chunk_count.x + x];
+            if (chunk.dirty || !chunk.texture)
+            {
+                if (!bakeChunk(context, chunk, x, y))
+                {
+                    // 不支持目标纹理时之后都逐瓦片绘制
+                    releaseChunks();
+                    _chunk_cache_enabled = false;
+                    return;
+                }
+                ++_last_baked_chunks;
+            }
+            chunk.last_used_frame = _render_frame;
+        }
+    }
+    evictChunks(camera.getPosition() + camera.getViewportSize() * 0.5f - _offset);
+}
+
 void engine::component::TileLayerComponent::render(engine::core::Context &context)
 {
-    if (_tile_size.x <= 0 || _tile_size.y <= 0)
+    _last_visited_tiles = 0;
+    _last_drawn_tiles = 0;
+    _last_drawn_chunks = 0;
+    if (_tile_size.x <= 0 || _tile_size.y <= 0 || _map_size.x <= 0 || _map_size.y <= 0)
     {
         /* code */
         return;
     }
 
-    int rendered_count = 0;
-    for (int y = 0; y < _map_size.y; ++y)
+    // 只处理与相机视口相交的部分,开销与屏幕面积而不是地图面积成正比
+    const auto &camera = context.getCamera();
+    if (!_chunk_cache_enabled)
+    {
+        const glm::vec2 view_min = camera.getPosition() - _offset;
+        const glm::vec2 view_max = view_min + camera.getViewportSize();
+        renderTiles(context,
+                    static_cast<int>(std::floor(view_min.x / _tile_size.x)) - _overdraw_cells.x,
+                    static_cast<int>(std::floor(view_min.y / _tile_size.y)) - _overdraw_cells.y,
+                    static_cast<int>(std::floor(view_max.x / _tile_size.x)) + 1,
+                    static_cast<int>(std::floor(view_max.y / _tile_size.y)) + 1);
+        return;
+    }
+
+    auto &renderer = context.getRender();
+    const glm::vec2 chunk_size = glm::vec2(_chunk_tiles * _tile_size);
+    const glm::vec2 padding = glm::vec2(_chunk_padding);
+    const glm::vec2 texture_size = chunk_size + 2.0f * padding;
+    const ChunkRange range = getVisibleChunks(camera);
+    for (int y = range.first.y; y <= range.last.y; ++y)
     {
-        for (int x = 0; x < _map_size.x; ++x)
+        for (int x = range.first.x; x <= range.last.x; ++x)
         {
-            size_t index = static_cast<size_t>(y) * _map_size.x + x;
-            // 检测索引有效性以瓦片是否需要渲染
-            if (index < _tiles.size() && _tiles[index].type != TileType::EMPTY)
+            const auto &chunk = _chunks[static_cast<size_t>(y) * _chunk_count.x + x];
+            if (chunk.dirty || !chunk.texture)
+            {
+                // 本帧没有经过prepareRender(如相机在两者之间移动),该区块逐瓦片绘制
+                const glm::ivec2 first_tile = glm::ivec2(x, y) * _chunk_tiles;
+                const glm::ivec2 last_tile = glm::min(first_tile + _chunk_tiles, _map_size) - 1;
+                renderTiles(context, first_tile.x, first_tile.y, last_tile.x, last_tile.y);
+                continue;
+            }
+            const glm::vec2 position = _offset + glm::vec2(x, y) * chunk_size - padding;
+            renderer.drawTexture(camera, chunk.texture.get(), position, texture_size, _render_order);
+            ++_last_drawn_chunks;
+        }
+    }
+}
+
+engine::component::TileLayerComponent::ChunkRange engine::component::TileLayerComponent::getVisibleChunks(const engine::render::Camera &camera) const
+{
+    const glm::vec2 view_min = camera.getPosition() - _offset;
+    const glm::vec2 view_max = view_min + camera.getViewportSize();
+    const glm::vec2 chunk_size = glm::vec2(_chunk_tiles * _tile_size);
+    const glm::vec2 padding = glm::vec2(_chunk_padding);
+    ChunkRange range;
+    range.first = {std::max(0, static_cast<int>(std::floor((view_min.x - padding.x) / chunk_size.x))),
+                   std::max(0, static_cast<int>(std::floor((view_min.y - padding.y) / chunk_size.y)))};
+    range.last = {std::min(_chunk_count.x - 1, static_cast<int>(std::floor((view_max.x + padding.x) / chunk_size.x))),
+                  std::min(_chunk_count.y - 1, static_cast<int>(std::floor((view_max.y + padding.y) / chunk_size.y)))};
+    return range;
+}
+
+void engine::component::TileLayerComponent::renderTiles(engine::core::Context &context, int first_x, int first_y, int last_x, int last_y)
+{
+    first_x = std::max(0, first_x);
+    first_y = std::max(0, first_y);
+    last_x = std::min(_map_size.x - 1, last_x);
+    last_y = std::min(_map_size.y - 1, last_y);
+    if (first_x > last_x || first_y > last_y)
+    {
+        return;
+    }
+
+    auto &renderer = context.getRender();
+    const auto &camera = context.getCamera();
+    for (int y = first_y; y <= last_y; ++y)
+    {
+        const size_t row_start = static_cast<size_t>(y) * _map_size.x;
+        for (int x = first_x; x <= last_x; ++x)
+        {
+            const auto &tile_info = _tiles[row_start + x];
+            if (tile_info.type == TileType::EMPTY)
+            {
+                continue;
+            }
+            // 计算瓦片左上角的世界坐标
+            glm::vec2 tile_left_top_pos = {
+                _offset.x + static_cast<float>(x) * _tile_size.x,
+                _offset.y + static_cast<float>(y) * _tile_size.y};
+            // 如果瓦片高度不等于纹理高度 调整y坐标 瓦片层的对齐点是左下角
+            const auto &source_rect = tile_info.sprite.getSourceRect();
+            if (source_rect.has_value() && static_cast<int>(source_rect->h) != _tile_size.y)
             {
                 /* code */
-                const auto &tile_info = _tiles[index];
-                // 计算瓦片左上角的世界坐标
-                glm::vec2 tile_left_top_pos = {
-                    _offset.x + static_cast<float>(x) * _tile_size.x,
-                    _offset.y + static_cast<float>(y) * _tile_size.y};
-                // 如果瓦片高度不等于纹理高度 调整y坐标 瓦片层的对齐点是左下角
-                const auto &source_rect = tile_info.sprite.getSourceRect();
-                if (source_rect.has_value() && static_cast<int>(source_rect->h) != _tile_size.y)
-                {
-                    /* code */
-                    tile_left_top_pos.y -= (_tile_size.y - source_rect->h) - static_cast<float>(_tile_size.y);
-                }
-                context.getRender().drawSprite(context.getCamera(), tile_info.sprite, tile_left_top_pos);
-                rendered_count++;
+                tile_left_top_pos.y -= (_tile_size.y - source_rect->h) - static_cast<float>(_tile_size.y);
+            }
+            renderer.drawSprite(camera, tile_info.sprite, tile_left_top_pos, {1.0f, 1.0f}, 0.0, _render_order);
+            ++_last_drawn_tiles;
+        }
+    }
+    _last_visited_tiles += static_cast<size_t>(last_x - first_x + 1) * static_cast<size_t>(last_y - first_y + 1);
+}
+
+bool engine::component::TileLayerComponent::bakeChunk(engine::core::Context &context, Chunk &chunk, int chunk_x, int chunk_y)
+{
+    auto &renderer = context.getRender();
+    SDL_Renderer *sdl_renderer = renderer.getSDLRenderer();
+    const glm::ivec2 chunk_size = _chunk_tiles * _tile_size;
+    const glm::ivec2 texture_size = chunk_size + 2 * _chunk_padding;
+    if (!chunk.texture)
+    {
+        chunk.texture.reset(SDL_CreateTexture(sdl_renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, texture_size.x, texture_size.y));
+        if (!chunk.texture)
+        {
+            spdlog::warn("TileLayerComponent chunk texture creation failed, falling back to per-tile rendering: {}", SDL_GetError());
+            return false;
+        }
+        // 瓦片以普通混合绘制到清零的目标上,得到的颜色已乘过alpha,再次绘制时按预乘混合,避免半透明边缘被乘两次
+        SDL_SetTextureBlendMode(chunk.texture.get(), SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+        SDL_SetTextureScaleMode(chunk.texture.get(), SDL_SCALEMODE_NEAREST);
+        _chunk_memory += static_cast<size_t>(texture_size.x) * texture_size.y * 4;
+    }
+
+    // 切换渲染目标前提交已累积的精灵
+    renderer.flush();
+    SDL_Texture *previous_target = SDL_GetRenderTarget(sdl_renderer);
+    if (!SDL_SetRenderTarget(sdl_renderer, chunk.texture.get()))
+    {
+        spdlog::warn("TileLayerComponent set render target failed, falling back to per-tile rendering: {}", SDL_GetError());
+        return false;
+    }
+    Uint8 r, g, b, a;
+    SDL_GetRenderDrawColor(sdl_renderer, &r, &g, &b, &a);
+    SDL_SetRenderDrawColor(sdl_renderer, 0, 0, 0, 0);
+    SDL_RenderClear(sdl_renderer);
+    SDL_SetRenderDrawColor(sdl_renderer, r, g, b, a);
+
+    // 区块内的瓦片按层内坐标绘制,纹理原点是区块左上角再向外扩出余量
+    const glm::ivec2 first_tile = glm::ivec2(chunk_x, chunk_y) * _chunk_tiles;
+    const glm::ivec2 last_tile = glm::min(first_tile + _chunk_tiles, _map_size);
+    const glm::vec2 texture_origin = glm::vec2(first_tile * _tile_size - _chunk_padding);
+    for (int y = first_tile.y; y < last_tile.y; ++y)
+    {
+        for (int x = first_tile.x; x < last_tile.x; ++x)
+        {
+            const auto &tile_info = _tiles[static_cast<size_t>(y) * _map_size.x + x];
+            if (tile_info.type == TileType::EMPTY)
+            {
+                continue;
             }
+            glm::vec2 tile_left_top_pos = {static_cast<float>(x * _tile_size.x), static_cast<float>(y * _tile_size.y)};
+            const auto &source_rect = tile_info.sprite.getSourceRect();
+            if (source_rect.has_value() && static_cast<int>(source_rect->h) != _tile_size.y)
+            {
+                tile_left_top_pos.y -= (_tile_size.y - source_rect->h) - static_cast<float>(_tile_size.y);
+            }
+            renderer.drawUISprite(tile_info.sprite, tile_left_top_pos - texture_origin);
+        }
+    }
+    renderer.flush();
+    SDL_SetRenderTarget(sdl_renderer, previous_target);
+    chunk.dirty = false;
+    return true;
+}
+
+void engine::component::TileLayerComponent::evictChunks(const glm::vec2 &view_center)
+{
+    if (_chunk_memory <= _chunk_budget)
+    {
+        return;
+    }
+    const glm::vec2 chunk_size = glm::vec2(_chunk_tiles * _tile_size);
+    auto &candidates = _evict_candidates;
+    candidates.clear();
+    for (size_t i = 0; i < _chunks.size(); ++i)
+    {
+        if (_chunks[i].texture && _chunks[i].last_used_frame != _render_frame)
+        {
+            const glm::vec2 center = (glm::vec2(static_cast<float>(i % _chunk_count.x), static_cast<float>(i / _chunk_count.x)) + 0.5f) * chunk_size;
+            const glm::vec2 delta = center - view_center;
+            candidates.emplace_back(delta.x * delta.x + delta.y * delta.y, i);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), std::greater<>());
+    const glm::ivec2 texture_size = _chunk_tiles * _tile_size + 2 * _chunk_padding;
+    const size_t chunk_bytes = static_cast<size_t>(texture_size.x) * texture_size.y * 4;
+    for (const auto &[distance, index] : candidates)
+    {
+        if (_chunk_memory <= _chunk_budget)
+        {
+            break;
         }
+        _chunks[index].texture.reset();
+        _chunks[index].dirty = true;
+        _chunk_memory -= chunk_bytes;
     }
 }
 
 void engine::component::TileLayerComponent::clean()
 {
+    releaseChunks();
     if (_physics_engine)
     {
         _physics_engine->unregisterCollisionTileLayer(this);
@@ -1,12 +1,19 @@
 #pragma once
 #include "../render/sprite.h"
+#include "../render/render_queue.h"
 #include "component.h"
+#include <cstdint>
+#include <memory>
+#include <utility>
 #include <vector>
 #include <glm/vec2.hpp>
 
+struct SDL_Texture;
+
 namespace engine::render
 {
     class Sprite;
+    class Camera;
 }
 namespace engine::core
 {
@@ -54,17 +61,68 @@ namespace engine::component
         TileType type;
         TileInfo(render::Sprite sprite = render::Sprite(), TileType type = TileType::EMPTY) : sprite(std::move(sprite)), type(type) {}
     };
+    /// @brief 瓦片层。瓦片按区块预渲染到目标纹理上,每帧只绘制与相机相交的区块
     class TileLayerComponent : public Component
     {
         friend class engine::object::GameObject;
 
+    public:
+        static constexpr std::string_view TYPE_NAME = "TileLayer";
+
+        /// @brief 区块边长(像素),实际取瓦片尺寸的整数倍
+        static constexpr int CHUNK_PIXELS = 256;
+        /// @brief 区块纹理默认的显存预算(字节)
+        static constexpr size_t DEFAULT_CHUNK_BUDGET = 32 * 1024 * 1024;
+
     private:
+        struct TextureDeleter
+        {
+            void operator()(SDL_Texture *texture) const;
+        };
+        /// @brief 预渲染的区块,纹理四周留出瓦片越出格子的余量
+        struct Chunk
+        {
+            std::unique_ptr<SDL_Texture, TextureDeleter> texture;
+            bool dirty{true};
+            uint64_t last_used_frame{0};
+        };
+        struct ChunkRange
+        {
+            glm::ivec2 first;
+            glm::ivec2 last;
+        };
+
         glm::ivec2 _tile_size;
         glm::ivec2 _map_size;
         std::vector<TileInfo> _tiles;
         glm::vec2 _offset{0.0f, 0.0f};
         bool _is_hidden = false;
         engine::physics::PhysicsEngine *_physics_engine = nullptr;
+        /// @brief 瓦片图像可能超出自身格子的最大格数,裁剪可见范围时向外扩展
+        glm::ivec2 _overdraw_cells{1, 1};
+        /// @brief 上一次渲染遍历的格子数和提交绘制的瓦片数
+        size_t _last_visited_tiles = 0;
+        size_t _last_drawn_tiles = 0;
+
+        /// @brief 每个区块包含的瓦片数和区块行列数
+        glm::ivec2 _chunk_tiles{0, 0};
+        glm::ivec2 _chunk_count{0, 0};
+        /// @brief 区块纹理在区块四周多出的像素
+        glm::ivec2 _chunk_padding{0, 0};
+        std::vector<Chunk> _chunks;
+        size_t _chunk_memory = 0;
+        size_t _chunk_budget = DEFAULT_CHUNK_BUDGET;
+        uint64_t _render_frame = 0;
+        /// @brief 创建目标纹理失败或无头后端时退回逐瓦片绘制
+        bool _chunk_cache_enabled = true;
+        /// @brief 上次预渲染时渲染器的目标重置计数,变化时所有区块需要重新预渲染
+        uint32_t _render_target_resets = 0;
+        /// @brief 淘汰区块时复用的(距离平方,区块下标)列表
+        std::vector<std::pair<float, size_t>> _evict_candidates;
+        size_t _last_drawn_chunks = 0;
+        size_t _last_baked_chunks = 0;
+        /// @brief 瓦片和区块在网格中互不重叠,同层内可按纹理分组绘制
+        engine::render::RenderOrder _render_order{.unordered = true};
 
     public:
         TileLayerComponent() = default;
@@ -80,15 +138,44 @@ namespace engine::component
         const std::vector<TileInfo> &getTiles() const { return _tiles; };
         const glm::vec2 &getOffset() const { return _offset; };
         bool isHidden() const { return _is_hidden; };
+        size_t getLastVisitedTiles() const { return _last_visited_tiles; }
+        size_t getLastDrawnTiles() const { return _last_drawn_tiles; }
+        size_t getLastDrawnChunks() const { return _last_drawn_chunks; }
+        size_t getLastBakedChunks() const { return _last_baked_chunks; }
+        size_t getChunkMemory() const { return _chunk_memory; }
+        const engine::render::RenderOrder &getRenderOrder() const { return _render_order; }
+
+        /// @brief 替换瓦片,所在区块在下次绘制时重新预渲染
+        /// @return 坐标越界时返回false
+        bool setTileAt(glm::ivec2 pos, TileInfo tile);
+        /// @brief 设置区块纹理的显存预算,超出时淘汰离相机最远的不可见区块
+        void setChunkBudget(size_t bytes) { _chunk_budget = bytes; }
+        size_t getChunkBudget() const { return _chunk_budget; }
+        /// @brief 释放所有区块纹理,之后按需重新预渲染
+        void releaseChunks();
 
         void setOffset(const glm::vec2 &offset) { _offset = offset; };
         void setHidden(bool is_hidden) { _is_hidden = is_hidden; };
+        void setRenderLayer(uint8_t layer) { _render_order.layer = layer; }
+        void setRenderDepth(int16_t depth) { _render_order.depth = depth; }
         void setPhysicsEngine(engine::physics::PhysicsEngine *physics_engine) { _physics_engine = physics_engine; }
 
     protected:
         void init() override;
         void update(float dt, engine::core::Context &) override {}
+        /// @brief 在绘制队列开启前预渲染可见的脏区块
+        void prepareRender(engine::core::Context &) override;
         void render(engine::core::Context &) override;
         void clean() override;
+
+    private:
+        /// @brief 与相机视口(含余量)相交的区块范围,last为最后一个区块(含)
+        ChunkRange getVisibleChunks(const engine::render::Camera &camera) const;
+        /// @brief 逐个绘制给定范围(层内格子坐标)内的瓦片
+        void renderTiles(engine::core::Context &context, int first_x, int first_y, int last_x, int last_y);
+        /// @brief 把区块内的瓦片绘制到区块纹理上,必要时创建纹理
+        bool bakeChunk(engine::core::Context &context, Chunk &chunk, int chunk_x, int chunk_y);
+        /// @brief 超出预算时按离view_center由远到近淘汰本帧未使用的区块
+        void evictChunks(const glm::vec2 &view_center);
     };
 }
\ No newline at end of file
@@ -3,22 +3,187 @@
 #include <spdlog/spdlog.h>
 #include "../object/game_object.h"
 #include "sprite_component.h"
+#include "../utils/binary_stream.h"
+#include "../scene/scene.h"
+#include <cmath>
 
 void engine::component::TransformComponent::setScale(const glm::vec2 &scale)
 {
+    if (scale == _scale)
+    {
+        return;
+    }
     _scale = scale;
-    if (_owner)
+    onLocalChanged(true);
+    notifyScaleChanged();
+}
+
+bool engine::component::TransformComponent::setParent(TransformComponent *parent, bool keep_world)
+{
+    if (parent == _parent)
+    {
+        return true;
+    }
+    for (auto *ancestor = parent; ancestor; ancestor = ancestor->_parent)
+    {
+        if (ancestor == this)
+        {
+            spdlog::error("TransformComponent::setParent would create a cycle");
+            return false;
+        }
+    }
+
+    const glm::vec2 world_position = getPosition();
+    const glm::vec2 world_scale = getScale();
+    const float world_rotation = getRotation();
+
+    if (_parent)
+    {
+        std::erase(_parent->_children, this);
+    }
+    _parent = parent;
+    if (_parent)
+    {
+        _parent->_children.push_back(this);
+    }
+
+    if (keep_world)
+    {
+        if (_parent)
+        {
+            // 世界变换换算到新父变换的局部空间
+            const glm::vec2 &parent_scale = _parent->getScale();
+            const float parent_rotation = glm::radians(_parent->getRotation());
+            glm::vec2 offset = world_position - _parent->getPosition();
+            const float c = std::cos(-parent_rotation);
+            const float s = std::sin(-parent_rotation);
+            offset = {offset.x * c - offset.y * s, offset.x * s + offset.y * c};
+            _position = {parent_scale.x != 0.0f ? offset.x / parent_scale.x : 0.0f,
+                         parent_scale.y != 0.0f ? offset.y / parent_scale.y : 0.0f};
+            _scale = {parent_scale.x != 0.0f ? world_scale.x / parent_scale.x : world_scale.x,
+                      parent_scale.y != 0.0f ? world_scale.y / parent_scale.y : world_scale.y};
+            _rotation = world_rotation - _parent->getRotation();
+        }
+        else
+        {
+            _position = world_position;
+            _scale = world_scale;
+            _rotation = world_rotation;
+        }
+    }
+
+    updateDepth();
+    _world_dirty = true;
+    onLocalChanged(true);
+    if (!keep_world)
+    {
+        notifyScaleChanged();
+    }
+    notifySceneHierarchyChanged();
+    return true;
+}
+
+void engine::component::TransformComponent::resolveWorldTransform() const
+{
+    if (!_parent || !_world_dirty)
+    {
+        return;
+    }
+    const glm::vec2 &parent_position = _parent->getPosition();
+    const glm::vec2 &parent_scale = _parent->getScale();
+    const float parent_rotation = _parent->getRotation();
+
+    glm::vec2 offset = _position * parent_scale;
+    if (parent_rotation != 0.0f)
+    {
+        const float radians = glm::radians(parent_rotation);
+        const float c = std::cos(radians);
+        const float s = std::sin(radians);
+        offset = {offset.x * c - offset.y * s, offset.x * s + offset.y * c};
+    }
+    _world_position = parent_position + offset;
+    _world_scale = parent_scale * _scale;
+    _world_rotation = parent_rotation + _rotation;
+    _world_dirty = false;
+}
+
+void engine::component::TransformComponent::clean()
+{
+    // 复制一份,setParent会修改_children
+    auto children = _children;
+    for (auto *child : children)
+    {
+        child->setParent(nullptr, true);
+    }
+    if (_parent)
+    {
+        setParent(nullptr, true);
+    }
+}
+
+void engine::component::TransformComponent::markChildrenDirty(bool scale_changed)
+{
+    for (auto *child : _children)
     {
-        auto sprite_comp = _owner->getComponent<engine::component::SpriteComponent>();
-        if (sprite_comp)
+        child->_world_dirty = true;
+        ++child->_version;
+        if (scale_changed)
         {
-            /* code */
-            sprite_comp->updateOffset(); // 更新偏移
+            child->notifyScaleChanged();
         }
-        auto collider_comp = _owner->getComponent<engine::component::ColliderComponent>();
-        if (collider_comp)
+        if (!child->_children.empty())
         {
-            collider_comp->updateOffset();
+            child->markChildrenDirty(scale_changed);
         }
     }
 }
+
+void engine::component::TransformComponent::updateDepth()
+{
+    _depth = _parent ? _parent->_depth + 1 : 0;
+    for (auto *child : _children)
+    {
+        child->updateDepth();
+    }
+}
+
+void engine::component::TransformComponent::notifyScaleChanged()
+{
+    if (!_owner)
+    {
+        return;
+    }
+    auto sprite_comp = _owner->getComponent<engine::component::SpriteComponent>();
+    if (sprite_comp)
+    {
+        sprite_comp->updateOffset(); // 更新偏移
+    }
+    auto collider_comp = _owner->getComponent<engine::component::ColliderComponent>();
+    if (collider_comp)
+    {
+        collider_comp->updateOffset();
+    }
+}
+
+void engine::component::TransformComponent::notifySceneHierarchyChanged()
+{
+    if (_owner && _owner->getScene())
+    {
+        _owner->getScene()->onTransformHierarchyChanged(this);
+    }
+}
+
+void engine::component::TransformComponent::saveState(engine::utils::BinaryWriter &writer) const
+{
+    writer.write(_position);
+    writer.write(_scale);
+    writer.write(_rotation);
+}
+
+void engine::component::TransformComponent::loadState(engine::utils::BinaryReader &reader)
+{
+    // 通过setter恢复,保证版本号递增,派生缓存随之失效
+    setPosition(reader.read<glm::vec2>());
+    setScale(reader.read<glm::vec2>());
+    setRotation(reader.read<float>());
+}
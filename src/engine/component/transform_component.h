@@ -1,19 +1,41 @@
 #pragma once
 #include "component.h"
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <utility>
+#include <vector>
 
 namespace engine::component
 {
     /// @brief 管理GameObject的位置，旋转和缩放
+    /// 可选地挂到父变换下: 此时setter修改的是相对父变换的局部值,getter返回世界值,
+    /// 世界值在读取时才按需计算;没有父变换的对象局部即世界,不产生额外开销
     class TransformComponent : public Component
     {
         friend class engine::object::GameObject;
 
     public:
+        static constexpr std::string_view TYPE_NAME = "Transform";
+
+    private:
         glm::vec2 _position{0.0f, 0.0f};
         glm::vec2 _scale{1.0f, 1.0f};
         float _rotation{0.0f};
+        /// @brief 变换版本号,位置/缩放/旋转实际改变时递增,派生数据据此判断缓存是否过期
+        /// 父变换改变时子变换的版本号同样递增
+        uint32_t _version{1};
+
+        TransformComponent *_parent{nullptr};
+        std::vector<TransformComponent *> _children;
+        /// @brief 层级深度,根为0
+        uint32_t _depth{0};
+        /// @brief 世界变换缓存,只对有父变换的对象有效
+        mutable glm::vec2 _world_position{0.0f, 0.0f};
+        mutable glm::vec2 _world_scale{1.0f, 1.0f};
+        mutable float _world_rotation{0.0f};
+        mutable bool _world_dirty{true};
+
+    public:
         TransformComponent(const glm::vec2 &position = {0.0f, 0.0f}, const glm::vec2 &scale = {1.0f, 1.0f}, float rotation = 0.0f) : _position(position), _scale(scale), _rotation(rotation) {};
 
         TransformComponent(const TransformComponent &) = delete;
@@ -21,17 +43,101 @@ namespace engine::component
         TransformComponent(TransformComponent &&) = delete;
         TransformComponent &operator=(TransformComponent &&) = delete;
 
-        const glm::vec2 &getPosition() const { return _position; };
-        const glm::vec2 &getScale() const { return _scale; };
-        float getRotation() const { return _rotation; };
-        void setPosition(const glm::vec2 &position) { _position = position; };
+        /// @brief 世界坐标
+        const glm::vec2 &getPosition() const
+        {
+            if (!_parent)
+            {
+                return _position;
+            }
+            resolveWorldTransform();
+            return _world_position;
+        };
+        const glm::vec2 &getScale() const
+        {
+            if (!_parent)
+            {
+                return _scale;
+            }
+            resolveWorldTransform();
+            return _world_scale;
+        };
+        float getRotation() const
+        {
+            if (!_parent)
+            {
+                return _rotation;
+            }
+            resolveWorldTransform();
+            return _world_rotation;
+        };
+        const glm::vec2 &getLocalPosition() const { return _position; }
+        const glm::vec2 &getLocalScale() const { return _scale; }
+        float getLocalRotation() const { return _rotation; }
+        uint32_t getVersion() const { return _version; }
+
+        /// @brief 设置局部坐标(无父变换时即世界坐标)
+        void setPosition(const glm::vec2 &position)
+        {
+            if (position != _position)
+            {
+                _position = position;
+                onLocalChanged(false);
+            }
+        };
         void setScale(const glm::vec2 &scale);
-        void setRotation(float rotation) { _rotation = rotation; };
+        void setRotation(float rotation)
+        {
+            if (rotation != _rotation)
+            {
+                _rotation = rotation;
+                onLocalChanged(false);
+            }
+        };
         /// @brief 平移
         /// @param offset
-        void translate(const glm::vec2 &offset) { _position += offset; };
+        void translate(const glm::vec2 &offset)
+        {
+            if (offset.x != 0.0f || offset.y != 0.0f)
+            {
+                _position += offset;
+                onLocalChanged(false);
+            }
+        };
+
+        /// @brief 设置父变换,传nullptr解除
+        /// @param keep_world 为true时换算局部值使世界变换保持不变
+        /// @return 会形成环时返回false
+        bool setParent(TransformComponent *parent, bool keep_world = true);
+        TransformComponent *getParent() const { return _parent; }
+        const std::vector<TransformComponent *> &getChildren() const { return _children; }
+        uint32_t getDepth() const { return _depth; }
+        /// @brief 世界变换过期时按父变换重新计算,父变换先于子变换解析
+        void resolveWorldTransform() const;
 
     private:
         void update(float dt, engine::core::Context &) override {}
+        /// @brief 解除与父变换和子变换的关联,子变换保持世界变换不变
+        void clean() override;
+        void onLocalChanged(bool scale_changed)
+        {
+            ++_version;
+            if (_parent)
+            {
+                _world_dirty = true;
+            }
+            if (!_children.empty())
+            {
+                markChildrenDirty(scale_changed);
+            }
+        }
+        /// @brief 向下递归标记子树的世界变换过期
+        void markChildrenDirty(bool scale_changed);
+        void updateDepth();
+        /// @brief 缩放变化后通知精灵和碰撞盒更新偏移
+        void notifyScaleChanged();
+        void notifySceneHierarchyChanged();
+        void saveState(engine::utils::BinaryWriter &writer) const override;
+        void loadState(engine::utils::BinaryReader &reader) override;
     };
 }
\ No newline at end of file
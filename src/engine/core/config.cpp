@@ -72,6 +72,7 @@ void engine::core::Config::fromJson(const nlohmann::json &j)
     {
         const auto &graphics = j["graphics"];
         _vsync_enabled = graphics.value("vsync", _vsync_enabled);
+        _render_backend = graphics.value("backend", _render_backend);
     }
     if (j.contains("performance"))
     {
@@ -83,6 +84,41 @@ void engine::core::Config::fromJson(const nlohmann::json &j)
             spdlog::warn("Target FPS must be greater than 0");
             _target_fps = 0;
         }
+        _job_threads = perf_config.value("job_threads", _job_threads);
+        if (_job_threads < 0)
+        {
+            spdlog::warn("Job threads must not be negative");
+            _job_threads = 0;
+        }
+        _frame_arena_kb = perf_config.value("frame_arena_kb", _frame_arena_kb);
+        if (_frame_arena_kb <= 0)
+        {
+            spdlog::warn("Frame arena size must be greater than 0");
+            _frame_arena_kb = 256;
+        }
+        _render_stats_csv = perf_config.value("render_stats_csv", _render_stats_csv);
+        _max_frames = perf_config.value("max_frames", _max_frames);
+        if (_max_frames < 0)
+        {
+            spdlog::warn("Max frames must not be negative");
+            _max_frames = 0;
+        }
+    }
+    if (j.contains("debug"))
+    {
+        const auto &debug_config = j["debug"];
+        _rewind_seconds = debug_config.value("rewind_seconds", _rewind_seconds);
+        if (_rewind_seconds < 0.0f)
+        {
+            spdlog::warn("Rewind seconds must not be negative");
+            _rewind_seconds = 0.0f;
+        }
+        _rewind_memory_kb = debug_config.value("rewind_memory_kb", _rewind_memory_kb);
+        if (_rewind_memory_kb <= 0)
+        {
+            spdlog::warn("Rewind memory must be greater than 0");
+            _rewind_memory_kb = 4096;
+        }
     }
     if (j.contains("audio"))
     {
@@ -127,12 +163,24 @@ nlohmann::ordered_json engine::core::Config::toJson() const
             "graphics",
             {
                 {"vsync", _vsync_enabled},
+                {"backend", _render_backend},
             },
         },
         {
             "performance",
             {
                 {"target_fps", _target_fps},
+                {"job_threads", _job_threads},
+                {"frame_arena_kb", _frame_arena_kb},
+                {"max_frames", _max_frames},
+                {"render_stats_csv", _render_stats_csv},
+            },
+        },
+        {
+            "debug",
+            {
+                {"rewind_seconds", _rewind_seconds},
+                {"rewind_memory_kb", _rewind_memory_kb},
             },
         },
         {
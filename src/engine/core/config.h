@@ -16,7 +16,21 @@ namespace engine::core
         bool _window_resizable = true;
 
         bool _vsync_enabled = true;
+        /// @brief 渲染后端: sdl(窗口), offscreen(软件渲染到内存表面), null(不绘制,只统计)
+        std::string _render_backend = "sdl";
         int _target_fps = 60;
+        /// @brief 任务调度器线程总数(含主线程), 0 表示按硬件线程数自动设置
+        int _job_threads = 0;
+        /// @brief 帧分配器容量(KB)
+        int _frame_arena_kb = 256;
+        /// @brief 运行指定帧数后退出, 0 表示不限制(用于无显示环境下的整局性能测试)
+        int _max_frames = 0;
+        /// @brief 逐帧渲染统计的CSV输出路径,为空时不记录
+        std::string _render_stats_csv;
+        /// @brief 时间回溯保留的时长(秒), 0 表示不启用(调试功能,默认关闭)
+        float _rewind_seconds = 0.0f;
+        /// @brief 时间回溯数据的内存上限(KB)
+        int _rewind_memory_kb = 4096;
         float _music_volume = 0.5f;
         float _sound_volume = 0.5f;
 
@@ -29,7 +43,9 @@ namespace engine::core
                 {"move_down", {"S", "Down"}},
                 {"jump", {"J", "Space"}},
                 {"attack", {"K", "MouseLeft"}},
-                {"pause", {"P", "Escape"}}};
+                {"pause", {"P", "Escape"}},
+                {"rewind", {"R"}},
+                {"toggle_render_stats", {"F3"}}};
         explicit Config(const std::string &file_path);
         Config(const Config &) = delete;
         Config &operator=(const Config &) = delete;
@@ -1,7 +1,7 @@
 #include "context.h"
 #include <spdlog/spdlog.h>
-engine::core::Context::Context(engine::input::InputManager &input_manager, engine::render::Renderer &render, engine::resource::ResourceManager &resource_manager, engine::render::Camera &camera, engine::render::TextRenderer &text_renderer, engine::physics::PhysicsEngine &physics_engine, engine::audio::AudioPlayer &audio_player, engine::core::GameState &game_state)
-    : _input_manager(input_manager), _renderer(render), _resource_manager(resource_manager), _camera(camera), _text_renderer(text_renderer), _physics_engine(physics_engine), _audio_player(audio_player), _game_state(game_state)
+engine::core::Context::Context(engine::input::InputManager &input_manager, engine::render::Renderer &render, engine::resource::ResourceManager &resource_manager, engine::render::Camera &camera, engine::render::TextRenderer &text_renderer, engine::physics::PhysicsEngine &physics_engine, engine::audio::AudioPlayer &audio_player, engine::core::GameState &game_state, engine::core::JobSystem &job_system, engine::core::FrameArena &frame_arena, engine::object::PrefabRegistry &prefab_registry, engine::core::EventBus &event_bus, const engine::core::Config &config)
+    : _input_manager(input_manager), _renderer(render), _resource_manager(resource_manager), _camera(camera), _text_renderer(text_renderer), _physics_engine(physics_engine), _audio_player(audio_player), _game_state(game_state), _job_system(job_system), _frame_arena(frame_arena), _prefab_registry(prefab_registry), _event_bus(event_bus), _config(config)
 {
     spdlog::info("Context created");
 }
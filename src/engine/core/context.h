@@ -24,9 +24,18 @@ namespace engine::audio
 {
     class AudioPlayer;
 }
+
+namespace engine::object
+{
+    class PrefabRegistry;
+}
 namespace engine::core
 {
+    class Config;
     class GameState;
+    class JobSystem;
+    class FrameArena;
+    class EventBus;
     /// @brief 持有对核心引擎模块引用的上下文对象
     /// 简化依赖注入，传递Context来获取引擎的各个模块
     class Context final
@@ -45,6 +54,16 @@ namespace engine::core
         engine::audio::AudioPlayer &_audio_player;
         engine::render::TextRenderer &_text_renderer;
         engine::core::GameState &_game_state;
+        /// @brief 任务调度器
+        engine::core::JobSystem &_job_system;
+        /// @brief 每帧重置的临时内存
+        engine::core::FrameArena &_frame_arena;
+        /// @brief 预制体注册表
+        engine::object::PrefabRegistry &_prefab_registry;
+        /// @brief 事件总线
+        engine::core::EventBus &_event_bus;
+        /// @brief 只读配置
+        const engine::core::Config &_config;
 
     public:
         Context(engine::input::InputManager &input_manager,
@@ -54,7 +73,12 @@ namespace engine::core
                 engine::render::TextRenderer &text_renderer,
                 engine::physics::PhysicsEngine &physics_engine,
                 engine::audio::AudioPlayer &audio_player,
-                engine::core::GameState &game_state);
+                engine::core::GameState &game_state,
+                engine::core::JobSystem &job_system,
+                engine::core::FrameArena &frame_arena,
+                engine::object::PrefabRegistry &prefab_registry,
+                engine::core::EventBus &event_bus,
+                const engine::core::Config &config);
         Context(const Context &) = delete;
         Context(Context &&) = delete;
         Context &operator=(const Context &) = delete;
@@ -68,5 +92,10 @@ namespace engine::core
         engine::physics::PhysicsEngine &getPhysicsEngine() const { return _physics_engine; }
         engine::audio::AudioPlayer &getAudioPlayer() const { return _audio_player; }
         engine::core::GameState &getGameState() const { return _game_state; }
+        engine::core::JobSystem &getJobSystem() const { return _job_system; }
+        engine::core::FrameArena &getFrameArena() const { return _frame_arena; }
+        engine::object::PrefabRegistry &getPrefabRegistry() const { return _prefab_registry; }
+        engine::core::EventBus &getEventBus() const { return _event_bus; }
+        const engine::core::Config &getConfig() const { return _config; }
     };
 }
\ No newline at end of file
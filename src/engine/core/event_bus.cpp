@@ -0,0 +1,94 @@
+#include "event_bus.h"
+#include <atomic>
+#include <utility>
+
+engine::core::EventTypeId engine::core::detail::nextEventTypeId()
+{
+    static std::atomic<EventTypeId> next_id{0};
+    return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+engine::core::EventSubscription::EventSubscription(EventSubscription &&other) noexcept
+    : _bus(std::exchange(other._bus, nullptr)), _type(other._type), _id(other._id)
+{
+}
+
+engine::core::EventSubscription &engine::core::EventSubscription::operator=(EventSubscription &&other) noexcept
+{
+    if (this != &other)
+    {
+        reset();
+        _bus = std::exchange(other._bus, nullptr);
+        _type = other._type;
+        _id = other._id;
+    }
+    return *this;
+}
+
+void engine::core::EventSubscription::reset()
+{
+    if (_bus)
+    {
+        _bus->unsubscribe(_type, _id);
+        _bus = nullptr;
+    }
+}
+
+engine::core::EventBus::EventBus(size_t default_capacity)
+    : _default_capacity(default_capacity > 0 ? default_capacity : 1)
+{
+    spdlog::trace("EventBus created, default channel capacity {}", _default_capacity);
+}
+
+engine::core::EventBus::~EventBus() = default;
+
+void engine::core::EventBus::dispatchAll()
+{
+    // 监听者可能触发新通道的创建,按下标遍历
+    for (size_t i = 0; i < _channels.size(); ++i)
+    {
+        if (_channels[i])
+        {
+            _channels[i]->dispatch();
+        }
+    }
+}
+
+void engine::core::EventBus::clear()
+{
+    for (auto &channel : _channels)
+    {
+        if (channel)
+        {
+            channel->clear();
+        }
+    }
+}
+
+void engine::core::EventBus::setRecorder(Recorder recorder, void *user)
+{
+    _recorder = recorder;
+    _recorder_user = user;
+}
+
+std::vector<engine::core::EventBus::ChannelStats> engine::core::EventBus::getStats() const
+{
+    std::vector<ChannelStats> stats;
+    stats.reserve(_channels.size());
+    for (const auto &channel : _channels)
+    {
+        if (channel)
+        {
+            stats.push_back(channel->getStats());
+        }
+    }
+    return stats;
+}
+
+void engine::core::EventBus::unsubscribe(EventTypeId type, uint32_t id)
+{
+    if (type < _channels.size() && _channels[type])
+    {
+        _channels[type]->unsubscribe(id);
+    }
+}
@@ -0,0 +1,303 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+namespace engine::core
+{
+    using EventTypeId = uint32_t;
+
+    namespace detail
+    {
+        EventTypeId nextEventTypeId();
+    }
+
+    /// @brief 每种事件类型在进程内唯一的连续编号,首次使用时分配
+    template <typename Event>
+    EventTypeId eventTypeId()
+    {
+        static const EventTypeId id = detail::nextEventTypeId();
+        return id;
+    }
+
+    class EventBus;
+
+    /// @brief 监听注册的句柄,析构或reset时自动注销
+    class EventSubscription final
+    {
+    private:
+        EventBus *_bus{nullptr};
+        EventTypeId _type{0};
+        uint32_t _id{0};
+
+    public:
+        EventSubscription() = default;
+        EventSubscription(EventBus *bus, EventTypeId type, uint32_t id) : _bus(bus), _type(type), _id(id) {}
+        ~EventSubscription() { reset(); }
+
+        EventSubscription(const EventSubscription &) = delete;
+        EventSubscription &operator=(const EventSubscription &) = delete;
+        EventSubscription(EventSubscription &&other) noexcept;
+        EventSubscription &operator=(EventSubscription &&other) noexcept;
+
+        void reset();
+        bool isActive() const { return _bus != nullptr; }
+    };
+
+    /**
+     * @brief 按事件类型分通道的事件总线
+     *
+     * 每种事件一个环形缓冲,publish只拷贝事件,dispatch时批量调用监听者。
+     * 缓冲写满时扩容为两倍,事件既不会丢弃也不会在分发点之外提前送达;扩容后的容量保留,
+     * 预热之后发布和分发都不分配内存。
+     * GameApp在每帧update之后调用dispatchAll;携带对象指针的事件应由使用方在
+     * 指针仍有效的阶段调用dispatch<Event>()提前分发。
+     * 监听者保存为函数指针+实例指针,注册和分发都不经过std::function。
+     * 只应在主线程使用。
+     */
+    class EventBus final
+    {
+    public:
+        /// @brief 事件记录回调,publish时调用,用于性能分析和回放
+        using Recorder = void (*)(void *user, EventTypeId type, const void *event, size_t size);
+
+        /// @brief 单个通道的统计信息
+        struct ChannelStats
+        {
+            const char *name{nullptr};
+            size_t capacity{0};
+            size_t listeners{0};
+            size_t published{0};
+            size_t dispatched{0};
+            size_t grown{0}; ///< @brief 缓冲已满而扩容的次数
+        };
+
+    private:
+        class ChannelBase
+        {
+        public:
+            virtual ~ChannelBase() = default;
+            virtual void dispatch() = 0;
+            virtual void clear() = 0;
+            virtual void unsubscribe(uint32_t id) = 0;
+            virtual ChannelStats getStats() const = 0;
+        };
+
+        template <typename Event>
+        class Channel final : public ChannelBase
+        {
+        public:
+            using Callback = void (*)(void *, const Event &);
+
+        private:
+            struct Listener
+            {
+                uint32_t id;
+                Callback callback;
+                void *user;
+            };
+
+            std::vector<Event> _ring;
+            size_t _head{0};
+            size_t _count{0};
+            std::vector<Listener> _listeners;
+            bool _dispatching{false};
+            bool _has_removed_listeners{false};
+            ChannelStats _stats;
+
+        public:
+            explicit Channel(size_t capacity) : _ring(capacity)
+            {
+                _stats.name = typeid(Event).name();
+                _stats.capacity = capacity;
+            }
+
+            void push(const Event &event)
+            {
+                if (_count == _ring.size())
+                {
+                    grow();
+                }
+                _ring[(_head + _count) % _ring.size()] = event;
+                ++_count;
+                ++_stats.published;
+            }
+
+            /// @brief 容量翻倍,按发布顺序搬到新缓冲的开头;分发中调用也是安全的(分发按值取出事件)
+            void grow()
+            {
+                std::vector<Event> ring(_ring.size() * 2);
+                for (size_t i = 0; i < _count; ++i)
+                {
+                    ring[i] = _ring[(_head + i) % _ring.size()];
+                }
+                _ring.swap(ring);
+                _head = 0;
+                ++_stats.grown;
+                _stats.capacity = _ring.size();
+                spdlog::info("EventBus channel {} grew to {} events", _stats.name, _ring.size());
+            }
+
+            void dispatch() override
+            {
+                if (_dispatching)
+                {
+                    return;
+                }
+                _dispatching = true;
+                // 只处理分发开始时已有的事件,监听者新发布的事件留到下一次
+                for (size_t remaining = _count; remaining > 0; --remaining)
+                {
+                    const Event event = _ring[_head];
+                    _head = (_head + 1) % _ring.size();
+                    --_count;
+                    // 按下标遍历,监听者中注册新监听者导致扩容也是安全的
+                    for (size_t i = 0; i < _listeners.size(); ++i)
+                    {
+                        if (_listeners[i].callback)
+                        {
+                            _listeners[i].callback(_listeners[i].user, event);
+                        }
+                    }
+                    ++_stats.dispatched;
+                }
+                _dispatching = false;
+                if (_has_removed_listeners)
+                {
+                    std::erase_if(_listeners, [](const Listener &listener)
+                                  { return listener.callback == nullptr; });
+                    _has_removed_listeners = false;
+                }
+            }
+
+            void clear() override
+            {
+                _head = 0;
+                _count = 0;
+            }
+
+            void subscribe(uint32_t id, Callback callback, void *user)
+            {
+                _listeners.push_back({id, callback, user});
+            }
+
+            void unsubscribe(uint32_t id) override
+            {
+                for (auto &listener : _listeners)
+                {
+                    if (listener.id == id)
+                    {
+                        listener.callback = nullptr;
+                        _has_removed_listeners = true;
+                    }
+                }
+                if (!_dispatching && _has_removed_listeners)
+                {
+                    std::erase_if(_listeners, [](const Listener &listener)
+                                  { return listener.callback == nullptr; });
+                    _has_removed_listeners = false;
+                }
+            }
+
+            ChannelStats getStats() const override
+            {
+                auto stats = _stats;
+                stats.listeners = _listeners.size();
+                return stats;
+            }
+        };
+
+        /// @brief 按eventTypeId索引的通道,未使用的类型为空
+        std::vector<std::unique_ptr<ChannelBase>> _channels;
+        size_t _default_capacity;
+        uint32_t _next_listener_id{1};
+        Recorder _recorder{nullptr};
+        void *_recorder_user{nullptr};
+
+    public:
+        /// @param default_capacity 每个通道环形缓冲的默认容量
+        explicit EventBus(size_t default_capacity = 256);
+        ~EventBus();
+
+        EventBus(const EventBus &) = delete;
+        EventBus &operator=(const EventBus &) = delete;
+        EventBus(EventBus &&) = delete;
+        EventBus &operator=(EventBus &&) = delete;
+
+        /// @brief 以指定容量预先创建通道,已存在时不做处理
+        template <typename Event>
+        void reserve(size_t capacity)
+        {
+            channel<Event>(capacity);
+        }
+
+        /// @brief 发布事件,拷贝进缓冲,在下一次分发时送达
+        template <typename Event>
+        void publish(const Event &event)
+        {
+            if (_recorder)
+            {
+                _recorder(_recorder_user, eventTypeId<Event>(), &event, sizeof(Event));
+            }
+            channel<Event>().push(event);
+        }
+
+        /// @brief 以成员函数注册监听者: subscribe<Event, &Owner::onEvent>(this)
+        template <typename Event, auto Method, typename Owner>
+        [[nodiscard]] EventSubscription subscribe(Owner *owner)
+        {
+            return subscribe<Event>([](void *user, const Event &event)
+                                    { (static_cast<Owner *>(user)->*Method)(event); }, owner);
+        }
+
+        /// @brief 以函数指针注册监听者,user原样传回
+        template <typename Event>
+        [[nodiscard]] EventSubscription subscribe(void (*callback)(void *, const Event &), void *user)
+        {
+            auto id = _next_listener_id++;
+            channel<Event>().subscribe(id, callback, user);
+            return EventSubscription(this, eventTypeId<Event>(), id);
+        }
+
+        /// @brief 立即分发某一类型缓冲中的事件
+        template <typename Event>
+        void dispatch()
+        {
+            channel<Event>().dispatch();
+        }
+
+        /// @brief 按类型编号顺序分发所有通道
+        void dispatchAll();
+        /// @brief 丢弃所有未分发的事件(监听者保留)
+        void clear();
+
+        /// @brief 设置事件记录回调,传nullptr关闭
+        void setRecorder(Recorder recorder, void *user);
+        std::vector<ChannelStats> getStats() const;
+
+    private:
+        friend class EventSubscription;
+        void unsubscribe(EventTypeId type, uint32_t id);
+
+        template <typename Event>
+        Channel<Event> &channel(size_t capacity = 0)
+        {
+            static_assert(std::is_trivially_copyable_v<Event>, "Events must be trivially copyable so they can be recorded and replayed");
+            const auto type = eventTypeId<Event>();
+            if (type >= _channels.size())
+            {
+                _channels.resize(type + 1);
+            }
+            auto &slot = _channels[type];
+            if (!slot)
+            {
+                slot = std::make_unique<Channel<Event>>(capacity > 0 ? capacity : _default_capacity);
+            }
+            return static_cast<Channel<Event> &>(*slot);
+        }
+    };
+}
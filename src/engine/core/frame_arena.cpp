@@ -0,0 +1,77 @@
+#include "frame_arena.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstdint>
+
+engine::core::FrameArena::FrameArena(size_t capacity, std::pmr::memory_resource *upstream)
+    : _buffer(std::make_unique<std::byte[]>(capacity)), _capacity(capacity), _upstream(upstream)
+{
+    spdlog::info("FrameArena created with {} bytes", capacity);
+}
+
+engine::core::FrameArena::~FrameArena()
+{
+    releaseOverflow();
+}
+
+void engine::core::FrameArena::reset()
+{
+    if (_overflow_count > 0)
+    {
+        // 溢出说明容量偏小,提示调大performance.frame_arena_kb
+        spdlog::warn("FrameArena overflowed {} times ({} bytes) last frame, capacity {} bytes", _overflow_count, _overflow_bytes, _capacity);
+    }
+    releaseOverflow();
+    _offset = 0;
+}
+
+void *engine::core::FrameArena::do_allocate(size_t bytes, size_t alignment)
+{
+    const auto base = reinterpret_cast<std::uintptr_t>(_buffer.get());
+    const auto aligned = (base + _offset + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+    const size_t new_offset = static_cast<size_t>(aligned - base) + bytes;
+    if (new_offset <= _capacity)
+    {
+        _offset = new_offset;
+        _peak_bytes = std::max(_peak_bytes, getUsedBytes());
+        return reinterpret_cast<void *>(aligned);
+    }
+
+    // 容量不足,向上游申请,头部对齐到alignment以保证返回地址对齐
+    const size_t header_size = std::max(sizeof(OverflowBlock), alignment);
+    const size_t block_alignment = std::max(alignof(OverflowBlock), alignment);
+    auto *raw = static_cast<std::byte *>(_upstream->allocate(header_size + bytes, block_alignment));
+    auto *block = reinterpret_cast<OverflowBlock *>(raw + header_size - sizeof(OverflowBlock));
+    block->next = _overflow_head;
+    block->size = header_size + bytes;
+    block->alignment = block_alignment;
+    _overflow_head = block;
+    _overflow_bytes += bytes;
+    ++_overflow_count;
+    _peak_bytes = std::max(_peak_bytes, getUsedBytes());
+    return raw + header_size;
+}
+
+void engine::core::FrameArena::do_deallocate(void *, size_t, size_t)
+{
+    // 单个释放为空操作,统一在reset()时回收
+}
+
+bool engine::core::FrameArena::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+{
+    return this == &other;
+}
+
+void engine::core::FrameArena::releaseOverflow()
+{
+    while (_overflow_head)
+    {
+        auto *block = _overflow_head;
+        _overflow_head = block->next;
+        const size_t header_size = std::max(sizeof(OverflowBlock), block->alignment);
+        auto *raw = reinterpret_cast<std::byte *>(block) + sizeof(OverflowBlock) - header_size;
+        _upstream->deallocate(raw, block->size, block->alignment);
+    }
+    _overflow_bytes = 0;
+    _overflow_count = 0;
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+namespace engine::core
+{
+    /// @brief 每帧重置的线性(bump)分配器
+    /// 只向前移动指针, deallocate为空操作, reset()时整体回收;
+    /// 容量不足时向上游申请溢出块,同样在reset()时释放
+    /// 分配得到的内存只在当前帧有效,不要跨帧保存
+    class FrameArena final : public std::pmr::memory_resource
+    {
+    private:
+        /// @brief 溢出块头部,以单链表串起来
+        struct OverflowBlock
+        {
+            OverflowBlock *next;
+            size_t size;
+            size_t alignment;
+        };
+
+        std::unique_ptr<std::byte[]> _buffer;
+        size_t _capacity{0};
+        /// @brief 当前偏移
+        size_t _offset{0};
+        /// @brief 历史最大使用量(含溢出)
+        size_t _peak_bytes{0};
+        /// @brief 本帧溢出分配的字节数
+        size_t _overflow_bytes{0};
+        /// @brief 本帧溢出分配的次数
+        size_t _overflow_count{0};
+        OverflowBlock *_overflow_head{nullptr};
+        std::pmr::memory_resource *_upstream{nullptr};
+
+    public:
+        /// @brief 构造函数
+        /// @param capacity 预分配的字节数
+        /// @param upstream 容量不足时使用的上游资源
+        explicit FrameArena(size_t capacity, std::pmr::memory_resource *upstream = std::pmr::new_delete_resource());
+        ~FrameArena() override;
+        FrameArena(const FrameArena &) = delete;
+        FrameArena(FrameArena &&) = delete;
+        FrameArena &operator=(const FrameArena &) = delete;
+        FrameArena &operator=(FrameArena &&) = delete;
+
+        /// @brief 回收本帧所有分配,每帧开始时调用
+        void reset();
+
+        size_t getCapacity() const { return _capacity; }
+        size_t getUsedBytes() const { return _offset + _overflow_bytes; }
+        size_t getPeakBytes() const { return _peak_bytes; }
+        size_t getOverflowCount() const { return _overflow_count; }
+
+    private:
+        void *do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void *p, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+        void releaseOverflow();
+    };
+}
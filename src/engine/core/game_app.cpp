@@ -5,21 +5,43 @@
 #include "time.h"
 #include "context.h"
 #include "game_state.h"
+#include "job_system.h"
+#include "frame_arena.h"
+#include "event_bus.h"
+#include "../utils/alloc_counter.h"
 #include "../resource/resource_manager.h"
 #include "../audio/audio_player.h"
 #include "../render/camera.h"
 #include "../render/text_renderer.h"
 #include "../render/render.h"
+#include "../render/render_stats.h"
+#include "../ui/ui_stats_overlay.h"
 #include "../input/input_manager.h"
 #include "../object/game_object.h"
+#include "../object/prefab.h"
 #include "../component/transform_component.h"
 #include "../component/sprite_component.h"
 #include "../physics/physics_engine.h"
 #include "../component/physics_component.h"
 #include "../scene/scene_manager.h"
+#include "../scene/scene.h"
+#include "../scene/spawn_queue.h"
 #include "../../game/scene/game_scene.h"
 #include "../../game/scene/title_scene.h"
 #include "config.h"
+#include <chrono>
+#include <string_view>
+namespace
+{
+    /// @brief 当前场景生成队列最近一帧的处理情况,没有场景时为空统计
+    const engine::scene::SpawnQueue::Stats &currentSpawnStats(const engine::scene::SceneManager &scene_manager)
+    {
+        static const engine::scene::SpawnQueue::Stats empty;
+        const auto *scene = scene_manager.getCurrentScene();
+        return scene ? scene->getSpawnQueue().getStats() : empty;
+    }
+}
+
 namespace engine::core
 {
     GameApp::GameApp()
@@ -41,8 +63,12 @@ namespace engine::core
             spdlog::error("GameApp init failed,now is shutting down");
             return;
         }
+        const auto start = std::chrono::steady_clock::now();
+        _frame_allocations.start();
         while (_is_running)
         {
+            // 回收上一帧的临时数据
+            _frame_arena->reset();
             _time->update();
             float dt = _time->getDeltaTime();
             _input_manager->update();
@@ -50,6 +76,26 @@ namespace engine::core
             _scene_manager->handleInput();
             update(dt);
             render();
+            _frame_allocations.endFrame();
+            if (_stats_csv)
+            {
+                _stats_csv->write(_frame_count, static_cast<float>(_time->getUnScaledDeltaTime() * 1000.0), _renderer->getLastFrameStats(),
+                                  _frame_allocations.getLastFrameAllocations(), currentSpawnStats(*_scene_manager));
+            }
+            _last_frame_log_stats = engine::utils::Log::endFrame();
+            ++_frame_count;
+            if (_config->_max_frames > 0 && _frame_count >= static_cast<uint64_t>(_config->_max_frames))
+            {
+                _is_running = false;
+            }
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        spdlog::info("GameApp ran {} frames in {:.3f}s ({:.1f} frames/s), backend: {}", _frame_count, seconds,
+                     seconds > 0.0 ? _frame_count / seconds : 0.0, engine::render::toString(_render_backend));
+        if constexpr (engine::utils::ALLOCATION_TRACKING_ENABLED)
+        {
+            spdlog::info("Frames with heap allocations after {} warm-up frames: {} (peak {} per frame)", _frame_allocations.getWarmupFrames(),
+                         _frame_allocations.getAllocatingFrames(), _frame_allocations.getPeakAllocations());
         }
         close();
     }
@@ -59,6 +105,57 @@ namespace engine::core
         _scene_setup_func = std::move(scene_setup_func);
     }
 
+    bool GameApp::parseCommandLine(int argc, char **argv)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string_view arg = argv[i];
+            // 同时支持 "--name value" 和 "--name=value"
+            auto takeValue = [&](std::string_view name) -> std::optional<std::string_view>
+            {
+                if (arg == name && i + 1 < argc)
+                {
+                    return std::string_view(argv[++i]);
+                }
+                if (arg.size() > name.size() && arg.starts_with(name) && arg[name.size()] == '=')
+                {
+                    return arg.substr(name.size() + 1);
+                }
+                return std::nullopt;
+            };
+            if (auto value = takeValue("--render-backend"); value)
+            {
+                if (!engine::render::parseRenderBackend(value.value()))
+                {
+                    spdlog::error("Unknown render backend: {}", value.value());
+                    return false;
+                }
+                _render_backend_override = std::string(value.value());
+            }
+            else if (auto value = takeValue("--max-frames"); value)
+            {
+                try
+                {
+                    _max_frames_override = std::stoi(std::string(value.value()));
+                }
+                catch (const std::exception &e)
+                {
+                    spdlog::error("Invalid --max-frames: {}, {}", value.value(), e.what());
+                    return false;
+                }
+            }
+            else if (auto value = takeValue("--render-stats-csv"); value)
+            {
+                _render_stats_csv_override = std::string(value.value());
+            }
+            else
+            {
+                spdlog::warn("Unknown command line argument: {}", arg);
+            }
+        }
+        return true;
+    }
+
     bool GameApp::initConfig()
     {
         try
@@ -70,12 +167,79 @@ namespace engine::core
             spdlog::error("Config init failed: {},{},{}", e.what(), __FILE__, __LINE__);
             return false;
         }
+        if (_render_backend_override)
+        {
+            _config->_render_backend = _render_backend_override.value();
+        }
+        if (_render_stats_csv_override)
+        {
+            _config->_render_stats_csv = _render_stats_csv_override.value();
+        }
+        if (_max_frames_override)
+        {
+            _config->_max_frames = std::max(_max_frames_override.value(), 0);
+        }
+        if (auto backend = engine::render::parseRenderBackend(_config->_render_backend); backend)
+        {
+            _render_backend = backend.value();
+        }
+        else
+        {
+            spdlog::warn("Unknown render backend '{}', using sdl", _config->_render_backend);
+            _render_backend = engine::render::RenderBackend::SDL;
+        }
         spdlog::info("Config init success");
         return true;
     }
 
+    bool GameApp::initJobSystem()
+    {
+        try
+        {
+            _job_system = std::make_unique<engine::core::JobSystem>(static_cast<unsigned>(_config->_job_threads));
+        }
+        catch (const std::exception &e)
+        {
+            spdlog::error("JobSystem init failed: {},{},{}", e.what(), __FILE__, __LINE__);
+            return false;
+        }
+        return true;
+    }
+
+    bool GameApp::initFrameArena()
+    {
+        try
+        {
+            _frame_arena = std::make_unique<engine::core::FrameArena>(static_cast<size_t>(_config->_frame_arena_kb) * 1024);
+        }
+        catch (const std::exception &e)
+        {
+            spdlog::error("FrameArena init failed: {},{},{}", e.what(), __FILE__, __LINE__);
+            return false;
+        }
+        return true;
+    }
+
+    bool GameApp::initEventBus()
+    {
+        try
+        {
+            _event_bus = std::make_unique<engine::core::EventBus>();
+        }
+        catch (const std::exception &e)
+        {
+            spdlog::error("EventBus init failed: {},{},{}", e.what(), __FILE__, __LINE__);
+            return false;
+        }
+        return true;
+    }
+
     bool GameApp::initSDL()
     {
+        if (_render_backend != engine::render::RenderBackend::SDL)
+        {
+            return initHeadlessSDL();
+        }
         if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO))
         {
             spdlog::error("SDL_Init failed: {}", SDL_GetError());
@@ -103,6 +267,39 @@ namespace engine::core
         return true;
     }
 
+    bool GameApp::initHeadlessSDL()
+    {
+        // 不打开窗口和音频设备,只需要事件队列
+        if (!SDL_Init(SDL_INIT_EVENTS))
+        {
+            spdlog::error("SDL_Init failed: {}", SDL_GetError());
+            return false;
+        }
+        // null后端不绘制,表面只为软件渲染器提供纹理创建能力
+        const bool offscreen = _render_backend == engine::render::RenderBackend::OFFSCREEN;
+        const int width = offscreen ? _config->_window_width : 1;
+        const int height = offscreen ? _config->_window_height : 1;
+        _offscreen_surface = SDL_CreateSurface(width, height, SDL_PIXELFORMAT_RGBA32);
+        if (_offscreen_surface == nullptr)
+        {
+            spdlog::error("SDL_CreateSurface failed: {}", SDL_GetError());
+            return false;
+        }
+        _sdl_renderer = SDL_CreateSoftwareRenderer(_offscreen_surface);
+        if (_sdl_renderer == nullptr)
+        {
+            spdlog::error("SDL_CreateSoftwareRenderer failed: {}", SDL_GetError());
+            return false;
+        }
+        SDL_SetRenderDrawBlendMode(_sdl_renderer, SDL_BLENDMODE_BLEND);
+        if (offscreen)
+        {
+            SDL_SetRenderLogicalPresentation(_sdl_renderer, _config->_window_width / 2, _config->_window_height / 2, SDL_LOGICAL_PRESENTATION_LETTERBOX);
+        }
+        spdlog::info("Headless SDL init, backend: {}", engine::render::toString(_render_backend));
+        return true;
+    }
+
     bool GameApp::initTime()
     {
         try
@@ -122,7 +319,8 @@ namespace engine::core
     {
         try
         {
-            _resource_manager = std::make_unique<engine::resource::ResourceManager>(_sdl_renderer);
+            // 无窗口后端通常跑在没有声卡的机器上,不打开音频设备
+            _resource_manager = std::make_unique<engine::resource::ResourceManager>(_sdl_renderer, _render_backend == engine::render::RenderBackend::SDL);
         }
         catch (const std::exception &e)
         {
@@ -135,7 +333,7 @@ namespace engine::core
     {
         try
         {
-            _audio_player = std::make_unique<engine::audio::AudioPlayer>(_resource_manager.get());
+            _audio_player = std::make_unique<engine::audio::AudioPlayer>(_resource_manager.get(), _render_backend == engine::render::RenderBackend::SDL);
         }
         catch (const std::exception &e)
         {
@@ -150,7 +348,7 @@ namespace engine::core
     {
         try
         {
-            _renderer = std::make_unique<engine::render::Renderer>(_sdl_renderer, _resource_manager.get());
+            _renderer = std::make_unique<engine::render::Renderer>(_sdl_renderer, _resource_manager.get(), _render_backend);
         }
         catch (const std::exception &e)
         {
@@ -165,7 +363,7 @@ namespace engine::core
     {
         try
         {
-            _text_renderer = std::make_unique<engine::render::TextRenderer>(_sdl_renderer, _resource_manager.get());
+            _text_renderer = std::make_unique<engine::render::TextRenderer>(_sdl_renderer, _resource_manager.get(), _renderer.get());
         }
         catch (const std::exception &e)
         {
@@ -194,7 +392,15 @@ namespace engine::core
     {
         try
         {
-            _input_manager = std::make_unique<engine::input::InputManager>(_sdl_renderer, _config.get());
+            if (_window)
+            {
+                _input_manager = std::make_unique<engine::input::InputManager>(_sdl_renderer, _config.get());
+            }
+            else
+            {
+                // 没有窗口就没有鼠标,动作只来自键盘事件或脚本
+                _input_manager = std::make_unique<engine::input::InputManager>(_config.get());
+            }
         }
         catch (const std::exception &e)
         {
@@ -209,6 +415,8 @@ namespace engine::core
         try
         {
             _physics_engine = std::make_unique<engine::physics::PhysicsEngine>();
+            _physics_engine->setFrameResource(_frame_arena.get());
+            _physics_engine->setEventBus(_event_bus.get());
         }
         catch (const std::exception &e)
         {
@@ -222,7 +430,14 @@ namespace engine::core
     {
         try
         {
-            _game_state = std::make_unique<engine::core::GameState>(_window, _sdl_renderer);
+            if (_window)
+            {
+                _game_state = std::make_unique<engine::core::GameState>(_window, _sdl_renderer);
+            }
+            else
+            {
+                _game_state = std::make_unique<engine::core::GameState>(glm::vec2(_config->_window_width / 2, _config->_window_height / 2));
+            }
         }
         catch (const std::exception &e)
         {
@@ -233,12 +448,26 @@ namespace engine::core
         return true;
     }
 
+    bool GameApp::initPrefabRegistry()
+    {
+        try
+        {
+            _prefab_registry = std::make_unique<engine::object::PrefabRegistry>();
+        }
+        catch (const std::exception &e)
+        {
+            spdlog::error("PrefabRegistry init failed: {},{},{}", e.what(), __FILE__, __LINE__);
+            return false;
+        }
+        return true;
+    }
+
     bool GameApp::initContext()
     {
         try
         {
             _context = std::make_unique<engine::core::Context>(*_input_manager, *_renderer, *_resource_manager, *_camera,
-                                                               *_text_renderer, *_physics_engine, *_audio_player, *_game_state);
+                                                               *_text_renderer, *_physics_engine, *_audio_player, *_game_state, *_job_system, *_frame_arena, *_prefab_registry, *_event_bus, *_config);
         }
         catch (const std::exception &e)
         {
@@ -262,6 +491,26 @@ namespace engine::core
         return true;
     }
 
+    bool GameApp::initRenderStats()
+    {
+        try
+        {
+            const glm::vec2 logical_size(_config->_window_width / 2, _config->_window_height / 2);
+            _stats_overlay = std::make_unique<engine::ui::UIStatsOverlay>(*_text_renderer, "assets/fonts/VonwaonBitmap-16px.ttf", 16, logical_size);
+            _stats_overlay->setVisible(false);
+            if (!_config->_render_stats_csv.empty())
+            {
+                _stats_csv = std::make_unique<engine::render::RenderStatsCsvWriter>(_config->_render_stats_csv);
+            }
+        }
+        catch (const std::exception &e)
+        {
+            spdlog::error("RenderStats init failed: {},{},{}", e.what(), __FILE__, __LINE__);
+            return false;
+        }
+        return true;
+    }
+
     bool GameApp::init()
     {
         spdlog::info("GameApp init ...");
@@ -275,6 +524,18 @@ namespace engine::core
         {
             return false;
         }
+        if (!initJobSystem())
+        {
+            return false;
+        }
+        if (!initFrameArena())
+        {
+            return false;
+        }
+        if (!initEventBus())
+        {
+            return false;
+        }
         if (!initSDL())
         {
             return false;
@@ -315,6 +576,10 @@ namespace engine::core
         {
             return false;
         }
+        if (!initPrefabRegistry())
+        {
+            return false;
+        }
         if (!initContext())
         {
             return false;
@@ -324,6 +589,10 @@ namespace engine::core
             /* code */
             return false;
         }
+        if (!initRenderStats())
+        {
+            return false;
+        }
 
         _scene_setup_func(*_scene_manager);
 
@@ -340,23 +609,37 @@ namespace engine::core
             _is_running = false;
             return;
         }
+        if (_input_manager->isActionPressed("toggle_render_stats"))
+        {
+            _stats_overlay->setVisible(!_stats_overlay->isVisible());
+        }
     }
 
     void GameApp::update([[maybe_unused]] float dt)
     {
         _scene_manager->update(dt);
+        // 本帧发布且尚未分发的事件统一送达
+        _event_bus->dispatchAll();
     }
 
     void GameApp::render()
     {
         _renderer->clearScreen();
         _scene_manager->render();
+        if (_stats_overlay->isVisible())
+        {
+            // 显示的是上一帧在present时结算的统计
+            _stats_overlay->setStats(_renderer->getLastFrameStats(), static_cast<float>(_time->getUnScaledDeltaTime()), currentSpawnStats(*_scene_manager));
+            _stats_overlay->render(*_context);
+        }
         _renderer->present();
     }
 
     void GameApp::close()
     {
         spdlog::info("GameApp close ...");
+        _stats_csv.reset();
+        _stats_overlay.reset();
         _scene_manager->close();
         _resource_manager.reset();
         if (_sdl_renderer != nullptr)
@@ -364,6 +647,11 @@ namespace engine::core
             SDL_DestroyRenderer(_sdl_renderer);
             _sdl_renderer = nullptr;
         }
+        if (_offscreen_surface != nullptr)
+        {
+            SDL_DestroySurface(_offscreen_surface);
+            _offscreen_surface = nullptr;
+        }
         if (_window != nullptr)
         {
             SDL_DestroyWindow(_window);
@@ -1,8 +1,15 @@
 #pragma once
 #include <memory>
 #include <functional>
+#include <optional>
+#include <string>
+#include <cstdint>
+#include "../utils/log.h"
+#include "../utils/alloc_counter.h"
+#include "../render/render_backend.h"
 struct SDL_Window;
 struct SDL_Renderer;
+struct SDL_Surface;
 struct MIX_Mixer;
 namespace engine::resource
 {
@@ -13,6 +20,11 @@ namespace engine::render
     class Renderer;
     class Camera;
     class TextRenderer;
+    class RenderStatsCsvWriter;
+}
+namespace engine::ui
+{
+    class UIStatsOverlay;
 }
 namespace engine::input
 {
@@ -31,20 +43,35 @@ namespace engine::audio
 {
     class AudioPlayer;
 }
+namespace engine::object
+{
+    class PrefabRegistry;
+}
 namespace engine::core
 {
     class Time;
     class Config;
     class Context;
     class GameState;
+    class JobSystem;
+    class FrameArena;
+    class EventBus;
     /// @brief 主应用程序,初始化SDL,运行主循环
     class GameApp final
     {
     private:
         SDL_Window *_window{nullptr};
         SDL_Renderer *_sdl_renderer{nullptr};
+        /// @brief 无窗口后端的软件渲染器绘制到该表面
+        SDL_Surface *_offscreen_surface{nullptr};
         MIX_Mixer *_mixer = nullptr;
         bool _is_running{false};
+        engine::render::RenderBackend _render_backend{engine::render::RenderBackend::SDL};
+        /// @brief 命令行参数,优先于配置文件
+        std::optional<std::string> _render_backend_override;
+        std::optional<int> _max_frames_override;
+        std::optional<std::string> _render_stats_csv_override;
+        uint64_t _frame_count{0};
 
         std::function<void(engine::scene::SceneManager &)> _scene_setup_func;
 
@@ -54,12 +81,27 @@ namespace engine::core
         std::unique_ptr<engine::render::Camera> _camera{nullptr};
         std::unique_ptr<engine::render::TextRenderer> _text_renderer{nullptr};
         std::unique_ptr<engine::core::Config> _config{nullptr};
+        /// @brief 在Context和场景之后析构,保证任务线程最后退出
+        std::unique_ptr<engine::core::JobSystem> _job_system{nullptr};
+        /// @brief 每帧开始时重置,须在使用它的模块之后析构
+        std::unique_ptr<engine::core::FrameArena> _frame_arena{nullptr};
+        /// @brief 主线程逐帧堆分配统计(需启用ENGINE_TRACK_ALLOCATIONS),预热后仍分配时警告
+        engine::utils::FrameAllocationMonitor _frame_allocations;
+        /// @brief 上一帧的日志量
+        engine::utils::Log::FrameStats _last_frame_log_stats;
+        /// @brief 场景持有监听句柄,须在场景管理器之后析构
+        std::unique_ptr<engine::core::EventBus> _event_bus{nullptr};
         std::unique_ptr<engine::input::InputManager> _input_manager{nullptr};
         std::unique_ptr<engine::core::Context> _context{nullptr};
         std::unique_ptr<engine::scene::SceneManager> _scene_manager{nullptr};
         std::unique_ptr<engine::physics::PhysicsEngine> _physics_engine{nullptr};
         std::unique_ptr<engine::audio::AudioPlayer> _audio_player{nullptr};
         std::unique_ptr<engine::core::GameState> _game_state{nullptr};
+        std::unique_ptr<engine::object::PrefabRegistry> _prefab_registry{nullptr};
+        /// @brief 渲染统计浮层,按toggle_render_stats切换显示
+        std::unique_ptr<engine::ui::UIStatsOverlay> _stats_overlay{nullptr};
+        /// @brief 配置了CSV路径时逐帧记录渲染统计
+        std::unique_ptr<engine::render::RenderStatsCsvWriter> _stats_csv{nullptr};
 
     public:
         GameApp();
@@ -77,9 +119,23 @@ namespace engine::core
 
         void run();
 
+        size_t getLastFrameHeapAllocations() const { return _frame_allocations.getLastFrameAllocations(); }
+        const engine::utils::Log::FrameStats &getLastFrameLogStats() const { return _last_frame_log_stats; }
+
         void registerSceneSutep(std::function<void(engine::scene::SceneManager &)> scene_setup_func);
+        /// @brief 解析命令行: --render-backend <sdl|offscreen|null>, --max-frames <N>, --render-stats-csv <path>
+        /// @return 参数值无效时返回false
+        [[nodiscard]] bool parseCommandLine(int argc, char **argv);
+        engine::render::RenderBackend getRenderBackend() const { return _render_backend; }
+        /// @brief offscreen后端下最近一帧的画面,其他后端为nullptr
+        SDL_Surface *getOffscreenSurface() const { return _offscreen_surface; }
         [[nodiscard]] bool initConfig();
+        [[nodiscard]] bool initJobSystem();
+        [[nodiscard]] bool initFrameArena();
+        [[nodiscard]] bool initEventBus();
         [[nodiscard]] bool initSDL();
+        /// @brief offscreen和null后端: 不创建窗口,软件渲染器绘制到内存表面
+        [[nodiscard]] bool initHeadlessSDL();
         [[nodiscard]] bool initTime();
         [[nodiscard]] bool initResourceManager();
         [[nodiscard]] bool initAudioPlayer();
@@ -89,8 +145,10 @@ namespace engine::core
         [[nodiscard]] bool initInputManager();
         [[nodiscard]] bool initPhysicsEngine();
         [[nodiscard]] bool initGameState();
+        [[nodiscard]] bool initPrefabRegistry();
         [[nodiscard]] bool initContext();
         [[nodiscard]] bool initSceneManager();
+        [[nodiscard]] bool initRenderStats();
     };
 
 }
\ No newline at end of file
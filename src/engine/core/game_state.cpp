@@ -14,6 +14,11 @@ namespace engine::core
         }
     }
 
+    GameState::GameState(const glm::vec2 &logical_size, State initial_state)
+        : _current_state(initial_state), _headless_size(logical_size)
+    {
+    }
+
     void GameState::setState(State new_state)
     {
         if (_current_state != new_state)
@@ -28,6 +33,10 @@ namespace engine::core
 
     glm::vec2 GameState::getWindowSize() const
     {
+        if (!_window)
+        {
+            return _headless_size;
+        }
         int width, height;
         // SDL3获取窗口大小的方法
         SDL_GetWindowSize(_window, &width, &height);
@@ -36,11 +45,20 @@ namespace engine::core
 
     void GameState::setWindowSize(const glm::vec2 &window_size)
     {
+        if (!_window)
+        {
+            _headless_size = window_size;
+            return;
+        }
         SDL_SetWindowSize(_window, static_cast<int>(window_size.x), static_cast<int>(window_size.y));
     }
 
     glm::vec2 GameState::getLogicalSize() const
     {
+        if (!_renderer)
+        {
+            return _headless_size;
+        }
         int width, height;
         // SDL3获取逻辑分辨率的方法
         SDL_GetRenderLogicalPresentation(_renderer, &width, &height, NULL);
@@ -49,6 +67,11 @@ namespace engine::core
 
     void GameState::setLogicalSize(const glm::vec2 &logical_size)
     {
+        if (!_renderer)
+        {
+            _headless_size = logical_size;
+            return;
+        }
         SDL_SetRenderLogicalPresentation(_renderer,
                                          static_cast<int>(logical_size.x),
                                          static_cast<int>(logical_size.y),
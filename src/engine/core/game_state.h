@@ -32,6 +32,7 @@ namespace engine::core
         SDL_Window *_window = nullptr;       ///< @brief SDL窗口，用于获取窗口大小
         SDL_Renderer *_renderer = nullptr;   ///< @brief SDL渲染器，用于获取逻辑分辨率
         State _current_state = State::Title; ///< @brief 当前游戏状态
+        glm::vec2 _headless_size{0.0f, 0.0f}; ///< @brief 无头模式下的窗口/逻辑尺寸
 
     public:
         /**
@@ -41,6 +42,12 @@ namespace engine::core
          * @param initial_state 游戏的初始状态，默认为 Title
          */
         explicit GameState(SDL_Window *window, SDL_Renderer *renderer, State initial_state = State::Title);
+        /**
+         * @brief 无头模式构造函数,没有窗口和渲染器,尺寸查询返回固定值。
+         * @param logical_size 窗口和逻辑分辨率
+         * @param initial_state 游戏的初始状态
+         */
+        explicit GameState(const glm::vec2 &logical_size, State initial_state = State::Title);
 
         State getCurrentState() const { return _current_state; }
         void setState(State new_state);
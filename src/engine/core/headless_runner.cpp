@@ -0,0 +1,214 @@
+#include "headless_runner.h"
+#include "config.h"
+#include "context.h"
+#include "game_state.h"
+#include "job_system.h"
+#include "frame_arena.h"
+#include "event_bus.h"
+#include "../resource/resource_manager.h"
+#include "../audio/audio_player.h"
+#include "../render/render.h"
+#include "../render/camera.h"
+#include "../render/text_renderer.h"
+#include "../input/input_manager.h"
+#include "../physics/physics_engine.h"
+#include "../object/prefab.h"
+#include "../scene/scene.h"
+#include "../scene/scene_manager.h"
+#include "../utils/alloc_counter.h"
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+    struct SDLSurfaceDeleter
+    {
+        void operator()(SDL_Surface *surface) const { SDL_DestroySurface(surface); }
+    };
+
+    struct SDLRendererDeleter
+    {
+        void operator()(SDL_Renderer *renderer) const { SDL_DestroyRenderer(renderer); }
+    };
+
+    /// @brief 单个无头实例的全部引擎模块,按声明顺序构造、逆序析构
+    struct HeadlessInstance
+    {
+        std::unique_ptr<SDL_Surface, SDLSurfaceDeleter> surface;
+        std::unique_ptr<SDL_Renderer, SDLRendererDeleter> sdl_renderer;
+        std::unique_ptr<engine::core::JobSystem> job_system;
+        std::unique_ptr<engine::core::FrameArena> frame_arena;
+        std::unique_ptr<engine::core::EventBus> event_bus;
+        std::unique_ptr<engine::resource::ResourceManager> resource_manager;
+        std::unique_ptr<engine::render::Renderer> renderer;
+        std::unique_ptr<engine::render::TextRenderer> text_renderer;
+        std::unique_ptr<engine::render::Camera> camera;
+        std::unique_ptr<engine::input::InputManager> input_manager;
+        std::unique_ptr<engine::physics::PhysicsEngine> physics_engine;
+        std::unique_ptr<engine::audio::AudioPlayer> audio_player;
+        std::unique_ptr<engine::core::GameState> game_state;
+        std::unique_ptr<engine::object::PrefabRegistry> prefab_registry;
+        std::unique_ptr<engine::core::Context> context;
+        std::unique_ptr<engine::scene::SceneManager> scene_manager;
+
+        explicit HeadlessInstance(const engine::core::Config &config)
+        {
+            const glm::vec2 logical_size(config._window_width / 2, config._window_height / 2);
+            // 软件渲染器只用于创建纹理和字体引擎,表面尺寸无关紧要
+            surface.reset(SDL_CreateSurface(1, 1, SDL_PIXELFORMAT_RGBA32));
+            if (!surface)
+            {
+                throw std::runtime_error(std::string("SDL_CreateSurface failed: ") + SDL_GetError());
+            }
+            sdl_renderer.reset(SDL_CreateSoftwareRenderer(surface.get()));
+            if (!sdl_renderer)
+            {
+                throw std::runtime_error(std::string("SDL_CreateSoftwareRenderer failed: ") + SDL_GetError());
+            }
+            // 实例之间靠多线程并行,实例内部不再开任务线程
+            job_system = std::make_unique<engine::core::JobSystem>(1);
+            frame_arena = std::make_unique<engine::core::FrameArena>(static_cast<size_t>(config._frame_arena_kb) * 1024);
+            event_bus = std::make_unique<engine::core::EventBus>();
+            resource_manager = std::make_unique<engine::resource::ResourceManager>(sdl_renderer.get(), false);
+            renderer = std::make_unique<engine::render::Renderer>(sdl_renderer.get(), resource_manager.get(), engine::render::RenderBackend::NONE);
+            text_renderer = std::make_unique<engine::render::TextRenderer>(sdl_renderer.get(), resource_manager.get(), renderer.get());
+            camera = std::make_unique<engine::render::Camera>(logical_size);
+            input_manager = std::make_unique<engine::input::InputManager>(&config);
+            physics_engine = std::make_unique<engine::physics::PhysicsEngine>();
+            physics_engine->setFrameResource(frame_arena.get());
+            physics_engine->setEventBus(event_bus.get());
+            audio_player = std::make_unique<engine::audio::AudioPlayer>(resource_manager.get(), false);
+            game_state = std::make_unique<engine::core::GameState>(logical_size);
+            prefab_registry = std::make_unique<engine::object::PrefabRegistry>();
+            context = std::make_unique<engine::core::Context>(*input_manager, *renderer, *resource_manager, *camera,
+                                                              *text_renderer, *physics_engine, *audio_player, *game_state,
+                                                              *job_system, *frame_arena, *prefab_registry, *event_bus, config);
+            scene_manager = std::make_unique<engine::scene::SceneManager>(*context);
+        }
+
+        ~HeadlessInstance()
+        {
+            if (scene_manager)
+            {
+                scene_manager->close();
+            }
+        }
+
+        HeadlessInstance(const HeadlessInstance &) = delete;
+        HeadlessInstance &operator=(const HeadlessInstance &) = delete;
+        HeadlessInstance(HeadlessInstance &&) = delete;
+        HeadlessInstance &operator=(HeadlessInstance &&) = delete;
+    };
+}
+
+engine::core::HeadlessRunner::HeadlessRunner(const Config &config)
+    : _config(config)
+{
+}
+
+std::vector<engine::core::HeadlessResult> engine::core::HeadlessRunner::run(const Settings &settings, const SceneFactory &scene_factory, const InputScript &input_script)
+{
+    std::vector<HeadlessResult> results(settings.instance_count);
+    if (settings.instance_count == 0 || !scene_factory)
+    {
+        spdlog::warn("HeadlessRunner has nothing to run");
+        return results;
+    }
+
+    // TTF由运行器统一初始化,各实例的字体管理器和文字渲染器不会在退出时关闭它
+    if (!TTF_Init())
+    {
+        spdlog::error("HeadlessRunner TTF_Init failed: {}", SDL_GetError());
+        return results;
+    }
+
+    unsigned thread_count = settings.thread_count > 0 ? settings.thread_count : std::thread::hardware_concurrency();
+    thread_count = static_cast<unsigned>(std::clamp<size_t>(thread_count, 1, settings.instance_count));
+    spdlog::info("HeadlessRunner: {} instances on {} threads, {} frames max", settings.instance_count, thread_count, settings.max_frames);
+
+    const auto start = std::chrono::steady_clock::now();
+    std::atomic<size_t> next_instance{0};
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count);
+    for (unsigned i = 0; i < thread_count; ++i)
+    {
+        threads.emplace_back([&]()
+                             {
+            for (size_t instance = next_instance.fetch_add(1); instance < settings.instance_count; instance = next_instance.fetch_add(1))
+            {
+                results[instance] = runInstance(instance, settings, scene_factory, input_script);
+            } });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    TTF_Quit();
+
+    uint64_t total_frames = 0;
+    for (const auto &result : results)
+    {
+        total_frames += result.frames;
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    spdlog::info("HeadlessRunner finished: {} frames in {:.3f}s ({:.0f} frames/s)", total_frames, seconds, seconds > 0.0 ? total_frames / seconds : 0.0);
+    return results;
+}
+
+engine::core::HeadlessResult engine::core::HeadlessRunner::runInstance(size_t instance, const Settings &settings, const SceneFactory &scene_factory, const InputScript &input_script) const
+{
+    HeadlessResult result;
+    result.instance = instance;
+    try
+    {
+        HeadlessInstance headless(_config);
+        auto scene = scene_factory(instance, *headless.context, *headless.scene_manager);
+        if (!scene)
+        {
+            result.error = "scene factory returned null";
+            return result;
+        }
+        headless.scene_manager->requestPushScene(std::move(scene));
+
+        const auto start = std::chrono::steady_clock::now();
+        // 每个实例独占一个线程,按线程统计不受其它实例干扰
+        engine::utils::FrameAllocationMonitor frame_allocations;
+        frame_allocations.start();
+        uint64_t frame = 0;
+        for (; frame < settings.max_frames; ++frame)
+        {
+            headless.frame_arena->reset();
+            headless.input_manager->update();
+            if (input_script && !input_script(HeadlessFrame{instance, frame, *headless.context, *headless.scene_manager}))
+            {
+                break;
+            }
+            headless.scene_manager->handleInput();
+            headless.scene_manager->update(settings.fixed_dt);
+            headless.event_bus->dispatchAll();
+            if (headless.input_manager->getShouldQuit() || !headless.scene_manager->getCurrentScene())
+            {
+                ++frame;
+                break;
+            }
+            frame_allocations.endFrame();
+        }
+        result.frames = frame;
+        result.allocating_frames = frame_allocations.getAllocatingFrames();
+        result.peak_frame_allocations = frame_allocations.getPeakAllocations();
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result.ok = true;
+    }
+    catch (const std::exception &e)
+    {
+        spdlog::error("Headless instance {} failed: {}", instance, e.what());
+        result.error = e.what();
+    }
+    return result;
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace engine::scene
+{
+    class Scene;
+    class SceneManager;
+}
+
+namespace engine::core
+{
+    class Config;
+    class Context;
+
+    /// @brief 脚本在每帧输入阶段收到的信息
+    struct HeadlessFrame
+    {
+        size_t instance;                             ///< @brief 实例编号
+        uint64_t frame;                              ///< @brief 帧序号(从0开始)
+        engine::core::Context &context;              ///< @brief 该实例的上下文,通过InputManager::setActionActive注入输入
+        engine::scene::SceneManager &scene_manager;  ///< @brief 该实例的场景管理器
+    };
+
+    /// @brief 单个实例的运行结果
+    struct HeadlessResult
+    {
+        size_t instance{0};
+        uint64_t frames{0};   ///< @brief 实际模拟的帧数
+        double seconds{0.0};  ///< @brief 模拟耗时(不含实例创建)
+        /// @brief 预热后出现堆分配的帧数(需启用ENGINE_TRACK_ALLOCATIONS)
+        uint64_t allocating_frames{0};
+        /// @brief 预热后单帧堆分配次数的最大值
+        size_t peak_frame_allocations{0};
+        bool ok{false};       ///< @brief 实例是否正常创建并运行
+        std::string error;    ///< @brief 失败原因
+    };
+
+    /**
+     * @brief 无头批量模拟运行器
+     *
+     * 为每个实例单独创建一套Context和SceneManager:渲染器是挂在1x1软件表面上的SDL软件渲染器
+     * (只用于加载纹理和字体,不会绘制),音频关闭,输入只来自脚本,时间步长固定。
+     * 实例分配到与CPU核心数相同的线程上,每个实例从创建到销毁都在同一线程内,互不共享可变状态。
+     */
+    class HeadlessRunner final
+    {
+    public:
+        /// @brief 为实例创建初始场景
+        using SceneFactory = std::function<std::unique_ptr<engine::scene::Scene>(size_t instance, engine::core::Context &, engine::scene::SceneManager &)>;
+        /// @brief 每帧输入阶段调用,返回false时结束该实例
+        using InputScript = std::function<bool(const HeadlessFrame &)>;
+
+        struct Settings
+        {
+            size_t instance_count{1};
+            uint64_t max_frames{3600};
+            float fixed_dt{1.0f / 60.0f};
+            /// @brief 工作线程数, 0 表示按硬件线程数
+            unsigned thread_count{0};
+        };
+
+    private:
+        const Config &_config;
+
+    public:
+        /// @param config 所有实例共享的只读配置(输入映射、窗口尺寸)
+        explicit HeadlessRunner(const Config &config);
+
+        HeadlessRunner(const HeadlessRunner &) = delete;
+        HeadlessRunner &operator=(const HeadlessRunner &) = delete;
+        HeadlessRunner(HeadlessRunner &&) = delete;
+        HeadlessRunner &operator=(HeadlessRunner &&) = delete;
+
+        /// @brief 运行所有实例直到结束,阻塞调用线程
+        /// @return 按实例编号排列的结果
+        std::vector<HeadlessResult> run(const Settings &settings, const SceneFactory &scene_factory, const InputScript &input_script);
+
+    private:
+        HeadlessResult runInstance(size_t instance, const Settings &settings, const SceneFactory &scene_factory, const InputScript &input_script) const;
+    };
+}
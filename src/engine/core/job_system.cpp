@@ -0,0 +1,271 @@
+#include "job_system.h"
+#include <spdlog/spdlog.h>
+
+namespace
+{
+    /// @brief 当前线程所属的JobSystem及队列下标
+    thread_local const engine::core::JobSystem *t_job_system = nullptr;
+    thread_local unsigned t_queue_index = 0;
+}
+
+namespace engine::core
+{
+    JobSystem::JobSystem(unsigned thread_count)
+    {
+        if (thread_count == 0)
+        {
+            thread_count = std::thread::hardware_concurrency();
+        }
+        if (thread_count == 0)
+        {
+            thread_count = 1;
+        }
+
+        _queues.reserve(thread_count);
+        for (unsigned i = 0; i < thread_count; ++i)
+        {
+            _queues.push_back(std::make_unique<WorkerQueue>());
+        }
+
+        // 创建者线程使用队列0,其余线程各自一个队列
+        t_job_system = this;
+        t_queue_index = 0;
+        _threads.reserve(thread_count - 1);
+        for (unsigned i = 1; i < thread_count; ++i)
+        {
+            _threads.emplace_back(&JobSystem::workerLoop, this, i);
+        }
+        spdlog::info("JobSystem created with {} threads", thread_count);
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_wake_mutex);
+            _running.store(false, std::memory_order_release);
+        }
+        _wake_cv.notify_all();
+        for (auto &thread : _threads)
+        {
+            if (thread.joinable())
+            {
+                thread.join();
+            }
+        }
+        if (t_job_system == this)
+        {
+            t_job_system = nullptr;
+        }
+        spdlog::info("JobSystem destroyed");
+    }
+
+    void JobSystem::wait(JobCounter &counter)
+    {
+        const unsigned index = currentQueueIndex();
+        while (!counter.isDone())
+        {
+            if (index != NO_QUEUE)
+            {
+                if (Job *job = tryPopJob(index); job)
+                {
+                    runJob(*job);
+                    continue;
+                }
+                // 有任务在队列中但窃取时发生竞争,重试
+                if (_queued_jobs.load(std::memory_order_acquire) > 0)
+                {
+                    continue;
+                }
+            }
+            const int pending = counter._pending.load(std::memory_order_acquire);
+            if (pending == 0)
+            {
+                break;
+            }
+            counter._pending.wait(pending, std::memory_order_acquire);
+        }
+        // 最后一个完成者在锁内归零并唤醒,拿到锁后调用方可以安全销毁计数器
+        std::lock_guard<std::mutex> lock(counter._mutex);
+    }
+
+    void JobSystem::workerLoop(unsigned index)
+    {
+        t_job_system = this;
+        t_queue_index = index;
+        while (_running.load(std::memory_order_acquire))
+        {
+            if (Job *job = tryPopJob(index); job)
+            {
+                runJob(*job);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(_wake_mutex);
+            // 先登记再检查条件,与push中"先计数再检查登记"配对,不会错过唤醒
+            _sleeping_workers.fetch_add(1, std::memory_order_seq_cst);
+            _wake_cv.wait(lock, [this]()
+                          { return !_running.load(std::memory_order_acquire) || _queued_jobs.load(std::memory_order_seq_cst) > 0; });
+            _sleeping_workers.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    Job *JobSystem::acquireJob()
+    {
+        const unsigned index = currentQueueIndex();
+        if (index == NO_QUEUE)
+        {
+            return nullptr;
+        }
+        auto &queue = *_queues[index];
+        Job &job = queue.pool[queue.next_job % QUEUE_CAPACITY];
+        // 环形复用: 下一个槽位仍未完成说明未完成的任务过多,由调用方直接执行
+        if (job.in_use.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+        ++queue.next_job;
+        job.in_use.store(true, std::memory_order_relaxed);
+        return &job;
+    }
+
+    void JobSystem::push(Job *job)
+    {
+        auto &queue = *_queues[currentQueueIndex()];
+        const int64_t bottom = queue.bottom.load(std::memory_order_relaxed);
+        const int64_t top = queue.top.load(std::memory_order_acquire);
+        if (bottom - top >= static_cast<int64_t>(QUEUE_CAPACITY))
+        {
+            runJob(*job);
+            return;
+        }
+        queue.jobs[static_cast<size_t>(bottom) % QUEUE_CAPACITY].store(job, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        queue.bottom.store(bottom + 1, std::memory_order_relaxed);
+
+        _queued_jobs.fetch_add(1, std::memory_order_seq_cst);
+        if (_sleeping_workers.load(std::memory_order_seq_cst) > 0)
+        {
+            // 经过一次加锁,保证工作线程要么已看到新任务,要么已进入等待
+            {
+                std::lock_guard<std::mutex> lock(_wake_mutex);
+            }
+            _wake_cv.notify_one();
+        }
+    }
+
+    Job *JobSystem::tryPopJob(unsigned index)
+    {
+        if (_queued_jobs.load(std::memory_order_acquire) <= 0)
+        {
+            return nullptr;
+        }
+        // 先从自己的队尾取(最近提交的任务,缓存更热)
+        if (Job *job = popOwn(*_queues[index]); job)
+        {
+            return job;
+        }
+        // 再从其它队列的队首窃取
+        const auto queue_count = static_cast<unsigned>(_queues.size());
+        for (unsigned offset = 1; offset < queue_count; ++offset)
+        {
+            if (Job *job = steal(*_queues[(index + offset) % queue_count]); job)
+            {
+                return job;
+            }
+        }
+        return nullptr;
+    }
+
+    Job *JobSystem::popOwn(WorkerQueue &queue)
+    {
+        const int64_t bottom = queue.bottom.load(std::memory_order_relaxed) - 1;
+        queue.bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = queue.top.load(std::memory_order_relaxed);
+        if (top > bottom)
+        {
+            // 队列为空
+            queue.bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        Job *job = queue.jobs[static_cast<size_t>(bottom) % QUEUE_CAPACITY].load(std::memory_order_relaxed);
+        if (top == bottom)
+        {
+            // 最后一个任务,与窃取者竞争
+            if (!queue.top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                job = nullptr;
+            }
+            queue.bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        if (job)
+        {
+            _queued_jobs.fetch_sub(1, std::memory_order_acq_rel);
+        }
+        return job;
+    }
+
+    Job *JobSystem::steal(WorkerQueue &queue)
+    {
+        int64_t top = queue.top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t bottom = queue.bottom.load(std::memory_order_acquire);
+        if (top >= bottom)
+        {
+            return nullptr;
+        }
+        Job *job = queue.jobs[static_cast<size_t>(top) % QUEUE_CAPACITY].load(std::memory_order_relaxed);
+        if (!queue.top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            return nullptr;
+        }
+        _queued_jobs.fetch_sub(1, std::memory_order_acq_rel);
+        return job;
+    }
+
+    void JobSystem::runJob(Job &job)
+    {
+        try
+        {
+            job.invoke(job.storage);
+        }
+        catch (const std::exception &e)
+        {
+            spdlog::error("JobSystem: job threw exception: {},{},{}", e.what(), __FILE__, __LINE__);
+        }
+        catch (...)
+        {
+            // 非std::exception的异常同样吞掉,否则计数器永不归零,等待方会一直阻塞
+            spdlog::error("JobSystem: job threw unknown exception,{},{}", __FILE__, __LINE__);
+        }
+        auto *counter = job.counter;
+        job.counter = nullptr;
+        job.invoke = nullptr;
+        job.in_use.store(false, std::memory_order_release);
+        if (!counter)
+        {
+            return;
+        }
+        // 归零和唤醒都在锁内进行,归零时取出后续任务
+        Job *continuations = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(counter->_mutex);
+            if (counter->_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                continuations = std::exchange(counter->_continuations, nullptr);
+                counter->_pending.notify_all();
+            }
+        }
+        while (continuations)
+        {
+            Job *next = continuations->next;
+            continuations->next = nullptr;
+            push(continuations);
+            continuations = next;
+        }
+    }
+
+    unsigned JobSystem::currentQueueIndex() const
+    {
+        return t_job_system == this ? t_queue_index : NO_QUEUE;
+    }
+}
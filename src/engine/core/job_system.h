@@ -0,0 +1,244 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace engine::core
+{
+    class JobSystem;
+    class JobCounter;
+
+    /// @brief 任务槽位,可调用对象直接构造在内联存储中,提交任务不分配堆内存
+    struct Job
+    {
+        /// @brief 可调用对象的最大尺寸,更大的捕获应改为捕获指针
+        static constexpr size_t STORAGE_SIZE = 48;
+
+        alignas(std::max_align_t) std::byte storage[STORAGE_SIZE];
+        /// @brief 调用并析构storage中的可调用对象
+        void (*invoke)(void *storage) = nullptr;
+        /// @brief 任务完成时递减的计数器,可为空
+        JobCounter *counter = nullptr;
+        /// @brief 等待同一依赖的后续任务链表
+        Job *next = nullptr;
+        /// @brief 槽位是否被尚未完成的任务占用
+        std::atomic<bool> in_use{false};
+    };
+
+    /// @brief 任务计数器,跟踪一组任务的完成情况,也可作为后续任务的依赖
+    class JobCounter final
+    {
+        friend class JobSystem;
+
+    private:
+        /// @brief 尚未完成的任务数量,归零时唤醒等待者
+        std::atomic<int> _pending{0};
+        /// @brief 保护_continuations以及归零时的唤醒
+        std::mutex _mutex;
+        /// @brief 计数归零后才提交的后续任务
+        Job *_continuations{nullptr};
+
+    public:
+        JobCounter() = default;
+        JobCounter(const JobCounter &) = delete;
+        JobCounter(JobCounter &&) = delete;
+        JobCounter &operator=(const JobCounter &) = delete;
+        JobCounter &operator=(JobCounter &&) = delete;
+
+        bool isDone() const { return _pending.load(std::memory_order_acquire) == 0; }
+        int getPending() const { return _pending.load(std::memory_order_acquire); }
+    };
+
+    /**
+     * @brief 工作窃取任务调度器
+     *
+     * 每个线程(含创建调度器的线程)拥有一个固定容量的无锁双端队列(Chase-Lev):
+     * 自己从队尾压入和取出,空闲线程从其它队列的队首窃取。任务槽位来自提交线程的环形槽位池,
+     * 可调用对象构造在槽位内,提交和执行都不分配内存。
+     * 只有创建者线程和工作线程可以提交任务;其它线程提交,或槽位/队列已满时,任务在调用线程直接执行。
+     * 空闲的工作线程阻塞在条件变量上,有任务入队时才被唤醒。
+     */
+    class JobSystem final
+    {
+    public:
+        /// @brief 每个线程的队列容量和槽位数
+        static constexpr size_t QUEUE_CAPACITY = 1024;
+
+    private:
+        static constexpr unsigned NO_QUEUE = ~0u;
+
+        /// @brief 每个线程一个的任务队列和槽位池
+        struct WorkerQueue
+        {
+            /// @brief 窃取端,其它线程通过CAS前移
+            alignas(64) std::atomic<int64_t> top{0};
+            /// @brief 所有者端,只有所属线程修改
+            alignas(64) std::atomic<int64_t> bottom{0};
+            std::array<std::atomic<Job *>, QUEUE_CAPACITY> jobs{};
+            /// @brief 本线程提交任务使用的槽位,按环形顺序复用
+            std::array<Job, QUEUE_CAPACITY> pool;
+            size_t next_job{0};
+        };
+
+        /// @brief 下标0为创建JobSystem的线程(主线程),其余为工作线程
+        std::vector<std::unique_ptr<WorkerQueue>> _queues;
+        std::vector<std::thread> _threads;
+        std::atomic<bool> _running{true};
+        /// @brief 已入队但未被取走的任务数
+        std::atomic<int> _queued_jobs{0};
+        /// @brief 正在(或即将)阻塞等待的工作线程数,为0时入队不必唤醒
+        std::atomic<int> _sleeping_workers{0};
+        std::mutex _wake_mutex;
+        std::condition_variable _wake_cv;
+
+    public:
+        /// @brief 构造函数
+        /// @param thread_count 参与执行任务的线程总数(含主线程), 0 表示使用std::thread::hardware_concurrency
+        explicit JobSystem(unsigned thread_count = 0);
+        ~JobSystem();
+        JobSystem(const JobSystem &) = delete;
+        JobSystem(JobSystem &&) = delete;
+        JobSystem &operator=(const JobSystem &) = delete;
+        JobSystem &operator=(JobSystem &&) = delete;
+
+        /// @brief 参与执行任务的线程总数(含主线程)
+        unsigned getThreadCount() const { return static_cast<unsigned>(_queues.size()); }
+
+        /// @brief 提交任务
+        /// @param task 可调用对象 void(),尺寸不超过Job::STORAGE_SIZE
+        /// @param counter 任务完成时递减的计数器,可为空
+        template <typename Func>
+        void schedule(Func &&task, JobCounter *counter = nullptr)
+        {
+            Job *job = acquireJob();
+            if (!job)
+            {
+                task();
+                return;
+            }
+            bindJob(*job, std::forward<Func>(task), counter);
+            push(job);
+        }
+
+        /// @brief 提交依赖任务,dependency归零后才会真正入队
+        /// @param dependency 依赖的计数器
+        /// @param task 可调用对象 void(),尺寸不超过Job::STORAGE_SIZE
+        /// @param counter 任务完成时递减的计数器,可为空
+        template <typename Func>
+        void scheduleAfter(JobCounter &dependency, Func &&task, JobCounter *counter = nullptr)
+        {
+            Job *job = acquireJob();
+            if (!job)
+            {
+                wait(dependency);
+                task();
+                return;
+            }
+            // 提前计数,使等待counter的线程也会等待这个尚未入队的任务
+            bindJob(*job, std::forward<Func>(task), counter);
+            {
+                std::lock_guard<std::mutex> lock(dependency._mutex);
+                if (!dependency.isDone())
+                {
+                    job->next = dependency._continuations;
+                    dependency._continuations = job;
+                    return;
+                }
+            }
+            push(job);
+        }
+
+        /// @brief 等待计数器归零: 先帮忙执行队列中的任务,没有可执行的任务时阻塞
+        void wait(JobCounter &counter);
+
+        /// @brief 把[begin, end)切分成若干块并行执行,返回前全部完成
+        /// @param begin 起始下标
+        /// @param end 结束下标(不含)
+        /// @param func 对每个下标调用的函数 void(size_t)
+        /// @param grain_size 每块的最小下标数, 0 表示按线程数自动切分
+        template <typename Func>
+        void parallelFor(size_t begin, size_t end, Func &&func, size_t grain_size = 0)
+        {
+            if (begin >= end)
+            {
+                return;
+            }
+            const size_t count = end - begin;
+            if (grain_size == 0)
+            {
+                // 每个线程约4块,兼顾负载均衡和调度开销
+                grain_size = count / (static_cast<size_t>(getThreadCount()) * 4) + 1;
+            }
+            if (count <= grain_size || getThreadCount() == 1)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    func(i);
+                }
+                return;
+            }
+            JobCounter counter;
+            for (size_t chunk_begin = begin; chunk_begin < end; chunk_begin += grain_size)
+            {
+                const size_t chunk_end = chunk_begin + grain_size < end ? chunk_begin + grain_size : end;
+                schedule([&func, chunk_begin, chunk_end]()
+                         {
+                             for (size_t i = chunk_begin; i < chunk_end; ++i)
+                             {
+                                 func(i);
+                             } },
+                         &counter);
+            }
+            wait(counter);
+        }
+
+    private:
+        template <typename Func>
+        static void bindJob(Job &job, Func &&task, JobCounter *counter)
+        {
+            using Callable = std::decay_t<Func>;
+            static_assert(sizeof(Callable) <= Job::STORAGE_SIZE, "job callable is too large, capture a pointer instead");
+            static_assert(alignof(Callable) <= alignof(std::max_align_t), "job callable is over-aligned");
+            ::new (static_cast<void *>(job.storage)) Callable(std::forward<Func>(task));
+            job.invoke = [](void *storage)
+            {
+                auto *callable = std::launder(static_cast<Callable *>(storage));
+                // 任务抛出异常时也要析构可调用对象
+                struct Destroy
+                {
+                    Callable *callable;
+                    ~Destroy() { callable->~Callable(); }
+                } destroy{callable};
+                (*callable)();
+            };
+            job.counter = counter;
+            job.next = nullptr;
+            if (counter)
+            {
+                counter->_pending.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        void workerLoop(unsigned index);
+        /// @brief 从当前线程的槽位池取一个空闲槽位,非任务线程或槽位都被占用时返回nullptr
+        Job *acquireJob();
+        /// @brief 压入当前线程的队列并唤醒空闲线程,队列已满时直接执行
+        void push(Job *job);
+        /// @brief 取出一个任务: 先取自己队尾,再从其它队列队首窃取
+        Job *tryPopJob(unsigned index);
+        Job *popOwn(WorkerQueue &queue);
+        Job *steal(WorkerQueue &queue);
+        void runJob(Job &job);
+        /// @brief 当前线程对应的队列下标,非任务线程返回NO_QUEUE
+        unsigned currentQueueIndex() const;
+    };
+}
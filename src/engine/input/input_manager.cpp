@@ -17,6 +17,12 @@ engine::input::InputManager::InputManager(SDL_Renderer *sdl_renderer, const engi
     _mouse_position = glm::vec2(x, y);
 }
 
+engine::input::InputManager::InputManager(const engine::core::Config *config)
+    : _headless(true)
+{
+    initMappings(config);
+}
+
 void engine::input::InputManager::update()
 {
     for (auto &[action_name, state] : _action_states)
@@ -30,6 +36,10 @@ void engine::input::InputManager::update()
             state = ActionState::INACTIVE;
         }
     }
+    if (_headless)
+    {
+        return;
+    }
     SDL_Event event;
     while (SDL_PollEvent(&event))
     {
@@ -65,8 +75,26 @@ bool engine::input::InputManager::isActionReleased(const std::string &action_nam
     return false;
 }
 
+void engine::input::InputManager::setActionActive(const std::string &action_name, bool active)
+{
+    auto it = _action_states.find(action_name);
+    if (it == _action_states.end())
+    {
+        return;
+    }
+    const bool is_down = it->second == ActionState::PRESSED || it->second == ActionState::HELD;
+    if (is_down != active)
+    {
+        updateActionStates(action_name, active, false);
+    }
+}
+
 glm::vec2 engine::input::InputManager::getLogicalMousePosition() const
 {
+    if (!_sdl_renderer)
+    {
+        return _mouse_position;
+    }
     glm::vec2 logical_position;
     SDL_RenderCoordinatesFromWindow(_sdl_renderer, _mouse_position.x, _mouse_position.y, &logical_position.x, &logical_position.y);
     return logical_position;
@@ -143,6 +171,10 @@ void engine::input::InputManager::initMappings(const engine::core::Config *confi
     {
         _action2keyname_map["MouseRightClick"] = {"MouseRight"};
     }
+    if (_action2keyname_map.find("toggle_render_stats") == _action2keyname_map.end())
+    {
+        _action2keyname_map["toggle_render_stats"] = {"F3"};
+    }
 
     for (const auto &[action_name, key_names] : _action2keyname_map)
     {
@@ -30,11 +30,15 @@ namespace engine::input
         std::unordered_map<std::variant<Uint32, SDL_Scancode>, std::vector<std::string>> _input2action_map;
         std::unordered_map<std::string, ActionState> _action_states{};
 
+        /// @brief 无头模式下不读取SDL事件,动作状态只由setActionActive驱动
+        bool _headless{false};
         bool _should_quit{false};
         glm::vec2 _mouse_position{0.0f, 0.0f};
 
     public:
         InputManager(SDL_Renderer *sdl_renderer, const engine::core::Config *config);
+        /// @brief 无头模式构造,不依赖窗口和渲染器
+        explicit InputManager(const engine::core::Config *config);
 
         void update();
 
@@ -53,6 +57,9 @@ namespace engine::input
         /// @return
         bool isActionReleased(const std::string &action_name) const;
 
+        /// @brief 直接设置动作是否处于激活状态(脚本输入/机器人),状态转换规则与真实按键一致
+        void setActionActive(const std::string &action_name, bool active);
+
         bool getShouldQuit() const { return _should_quit; }
         void setShouldQuit(bool quit) { _should_quit = quit; }
 
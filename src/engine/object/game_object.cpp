@@ -1,13 +1,38 @@
 #include "game_object.h"
 #include <spdlog/spdlog.h>
+#include <algorithm>
+#include "../utils/log.h"
 #include "../render/render.h"
 #include "../input/input_manager.h"
 #include "../render/camera.h"
+#include "../scene/scene.h"
 
 engine::object::GameObject::GameObject(const std::string &name, const std::string &tag)
-    : _name(name), _target(tag)
+    : _name(name), _target(tag), _name_id(engine::utils::intern(name)), _target_id(engine::utils::intern(tag))
 {
-    spdlog::info("GameObject {} created", name);
+    ENGINE_LOG_TRACE("GameObject {} created", name);
+}
+
+void engine::object::GameObject::setName(const std::string &name)
+{
+    auto old_id = _name_id;
+    _name = name;
+    _name_id = engine::utils::intern(name);
+    if (_scene && old_id != _name_id)
+    {
+        _scene->onGameObjectRenamed(this, old_id);
+    }
+}
+
+void engine::object::GameObject::setTarget(const std::string &target)
+{
+    auto old_id = _target_id;
+    _target = target;
+    _target_id = engine::utils::intern(target);
+    if (_scene && old_id != _target_id)
+    {
+        _scene->onGameObjectRetagged(this, old_id);
+    }
 }
 
 void engine::object::GameObject::update(float dt, engine::core::Context &context)
@@ -19,6 +44,14 @@ void engine::object::GameObject::update(float dt, engine::core::Context &context
     }
 }
 
+void engine::object::GameObject::prepareRender(engine::core::Context &context)
+{
+    for (auto &pair : _components)
+    {
+        pair.second->prepareRender(context);
+    }
+}
+
 void engine::object::GameObject::render(engine::core::Context &context)
 {
     for (auto &pair : _components)
@@ -46,3 +79,54 @@ void engine::object::GameObject::handleInput(engine::core::Context &context)
         pair.second->handleInput(context);
     }
 }
+
+void engine::object::GameObject::saveState(engine::utils::BinaryWriter &writer) const
+{
+    writer.write(_need_remove);
+    writer.write(static_cast<uint32_t>(_components.size()));
+    for (const auto &pair : _components)
+    {
+        writer.write(pair.second->getTypeId());
+        pair.second->saveState(writer);
+    }
+}
+
+bool engine::object::GameObject::loadState(engine::utils::BinaryReader &reader)
+{
+    _need_remove = reader.read<bool>();
+    if (reader.read<uint32_t>() != _components.size())
+    {
+        spdlog::error("GameObject {} component count changed since snapshot", _name);
+        return false;
+    }
+    for (size_t i = 0; i < _components.size(); ++i)
+    {
+        // 组件很少,按ID线性查找
+        const auto type_id = reader.read<uint32_t>();
+        auto it = std::find_if(_components.begin(), _components.end(), [type_id](const auto &pair)
+                               { return pair.second->getTypeId() == type_id; });
+        if (reader.failed() || it == _components.end())
+        {
+            spdlog::error("GameObject {} components changed since snapshot", _name);
+            return false;
+        }
+        it->second->loadState(reader);
+    }
+    return !reader.failed();
+}
+
+void engine::object::GameObject::deactivate()
+{
+    for (auto &pair : _components)
+    {
+        pair.second->deactivate();
+    }
+}
+
+void engine::object::GameObject::reactivate()
+{
+    for (auto &pair : _components)
+    {
+        pair.second->reactivate();
+    }
+}
@@ -1,14 +1,20 @@
 #pragma once
 #include "../component/component.h"
+#include "../utils/symbol_table.h"
+#include "../utils/binary_stream.h"
 #include <unordered_map>
 #include <typeindex>
 #include <utility>
-#include <spdlog/spdlog.h>
+#include "../utils/log.h"
 
 namespace engine::core
 {
     class Context;
 }
+namespace engine::scene
+{
+    class Scene;
+}
 namespace engine::object
 {
     class GameObject
@@ -16,6 +22,11 @@ namespace engine::object
     private:
         std::string _name;
         std::string _target;
+        /// @brief 名称和标签的驻留ID,用于场景索引和快速比较
+        engine::utils::SymbolId _name_id{engine::utils::INVALID_SYMBOL};
+        engine::utils::SymbolId _target_id{engine::utils::INVALID_SYMBOL};
+        /// @brief 所属场景(非拥有),改名/改标签时通知场景更新索引
+        engine::scene::Scene *_scene{nullptr};
         std::unordered_map<std::type_index, std::unique_ptr<engine::component::Component>> _components;
         /// @brief 延迟删除的标记
         bool _need_remove{false};
@@ -27,10 +38,14 @@ namespace engine::object
         GameObject(GameObject &&) = delete;
         GameObject &operator=(GameObject &&) = delete;
 
-        void setName(const std::string &name) { _name = name; }
+        void setName(const std::string &name);
         const std::string &getName() const { return _name; }
-        void setTarget(const std::string &target) { _target = target; }
+        engine::utils::SymbolId getNameId() const { return _name_id; }
+        void setTarget(const std::string &target);
         const std::string &getTarget() const { return _target; }
+        engine::utils::SymbolId getTargetId() const { return _target_id; }
+        void setScene(engine::scene::Scene *scene) { _scene = scene; }
+        engine::scene::Scene *getScene() const { return _scene; }
         void setNeedRemove(bool need_remove) { _need_remove = need_remove; }
         bool getNeedRemove() const { return _need_remove; }
 
@@ -48,9 +63,10 @@ namespace engine::object
             auto new_component = std::make_unique<T>(std::forward<Args>(args)...);
             T *ptr = new_component.get();
             new_component->setOwner(this);
+            new_component->_type_id = engine::component::makeComponentTypeId(T::TYPE_NAME);
             _components[type_index] = std::move(new_component);
             ptr->init();
-            spdlog::info("Component {} added to GameObject {}", typeid(T).name(), _name);
+            ENGINE_LOG_TRACE("Component {} added to GameObject {}", typeid(T).name(), _name);
             return ptr;
         }
 
@@ -88,9 +104,20 @@ namespace engine::object
         }
 
         void update(float dt, engine::core::Context &);
+        /// @brief 在场景开启绘制队列之前调用各组件的prepareRender
+        void prepareRender(engine::core::Context &);
         void render(engine::core::Context &);
         void clean();
         void handleInput(engine::core::Context &);
+
+        /// @brief 写入删除标记和所有组件的状态,每个组件以TYPE_NAME派生的稳定ID标识
+        void saveState(engine::utils::BinaryWriter &writer) const;
+        /// @brief 按组件ID恢复saveState写入的状态,与组件表的遍历顺序无关;组件集合与快照时不一致返回false
+        bool loadState(engine::utils::BinaryReader &reader);
+        /// @brief 移出场景但保留对象时调用(见Scene快照)
+        void deactivate();
+        /// @brief 保留的对象重新回到场景时调用
+        void reactivate();
     };
 
 }
\ No newline at end of file
@@ -0,0 +1,102 @@
+#include "prefab.h"
+#include "game_object.h"
+#include "../core/context.h"
+#include "../component/transform_component.h"
+#include "../component/sprite_component.h"
+#include "../component/collider_component.h"
+#include "../component/physics_component.h"
+#include "../component/animation_component.h"
+#include "../component/audio_component.h"
+#include "../component/health_component.h"
+#include "../physics/collider.h"
+#include <spdlog/spdlog.h>
+
+const engine::object::Prefab *engine::object::PrefabRegistry::registerPrefab(std::string_view key, Prefab &&prefab)
+{
+    auto [it, inserted] = _prefabs.try_emplace(engine::utils::intern(key), nullptr);
+    if (!inserted)
+    {
+        spdlog::warn("Prefab already registered: {}", key);
+        return it->second.get();
+    }
+    it->second = std::make_unique<const Prefab>(std::move(prefab));
+    return it->second.get();
+}
+
+const engine::object::Prefab *engine::object::PrefabRegistry::find(std::string_view key) const
+{
+    return find(engine::utils::SymbolTable::getInstance().find(key));
+}
+
+const engine::object::Prefab *engine::object::PrefabRegistry::find(engine::utils::SymbolId key) const
+{
+    if (auto it = _prefabs.find(key); it != _prefabs.end())
+    {
+        return it->second.get();
+    }
+    return nullptr;
+}
+
+std::unique_ptr<engine::object::GameObject> engine::object::PrefabRegistry::instantiate(const Prefab &prefab,
+                                                                                        engine::core::Context &context,
+                                                                                        const glm::vec2 &position,
+                                                                                        const glm::vec2 &scale,
+                                                                                        float rotation,
+                                                                                        const std::string &name)
+{
+    auto game_object = std::make_unique<GameObject>(name.empty() ? prefab.name : name, prefab.tag);
+    game_object->addComponent<engine::component::TransformComponent>(position, scale, rotation);
+
+    if (prefab.sprite)
+    {
+        auto sprite = prefab.sprite.value();
+        game_object->addComponent<engine::component::SpriteComponent>(std::move(sprite), context.getResourceManager(), prefab.sprite_alignment);
+    }
+
+    if (prefab.collider)
+    {
+        auto collider = std::make_unique<engine::physics::AABBCollider>(prefab.collider->size);
+        auto *cc = game_object->addComponent<engine::component::ColliderComponent>(std::move(collider));
+        cc->setOffset(prefab.collider->offset);
+        cc->setTrigger(prefab.collider->is_trigger);
+    }
+
+    if (prefab.has_physics)
+    {
+        game_object->addComponent<engine::component::PhysicsComponent>(&context.getPhysicsEngine(), prefab.use_gravity);
+    }
+
+    if (!prefab.animations.empty())
+    {
+        auto *ac = game_object->addComponent<engine::component::AnimationComponent>();
+        for (const auto &anim : prefab.animations)
+        {
+            auto animation = std::make_unique<engine::render::Animation>(anim.name, anim.loop);
+            for (const auto &frame : anim.frames)
+            {
+                animation->addFrame(frame.source_rect, frame.duration);
+            }
+            ac->addAnimation(std::move(animation));
+        }
+        ac->setOneShotRemoval(prefab.one_shot_removal);
+        if (!prefab.autoplay_animation.empty())
+        {
+            ac->playAnimation(prefab.autoplay_animation);
+        }
+    }
+
+    if (!prefab.sounds.empty())
+    {
+        auto *ac = game_object->addComponent<engine::component::AudioComponent>(&context.getAudioPlayer(), &context.getCamera());
+        for (const auto &[sound_id, sound_path] : prefab.sounds)
+        {
+            ac->addSound(sound_id, sound_path);
+        }
+    }
+
+    if (prefab.health)
+    {
+        game_object->addComponent<engine::component::HealthComponent>(prefab.health.value());
+    }
+    return game_object;
+}
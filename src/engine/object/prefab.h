@@ -0,0 +1,104 @@
+#pragma once
+#include "../render/sprite.h"
+#include "../render/animation.h"
+#include "../utils/alignment.h"
+#include "../utils/symbol_table.h"
+#include <glm/vec2.hpp>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace engine::core
+{
+    class Context;
+}
+
+namespace engine::object
+{
+    class GameObject;
+
+    /// @brief 预制体中的动画定义
+    struct PrefabAnimation
+    {
+        std::string name;
+        bool loop = true;
+        std::vector<engine::render::AnimationFrame> frames;
+    };
+
+    /// @brief 预制体中的碰撞盒定义
+    struct PrefabCollider
+    {
+        glm::vec2 size{0.0f};
+        glm::vec2 offset{0.0f};
+        bool is_trigger = false;
+    };
+
+    /// @brief 预制体: 解析一次后不再修改的GameObject蓝图
+    /// 组件按 Transform, Sprite, Collider, Physics, Animation, Audio, Health 的顺序创建
+    struct Prefab
+    {
+        std::string name;
+        std::string tag;
+        std::optional<engine::render::Sprite> sprite;
+        engine::utils::Alignment sprite_alignment = engine::utils::Alignment::NONE;
+        std::optional<PrefabCollider> collider;
+        bool has_physics = false;
+        bool use_gravity = false;
+        std::vector<PrefabAnimation> animations;
+        /// @brief 实例化后立即播放的动画,为空表示不主动播放
+        std::string autoplay_animation;
+        /// @brief 动画播放完后移除对象
+        bool one_shot_removal = false;
+        /// @brief 音效ID到路径
+        std::vector<std::pair<std::string, std::string>> sounds;
+        std::optional<int> health;
+    };
+
+    /// @brief 预制体注册表,按驻留后的键名保存预制体
+    /// 由GameApp持有,跨场景和关卡重载保留,同一个瓦片或代码模板只解析一次
+    class PrefabRegistry final
+    {
+    private:
+        /// @brief unique_ptr保证预制体地址稳定,可安全缓存返回的指针
+        std::unordered_map<engine::utils::SymbolId, std::unique_ptr<const Prefab>> _prefabs;
+
+    public:
+        PrefabRegistry() = default;
+        PrefabRegistry(const PrefabRegistry &) = delete;
+        PrefabRegistry(PrefabRegistry &&) = delete;
+        PrefabRegistry &operator=(const PrefabRegistry &) = delete;
+        PrefabRegistry &operator=(PrefabRegistry &&) = delete;
+
+        /// @brief 注册预制体,键已存在时保留旧的并返回旧的
+        /// @param key 键名
+        /// @param prefab 预制体
+        /// @return 注册表中的预制体
+        const Prefab *registerPrefab(std::string_view key, Prefab &&prefab);
+
+        /// @brief 查找预制体,不存在返回nullptr
+        const Prefab *find(std::string_view key) const;
+        const Prefab *find(engine::utils::SymbolId key) const;
+
+        size_t size() const { return _prefabs.size(); }
+        void clear() { _prefabs.clear(); }
+
+        /// @brief 按预制体创建GameObject
+        /// @param prefab 预制体
+        /// @param context 上下文,提供组件需要的引擎模块
+        /// @param position 位置
+        /// @param scale 缩放
+        /// @param rotation 旋转
+        /// @param name 对象名称,为空时使用预制体名称
+        /// @return 新对象,尚未加入场景
+        static std::unique_ptr<GameObject> instantiate(const Prefab &prefab,
+                                                       engine::core::Context &context,
+                                                       const glm::vec2 &position,
+                                                       const glm::vec2 &scale = glm::vec2(1.0f),
+                                                       float rotation = 0.0f,
+                                                       const std::string &name = "");
+    };
+}
@@ -5,13 +5,14 @@ bool engine::physics::collision::checkCollision(engine::component::ColliderCompo
 {
     auto a_collider = a.getCollider();
     auto b_collider = b.getCollider();
-    auto a_transform = a.getTransform();
-    auto b_transform = b.getTransform();
 
-    auto a_size = a_collider->getAABBSize() * a_transform->getScale();
-    auto b_size = b_collider->getAABBSize() * b_transform->getScale();
-    auto a_pos = a_transform->getPosition() + a.getOffset();
-    auto b_pos = b_transform->getPosition() + b.getOffset();
+    // 使用缓存的世界AABB,变换未改变时无需重新计算
+    const auto &a_aabb = a.getWorldAABB();
+    const auto &b_aabb = b.getWorldAABB();
+    auto a_size = a_aabb.size;
+    auto b_size = b_aabb.size;
+    auto a_pos = a_aabb.position;
+    auto b_pos = b_aabb.position;
     if (!checkAABBOverlap(a_pos, a_size, b_pos, b_size))
     {
         return false;
@@ -1,13 +1,20 @@
 #include "physics_engine.h"
 #include "collision.h"
-#include <set>
+#include "physics_events.h"
 #include "../component/physics_component.h"
 #include "../component/transform_component.h"
 #include "../component/collider_component.h"
 #include "../component/tilelayer_component.h"
 #include "../object/game_object.h"
+#include "../core/event_bus.h"
 #include <spdlog/spdlog.h>
 #include <glm/vec2.hpp>
+
+namespace
+{
+    const engine::utils::SymbolId SOLID_TAG = engine::utils::intern("solid");
+}
+
 void engine::physics::PhysicsEngine::registerComponent(engine::component::PhysicsComponent *component)
 {
     _physics_components.push_back(component);
@@ -31,11 +38,13 @@ void engine::physics::PhysicsEngine::unregisterCollisionTileLayer(engine::compon
     _collision_tile_layers.erase(it, _collision_tile_layers.end());
 }
 
+void engine::physics::PhysicsEngine::setFrameResource(std::pmr::memory_resource *resource)
+{
+    _frame_resource = resource ? resource : std::pmr::get_default_resource();
+}
+
 void engine::physics::PhysicsEngine::update(float dt)
 {
-    // 清空碰撞对
-    _collision_pairs.clear();
-    _tile_tigger_events.clear();
     // 更新所有物理组件
     for (auto *pc : _physics_components)
     {
@@ -67,66 +76,62 @@ void engine::physics::PhysicsEngine::update(float dt)
 
 void engine::physics::PhysicsEngine::checkObjectCollision()
 {
-    for (size_t i = 0; i < _physics_components.size(); i++)
+    // 收集参与检测的碰撞盒到连续数组(分配在帧内存上)
+    std::pmr::vector<CollisionEntry> entries(_frame_resource);
+    entries.reserve(_physics_components.size());
+    for (auto *pc : _physics_components)
     {
-        auto *pc_a = _physics_components[i];
-        if (!pc_a || !pc_a->getEnabled())
+        if (!pc || !pc->getEnabled())
         {
             continue;
         }
-
-        auto *obj_a = pc_a->getOwner();
-        if (!obj_a)
+        auto *obj = pc->getOwner();
+        if (!obj)
         {
             continue;
         }
-        auto *cc_a = obj_a->getComponent<engine::component::ColliderComponent>();
-        if (!cc_a || !cc_a->isActive())
+        auto *cc = obj->getComponent<engine::component::ColliderComponent>();
+        if (!cc || !cc->isActive())
         {
             continue;
         }
+        entries.push_back({cc->getWorldAABB(), cc, obj});
+    }
 
-        for (size_t j = i + 1; j < _physics_components.size(); j++)
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        for (size_t j = i + 1; j < entries.size(); j++)
         {
-            auto *pc_b = _physics_components[j];
-            if (!pc_b || !pc_b->getEnabled())
-            {
-                continue;
-            }
-            auto *obj_a = pc_a->getOwner();
-            if (!obj_a)
+            auto &entry_a = entries[i];
+            auto &entry_b = entries[j];
+            // 先用连续数组中的AABB快速排除,重叠时再做精确形状检测
+            if (!collision::checkAABBOverlap(entry_a.aabb.position, entry_a.aabb.size, entry_b.aabb.position, entry_b.aabb.size))
             {
                 continue;
             }
-            auto *cc_a = obj_a->getComponent<engine::component::ColliderComponent>();
-            if (!cc_a)
+            if (!collision::checkCollision(*entry_a.collider, *entry_b.collider))
             {
                 continue;
             }
-            auto *obj_b = pc_b->getOwner();
-            if (!obj_b)
+
+            auto *obj_a = entry_a.owner;
+            auto *obj_b = entry_b.owner;
+            if (obj_a->getTargetId() != SOLID_TAG && obj_b->getTargetId() == SOLID_TAG)
             {
-                continue;
+                resolveSolidObjectCollisions(obj_a, obj_b);
+                // 被推开后刷新,后续检测使用新位置
+                entry_a.aabb = entry_a.collider->getWorldAABB();
             }
-            auto *cc_b = obj_b->getComponent<engine::component::ColliderComponent>();
-            if (!cc_b || !cc_b->isActive())
+            else if (obj_a->getTargetId() == SOLID_TAG && obj_b->getTargetId() != SOLID_TAG)
             {
-                continue;
+                resolveSolidObjectCollisions(obj_b, obj_a);
+                entry_b.aabb = entry_b.collider->getWorldAABB();
             }
-            if (collision::checkCollision(*cc_a, *cc_b))
+            else
             {
-
-                if (obj_a->getTarget() != "solid" && obj_b->getTarget() == "solid")
+                if (_event_bus)
                 {
-                    resolveSolidObjectCollisions(obj_a, obj_b);
-                }
-                else if (obj_a->getTarget() == "solid" && obj_b->getTarget() != "solid")
-                {
-                    resolveSolidObjectCollisions(obj_b, obj_a);
-                }
-                else
-                {
-                    _collision_pairs.emplace_back(obj_a, obj_b);
+                    _event_bus->publish(CollisionEvent{obj_a, obj_b});
                 }
             }
         }
@@ -442,8 +447,8 @@ void engine::physics::PhysicsEngine::checkTileTriggers()
 
         auto world_aabb = pc->getOwner()->getComponent<engine::component::ColliderComponent>()->getWorldAABB();
 
-        // 使用 set 防止同一帧内因接触多个同类瓦片而重复触发
-        std::set<engine::component::TileType> triggers_set;
+        // 同一帧内接触多个危险瓦片只触发一次
+        bool hazard_triggered = false;
 
         for (auto *layer : _collision_tile_layers)
         {
@@ -464,7 +469,7 @@ void engine::physics::PhysicsEngine::checkTileTriggers()
                     auto tile_type = layer->getTileTypeAt({x, y});
                     if (tile_type == engine::component::TileType::HAZARD)
                     {
-                        triggers_set.insert(tile_type);
+                        hazard_triggered = true;
                     }
                     else if (tile_type == engine::component::TileType::LADDER)
                     {
@@ -473,10 +478,12 @@ void engine::physics::PhysicsEngine::checkTileTriggers()
                 }
             }
         }
-        // 将本帧触发的所有唯一类型的事件记录下来
-        for (const auto &type : triggers_set)
+        if (hazard_triggered)
         {
-            _tile_tigger_events.emplace_back(pc->getOwner(), type);
+            if (_event_bus)
+            {
+                _event_bus->publish(TileTriggerEvent{pc->getOwner(), engine::component::TileType::HAZARD});
+            }
         }
     }
 }
@@ -1,11 +1,13 @@
 #pragma once
 #include <vector>
+#include <memory_resource>
 #include <glm/vec2.hpp>
 #include <optional>
 #include "../utils/math.h"
 namespace engine::component
 {
     class PhysicsComponent;
+    class ColliderComponent;
     class TileLayerComponent;
     enum class TileType;
 }
@@ -13,19 +15,32 @@ namespace engine::object
 {
     class GameObject;
 }
+namespace engine::core
+{
+    class EventBus;
+}
 namespace engine::physics
 {
     class PhysicsEngine
     {
     private:
         std::vector<engine::component::PhysicsComponent *> _physics_components;
+
+        /// @brief 物体碰撞检测的连续数据,每帧从碰撞盒缓存收集,避免两两检测时反复查找组件
+        struct CollisionEntry
+        {
+            engine::utils::Rect aabb;
+            engine::component::ColliderComponent *collider;
+            engine::object::GameObject *owner;
+        };
         glm::vec2 _gravity = {0.0f, 980.0f};
         float _max_speed = 500.0f;
-        std::vector<std::pair<engine::object::GameObject *, engine::object::GameObject *>> _collision_pairs;
+        /// @brief 每帧重建的临时容器所使用的内存资源(通常为帧分配器)
+        std::pmr::memory_resource *_frame_resource{std::pmr::get_default_resource()};
         std::vector<engine::component::TileLayerComponent *> _collision_tile_layers;
         std::optional<engine::utils::Rect> _world_bounds;
-
-        std::vector<std::pair<engine::object::GameObject *, engine::component::TileType>> _tile_tigger_events;
+        /// @brief 碰撞对和瓦片触发以CollisionEvent和TileTriggerEvent发布到这里,未设置时不发布
+        engine::core::EventBus *_event_bus{nullptr};
 
     public:
         PhysicsEngine() = default;
@@ -53,10 +68,13 @@ namespace engine::physics
         const glm::vec2 &getGravity() const { return _gravity; }
         float getMaxSpeed() const { return _max_speed; }
 
-        const std::vector<std::pair<engine::object::GameObject *, engine::component::TileType>> &getTileTriggerEvents() const { return _tile_tigger_events; }
+        /// @brief 设置每帧临时数据(碰撞检测条目)使用的内存资源
+        void setFrameResource(std::pmr::memory_resource *resource);
+        /// @brief 设置事件总线,之后每帧发布CollisionEvent和TileTriggerEvent
+        void setEventBus(engine::core::EventBus *event_bus) { _event_bus = event_bus; }
+
         void setWorldBounds(const engine::utils::Rect &world_bounds) { _world_bounds = world_bounds; }
         const std::optional<engine::utils::Rect> &getWorldBounds() const { return _world_bounds; }
-        const std::vector<std::pair<engine::object::GameObject *, engine::object::GameObject *>> &getCollisionPairs() const { return _collision_pairs; }
         void applyWorldBounds(engine::component::PhysicsComponent *pc);
 
         float getTileHeightAtWidth(float width, engine::component::TileType tile_type, glm::vec2 tile_size);
@@ -0,0 +1,27 @@
+#pragma once
+
+namespace engine::object
+{
+    class GameObject;
+}
+namespace engine::component
+{
+    enum class TileType;
+}
+
+namespace engine::physics
+{
+    /// @brief 两个非固体对象的碰撞盒发生重叠,只在发布的那一帧内有效
+    struct CollisionEvent
+    {
+        engine::object::GameObject *first{nullptr};
+        engine::object::GameObject *second{nullptr};
+    };
+
+    /// @brief 对象接触到特殊瓦片(如危险瓦片),只在发布的那一帧内有效
+    struct TileTriggerEvent
+    {
+        engine::object::GameObject *object{nullptr};
+        engine::component::TileType tile_type{};
+    };
+}
@@ -1,6 +1,7 @@
 #include "animation.h"
 #include <glm/common.hpp>
 #include <spdlog/spdlog.h>
+#include <algorithm>
 
 engine::render::Animation::Animation(const std::string &name, bool loop)
     : _name(name), _loop(loop)
@@ -16,6 +17,15 @@ void engine::render::Animation::addFrame(const SDL_Rect &source_rect, float dura
     }
     _frames.push_back({source_rect, duration});
     _total_duration += duration;
+    _frame_end_times.push_back(_total_duration);
+    if (_frames.size() == 1)
+    {
+        _uniform_duration = duration;
+    }
+    else if (duration != _uniform_duration)
+    {
+        _uniform_duration = 0.0f;
+    }
 }
 
 const engine::render::AnimationFrame &engine::render::Animation::getFrame(float time) const
@@ -25,27 +35,37 @@ const engine::render::AnimationFrame &engine::render::Animation::getFrame(float
         spdlog::error("Animation is empty: {}", _name);
         return _frames.back();
     }
-    float current_time = time;
-    if (_loop && _total_duration > 0.0f)
-    {
-        current_time = glm::mod(time, _total_duration);
-    }
-    else
+    return _frames[getFrameIndex(time)];
+}
+
+size_t engine::render::Animation::getFrameIndex(float time) const
+{
+    if (time >= _total_duration)
     {
-        if (current_time >= _total_duration)
+        if (!_loop || _total_duration <= 0.0f)
         {
-            return _frames.back();
+            return _frames.empty() ? 0 : _frames.size() - 1;
         }
+        time = glm::mod(time, _total_duration);
     }
+    return getFrameIndexInRange(time);
+}
 
-    float accumulated_time = 0.0f;
-    for (const auto &frame : _frames)
+size_t engine::render::Animation::getFrameIndexInRange(float time) const
+{
+    if (_frames.size() <= 1 || time <= 0.0f)
     {
-        accumulated_time += frame.duration;
-        if (current_time < accumulated_time)
-        {
-            return frame;
-        }
+        return 0;
+    }
+    size_t index;
+    if (_uniform_duration > 0.0f)
+    {
+        index = static_cast<size_t>(time / _uniform_duration);
+    }
+    else
+    {
+        index = static_cast<size_t>(std::upper_bound(_frame_end_times.begin(), _frame_end_times.end(), time) - _frame_end_times.begin());
     }
-    return _frames.back();
+    // 浮点误差可能越过最后一帧
+    return std::min(index, _frames.size() - 1);
 }
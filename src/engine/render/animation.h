@@ -19,7 +19,11 @@ namespace engine::render
     private:
         std::string _name;
         std::vector<AnimationFrame> _frames;
-        float _total_duration;
+        /// @brief 每帧的结束时间(累计时长),用于二分查找
+        std::vector<float> _frame_end_times;
+        float _total_duration = 0.0f;
+        /// @brief 所有帧时长相同时为该时长,帧下标可直接由除法得到;否则为0
+        float _uniform_duration = 0.0f;
         bool _loop = true;
 
     public:
@@ -34,6 +38,11 @@ namespace engine::render
         void addFrame(const SDL_Rect &source_rect, float duration);
 
         const AnimationFrame &getFrame(float time) const;
+        /// @brief 时间点对应的帧下标,循环动画按总时长取模,非循环动画超出后停在最后一帧
+        size_t getFrameIndex(float time) const;
+        /// @brief time已在[0, 总时长)内时的帧下标,等长帧O(1),否则二分查找
+        size_t getFrameIndexInRange(float time) const;
+        const AnimationFrame &getFrame(size_t index) const { return _frames[index]; }
 
         const std::string &getName() const { return _name; }
         const std::vector<AnimationFrame> &getFrames() const { return _frames; };
@@ -0,0 +1,58 @@
+#include "animation_system.h"
+#include "../component/animation_component.h"
+
+void engine::render::AnimationSystem::sync(engine::component::AnimationComponent *animation_component)
+{
+    if (animation_component->isPlaying())
+    {
+        if (animation_component->_batch_index == engine::component::AnimationComponent::NOT_BATCHED)
+        {
+            animation_component->_batch_index = _playing.size();
+            _playing.push_back(animation_component);
+        }
+    }
+    else
+    {
+        remove(animation_component);
+    }
+}
+
+void engine::render::AnimationSystem::remove(engine::component::AnimationComponent *animation_component)
+{
+    const size_t index = animation_component->_batch_index;
+    if (index == engine::component::AnimationComponent::NOT_BATCHED)
+    {
+        return;
+    }
+    _playing[index] = _playing.back();
+    _playing[index]->_batch_index = index;
+    _playing.pop_back();
+    animation_component->_batch_index = engine::component::AnimationComponent::NOT_BATCHED;
+}
+
+void engine::render::AnimationSystem::update(float dt)
+{
+    for (size_t i = 0; i < _playing.size();)
+    {
+        auto *animation_component = _playing[i];
+        animation_component->advance(dt);
+        if (animation_component->isPlaying())
+        {
+            ++i;
+        }
+        else
+        {
+            // 换到当前位置的组件还没推进,不递增下标
+            remove(animation_component);
+        }
+    }
+}
+
+void engine::render::AnimationSystem::clear()
+{
+    for (auto *animation_component : _playing)
+    {
+        animation_component->_batch_index = engine::component::AnimationComponent::NOT_BATCHED;
+    }
+    _playing.clear();
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+namespace engine::component
+{
+    class AnimationComponent;
+}
+
+namespace engine::render
+{
+    /**
+     * @brief 批量推进动画
+     *
+     * 只登记正在播放的动画组件,紧凑存放,每帧一次线性遍历全部推进,
+     * 播放结束或停止的组件以交换末尾的方式移除。由场景持有。
+     */
+    class AnimationSystem final
+    {
+    private:
+        std::vector<engine::component::AnimationComponent *> _playing;
+
+    public:
+        AnimationSystem() = default;
+
+        AnimationSystem(const AnimationSystem &) = delete;
+        AnimationSystem &operator=(const AnimationSystem &) = delete;
+        AnimationSystem(AnimationSystem &&) = delete;
+        AnimationSystem &operator=(AnimationSystem &&) = delete;
+
+        /// @brief 按组件当前是否在播放登记或移除
+        void sync(engine::component::AnimationComponent *animation_component);
+        void remove(engine::component::AnimationComponent *animation_component);
+        void update(float dt);
+        void clear();
+
+        size_t size() const { return _playing.size(); }
+    };
+}
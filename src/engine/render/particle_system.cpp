@@ -0,0 +1,284 @@
+#include "particle_system.h"
+#include "render.h"
+#include "camera.h"
+#include "../core/context.h"
+#include "../resource/resource_manager.h"
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+
+namespace
+{
+    engine::render::ParticleEffect parseEffect(const nlohmann::json &json)
+    {
+        engine::render::ParticleEffect effect;
+        effect.name = json.at("name").get<std::string>();
+        effect.texture_id = json.at("texture").get<std::string>();
+        // 帧可以逐个给出,也可以按从左到右排列的等大帧生成
+        if (auto frames = json.find("frames"); frames != json.end())
+        {
+            for (const auto &frame : *frames)
+            {
+                effect.frames.push_back(SDL_FRect{frame.at(0).get<float>(), frame.at(1).get<float>(), frame.at(2).get<float>(), frame.at(3).get<float>()});
+            }
+        }
+        else
+        {
+            const float frame_width = json.at("frame_width").get<float>();
+            const float frame_height = json.at("frame_height").get<float>();
+            const int frame_count = json.value("frame_count", 1);
+            for (int i = 0; i < frame_count; ++i)
+            {
+                effect.frames.push_back(SDL_FRect{i * frame_width, 0.0f, frame_width, frame_height});
+            }
+        }
+        effect.frame_duration = json.value("frame_duration", effect.frame_duration);
+        effect.lifetime = json.value("lifetime", effect.lifetime);
+        effect.loop = json.value("loop", effect.loop);
+        effect.count = json.value("count", effect.count);
+        effect.speed_min = json.value("speed_min", effect.speed_min);
+        effect.speed_max = json.value("speed_max", effect.speed_max);
+        effect.direction = json.value("direction", effect.direction);
+        effect.spread = json.value("spread", effect.spread);
+        if (auto gravity = json.find("gravity"); gravity != json.end())
+        {
+            effect.gravity = {gravity->at(0).get<float>(), gravity->at(1).get<float>()};
+        }
+        effect.order.layer = json.value("layer", effect.order.layer);
+        effect.order.depth = json.value("depth", effect.order.depth);
+        effect.order.unordered = json.value("unordered", effect.order.unordered);
+        return effect;
+    }
+}
+
+bool engine::render::ParticleSystem::loadEffects(const std::string &file_path, engine::resource::ResourceManager &resource_manager)
+{
+    try
+    {
+        std::ifstream ifs(file_path);
+        if (!ifs.is_open())
+        {
+            spdlog::error("Failed to open particle effects file: {}", file_path);
+            return false;
+        }
+        nlohmann::json json;
+        ifs >> json;
+        setCapacity(json.value("capacity", _capacity));
+        for (const auto &effect_json : json.at("effects"))
+        {
+            addEffect(parseEffect(effect_json), resource_manager);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        spdlog::error("Failed to load particle effects: {},{},{},{}", file_path, e.what(), __FILE__, __LINE__);
+        return false;
+    }
+    spdlog::info("Loaded {} particle effects from {}, capacity {}", _effects.size(), file_path, _capacity);
+    return true;
+}
+
+size_t engine::render::ParticleSystem::addEffect(ParticleEffect effect, engine::resource::ResourceManager &resource_manager)
+{
+    if (effect.frames.empty() || effect.frames.size() > std::numeric_limits<uint16_t>::max())
+    {
+        spdlog::warn("Particle effect {} has an invalid frame count: {}", effect.name, effect.frames.size());
+        return INVALID_EFFECT;
+    }
+    if (effect.frame_duration <= 0.0f)
+    {
+        effect.frame_duration = 0.1f;
+    }
+    if (effect.lifetime <= 0.0f)
+    {
+        effect.lifetime = effect.frame_duration * static_cast<float>(effect.frames.size());
+    }
+
+    auto [it, inserted] = _effect_indices.try_emplace(effect.name, _effects.size());
+    if (inserted && _effects.size() > std::numeric_limits<uint16_t>::max())
+    {
+        _effect_indices.erase(it);
+        spdlog::warn("Too many particle effects, {} ignored", effect.name);
+        return INVALID_EFFECT;
+    }
+    // 预加载纹理,使其能在之后的图集打包中合入图集
+    auto handle = resource_manager.getTextureHandle(effect.texture_id);
+    if (inserted)
+    {
+        _effects.push_back(std::move(effect));
+        _effect_textures.push_back(handle);
+    }
+    else
+    {
+        // 覆盖定义时清除旧粒子,避免帧下标越界
+        clear();
+        _effects[it->second] = std::move(effect);
+        _effect_textures[it->second] = handle;
+    }
+    return it->second;
+}
+
+size_t engine::render::ParticleSystem::findEffect(const std::string &name) const
+{
+    auto it = _effect_indices.find(name);
+    return it != _effect_indices.end() ? it->second : INVALID_EFFECT;
+}
+
+void engine::render::ParticleSystem::setCapacity(size_t capacity)
+{
+    _capacity = capacity;
+    _count = 0;
+    // 已分配的存储超过新上限时收缩,否则保留以免再次增长
+    if (_position_x.size() > capacity)
+    {
+        for (auto *values : {&_position_x, &_position_y, &_velocity_x, &_velocity_y, &_age, &_lifetime})
+        {
+            values->resize(capacity);
+            values->shrink_to_fit();
+        }
+        for (auto *values : {&_frame, &_effect})
+        {
+            values->resize(capacity);
+            values->shrink_to_fit();
+        }
+    }
+}
+
+bool engine::render::ParticleSystem::grow()
+{
+    const size_t size = _position_x.size();
+    if (size >= _capacity)
+    {
+        return false;
+    }
+    const size_t new_size = std::min(_capacity, std::max(INITIAL_STORAGE, size * 2));
+    for (auto *values : {&_position_x, &_position_y, &_velocity_x, &_velocity_y, &_age, &_lifetime})
+    {
+        values->resize(new_size);
+    }
+    for (auto *values : {&_frame, &_effect})
+    {
+        values->resize(new_size);
+    }
+    return true;
+}
+
+void engine::render::ParticleSystem::emit(size_t effect_index, const glm::vec2 &position)
+{
+    if (effect_index >= _effects.size())
+    {
+        return;
+    }
+    const auto &effect = _effects[effect_index];
+    std::uniform_real_distribution<float> angle_distribution(effect.direction - effect.spread * 0.5f, effect.direction + effect.spread * 0.5f);
+    std::uniform_real_distribution<float> speed_distribution(effect.speed_min, glm::max(effect.speed_min, effect.speed_max));
+    for (uint32_t i = 0; i < effect.count; ++i)
+    {
+        if (_count == _position_x.size() && !grow())
+        {
+            _dropped += effect.count - i;
+            return;
+        }
+        const float angle = glm::radians(angle_distribution(_random));
+        const float speed = speed_distribution(_random);
+        const size_t index = _count++;
+        _position_x[index] = position.x;
+        _position_y[index] = position.y;
+        _velocity_x[index] = std::cos(angle) * speed;
+        _velocity_y[index] = std::sin(angle) * speed;
+        _age[index] = 0.0f;
+        _lifetime[index] = effect.lifetime;
+        _frame[index] = 0;
+        _effect[index] = static_cast<uint16_t>(effect_index);
+    }
+}
+
+void engine::render::ParticleSystem::emit(const std::string &name, const glm::vec2 &position)
+{
+    emit(findEffect(name), position);
+}
+
+void engine::render::ParticleSystem::update(float dt)
+{
+    for (size_t i = 0; i < _count;)
+    {
+        const float age = _age[i] + dt;
+        if (age >= _lifetime[i])
+        {
+            kill(i);
+            continue;
+        }
+        const auto &effect = _effects[_effect[i]];
+        _age[i] = age;
+        _velocity_x[i] += effect.gravity.x * dt;
+        _velocity_y[i] += effect.gravity.y * dt;
+        _position_x[i] += _velocity_x[i] * dt;
+        _position_y[i] += _velocity_y[i] * dt;
+
+        const size_t frame_count = effect.frames.size();
+        const auto frame = static_cast<size_t>(age / effect.frame_duration);
+        _frame[i] = static_cast<uint16_t>(effect.loop ? frame % frame_count : glm::min(frame, frame_count - 1));
+        ++i;
+    }
+}
+
+void engine::render::ParticleSystem::render(engine::core::Context &context)
+{
+    if (_count == 0)
+    {
+        return;
+    }
+    auto &renderer = context.getRender();
+    const auto &camera = context.getCamera();
+    auto &resource_manager = context.getResourceManager();
+    // 纹理区域按特效解析一次;卸载或重新打包后句柄失效,按纹理ID重新获取
+    _effect_regions.resize(_effects.size());
+    for (size_t e = 0; e < _effects.size(); ++e)
+    {
+        _effect_regions[e] = resource_manager.resolveTexture(_effect_textures[e]);
+        if (!_effect_regions[e])
+        {
+            _effect_textures[e] = resource_manager.getTextureHandle(_effects[e].texture_id);
+            _effect_regions[e] = resource_manager.resolveTexture(_effect_textures[e]);
+        }
+    }
+
+    for (size_t i = 0; i < _count; ++i)
+    {
+        const size_t effect_index = _effect[i];
+        const auto *region = _effect_regions[effect_index];
+        if (!region || !region->texture)
+        {
+            continue;
+        }
+        const auto &effect = _effects[effect_index];
+        const SDL_FRect &frame = effect.frames[_frame[i]];
+        // 纹理可能已打包进图集,帧区域相对于纹理ID对应的区域
+        const SDL_FRect src_rect{region->rect.x + frame.x, region->rect.y + frame.y, frame.w, frame.h};
+        // 粒子位置为中心点
+        const glm::vec2 position(_position_x[i] - frame.w * 0.5f, _position_y[i] - frame.h * 0.5f);
+        renderer.drawTexture(camera, region->texture, src_rect, position, glm::vec2(frame.w, frame.h), effect.order);
+    }
+}
+
+void engine::render::ParticleSystem::clear()
+{
+    _count = 0;
+}
+
+void engine::render::ParticleSystem::kill(size_t index)
+{
+    const size_t last = --_count;
+    _position_x[index] = _position_x[last];
+    _position_y[index] = _position_y[last];
+    _velocity_x[index] = _velocity_x[last];
+    _velocity_y[index] = _velocity_y[last];
+    _age[index] = _age[last];
+    _lifetime[index] = _lifetime[last];
+    _frame[index] = _frame[last];
+    _effect[index] = _effect[last];
+}
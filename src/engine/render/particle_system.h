@@ -0,0 +1,137 @@
+#pragma once
+#include "render_queue.h"
+#include "../resource/texture_handle.h"
+#include <SDL3/SDL_rect.h>
+#include <glm/vec2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace engine::core
+{
+    class Context;
+}
+
+namespace engine::resource
+{
+    class ResourceManager;
+    struct TextureRegion;
+}
+
+namespace engine::render
+{
+    /// @brief 粒子特效的定义,每次发射按此生成一组粒子
+    struct ParticleEffect
+    {
+        std::string name;
+        std::string texture_id;
+        /// @brief 帧序列在纹理中的区域,按存活时间依次播放
+        std::vector<SDL_FRect> frames;
+        float frame_duration{0.1f};
+        /// @brief 粒子存活时长, <=0 时为播完全部帧的时长
+        float lifetime{0.0f};
+        /// @brief 存活期间循环播放帧序列,否则停在最后一帧
+        bool loop{false};
+        /// @brief 每次发射的粒子数
+        uint32_t count{1};
+        float speed_min{0.0f};
+        float speed_max{0.0f};
+        /// @brief 发射方向(度), 0 为 +x, -90 为向上
+        float direction{-90.0f};
+        /// @brief 方向的随机范围(度),以direction为中心
+        float spread{360.0f};
+        /// @brief 粒子的加速度
+        glm::vec2 gravity{0.0f, 0.0f};
+        /// @brief 粒子之间的遮挡无关紧要,默认按纹理分组绘制
+        RenderOrder order{.unordered = true};
+    };
+
+    /**
+     * @brief 粒子系统
+     *
+     * 粒子按结构数组存放(位置、速度、已存活时间、寿命、帧下标、所属特效),存储随发射按需倍增到容量上限,
+     * 达到过的粒子数以内发射和销毁都不再分配内存:容量满时丢弃新粒子,死亡粒子与末尾交换后移除。
+     * 每帧一次线性遍历推进全部粒子,绘制时经过渲染队列,同纹理的粒子在队列中分组后合为一个批次提交。
+     * 粒子只用于表现,不进入场景快照和回溯。由场景持有。
+     */
+    class ParticleSystem final
+    {
+    public:
+        static constexpr size_t DEFAULT_CAPACITY = 65536;
+        /// @brief 第一次发射时分配的存储大小
+        static constexpr size_t INITIAL_STORAGE = 256;
+        static constexpr size_t INVALID_EFFECT = SIZE_MAX;
+
+    private:
+        std::vector<ParticleEffect> _effects;
+        std::unordered_map<std::string, size_t> _effect_indices;
+        /// @brief 每个特效的纹理句柄,绘制时解析
+        std::vector<engine::resource::TextureHandle> _effect_textures;
+        /// @brief 绘制时每个特效解析一次的纹理区域,在帧之间复用
+        std::vector<const engine::resource::TextureRegion *> _effect_regions;
+
+        std::vector<float> _position_x;
+        std::vector<float> _position_y;
+        std::vector<float> _velocity_x;
+        std::vector<float> _velocity_y;
+        std::vector<float> _age;
+        std::vector<float> _lifetime;
+        std::vector<uint16_t> _frame;
+        std::vector<uint16_t> _effect;
+        size_t _count{0};
+        /// @brief 同时存在的粒子数上限,存储按需增长到该值
+        size_t _capacity{DEFAULT_CAPACITY};
+        /// @brief 因容量已满而丢弃的粒子数
+        size_t _dropped{0};
+        /// @brief 固定种子,同样的输入得到同样的粒子
+        std::minstd_rand _random{0x5eed};
+
+    public:
+        ParticleSystem() = default;
+
+        ParticleSystem(const ParticleSystem &) = delete;
+        ParticleSystem &operator=(const ParticleSystem &) = delete;
+        ParticleSystem(ParticleSystem &&) = delete;
+        ParticleSystem &operator=(ParticleSystem &&) = delete;
+
+        /// @brief 从JSON文件加载特效定义并预加载纹理,同名特效会被覆盖
+        /// @return 文件不存在或格式错误时返回false
+        [[nodiscard]] bool loadEffects(const std::string &file_path, engine::resource::ResourceManager &resource_manager);
+        /// @brief 添加或覆盖一个特效定义
+        /// @return 特效下标,帧序列为空时返回INVALID_EFFECT
+        size_t addEffect(ParticleEffect effect, engine::resource::ResourceManager &resource_manager);
+        /// @return 不存在时返回INVALID_EFFECT
+        size_t findEffect(const std::string &name) const;
+        const ParticleEffect &getEffect(size_t index) const { return _effects[index]; }
+
+        /// @brief 设置最多同时存在的粒子数,会清除现有粒子;存储不会预先分配到该大小
+        void setCapacity(size_t capacity);
+
+        /// @brief 在position处发射一次特效
+        void emit(size_t effect_index, const glm::vec2 &position);
+        /// @brief 按名称发射,特效不存在时忽略
+        void emit(const std::string &name, const glm::vec2 &position);
+
+        void update(float dt);
+        /// @brief 提交所有粒子,应在场景的渲染队列记录期间调用
+        void render(engine::core::Context &context);
+        /// @brief 清除所有粒子,保留特效定义
+        void clear();
+
+        size_t size() const { return _count; }
+        size_t getCapacity() const { return _capacity; }
+        /// @brief 当前已分配的粒子存储大小
+        size_t getStorageSize() const { return _position_x.size(); }
+        size_t getDroppedCount() const { return _dropped; }
+
+    private:
+        /// @brief 存储已满且未到容量上限时倍增存储
+        /// @return 仍然没有空位时返回false
+        bool grow();
+        /// @brief 移除下标为index的粒子,末尾粒子移到该位置
+        void kill(size_t index);
+    };
+}
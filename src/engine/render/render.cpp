@@ -4,8 +4,9 @@
 #include <spdlog/spdlog.h>
 #include <SDL3/SDL.h>
 #include <stdexcept>
-engine::render::Renderer::Renderer(SDL_Renderer *sdl_renderer, engine::resource::ResourceManager *resource_manager)
-    : _renderer(sdl_renderer), _resource_manager(resource_manager)
+#include <utility>
+engine::render::Renderer::Renderer(SDL_Renderer *sdl_renderer, engine::resource::ResourceManager *resource_manager, RenderBackend backend)
+    : _renderer(sdl_renderer), _resource_manager(resource_manager), _backend(backend)
 {
     spdlog::info("Renderer init ...");
     if (!_renderer)
@@ -16,60 +17,116 @@ engine::render::Renderer::Renderer(SDL_Renderer *sdl_renderer, engine::resource:
     {
         throw std::runtime_error("Renderer init failed");
     }
+    _sprite_batch = std::make_unique<SpriteBatch>(_renderer);
+    _sprite_batch->setDryRun(!isDrawingEnabled());
+    _render_queue = std::make_unique<RenderQueue>();
+#if SDL_VERSION_ATLEAST(3, 4, 0)
+    _texture_wrapping = SDL_GetBooleanProperty(SDL_GetRendererProperties(_renderer), SDL_PROP_RENDERER_TEXTURE_WRAPPING_BOOLEAN, false);
+#endif
+    // 重置事件可能在事件循环之外产生,用监视回调而不是依赖输入管理器轮询
+    if (isDrawingEnabled() && !SDL_AddEventWatch(&Renderer::onRenderEvent, this))
+    {
+        spdlog::warn("Renderer failed to watch render reset events: {}", SDL_GetError());
+    }
 
-    spdlog::info("Renderer init successfully");
+    spdlog::info("Renderer init successfully, backend: {}", toString(_backend));
 }
 
-void engine::render::Renderer::drawSprite(const Camera &camera, const engine::render::Sprite &sprite, const glm::vec2 &position, const glm::vec2 &scale, double angle)
+engine::render::Renderer::~Renderer()
 {
-    auto texture = _resource_manager->getTexture(sprite.getTextureId());
-    if (!texture)
+    if (isDrawingEnabled())
     {
-        spdlog::error("Texture not found:{}", sprite.getTextureId());
-        return;
+        SDL_RemoveEventWatch(&Renderer::onRenderEvent, this);
     }
-    auto src_rect = getSpriteSrcRect(sprite);
-    if (!src_rect.has_value())
+}
+
+void engine::render::Renderer::drawSprite(const Camera &camera, const engine::render::Sprite &sprite, const glm::vec2 &position, const glm::vec2 &scale, double angle,
+                                          const RenderOrder &order)
+{
+    auto source = getSpriteSource(sprite);
+    if (!source.has_value())
     {
-        spdlog::error("Invalid source rectangle:{}", sprite.getTextureId());
         return;
     }
+    const SDL_FRect &src_rect = source->src_rect;
 
     glm::vec2 position_screen = camera.world2Screen(position);
-    float scale_w = src_rect.value().w * scale.x;
-    float scale_h = src_rect.value().h * scale.y;
+    float scale_w = src_rect.w * scale.x;
+    float scale_h = src_rect.h * scale.y;
     SDL_FRect dest_rect = {position_screen.x, position_screen.y, scale_w, scale_h};
     if (!isRectInViewport(camera, dest_rect))
     {
+        ++_frame_stats.sprites_culled;
         return;
     }
 
-    if (!SDL_RenderTextureRotated(_renderer, texture, &src_rect.value(), &dest_rect, angle, NULL, sprite.isFlipped() ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE))
-    {
-        spdlog::error("Render texture failed:{},{}", sprite.getTextureId(), SDL_GetError());
-    }
+    submitQuad(source->texture, src_rect, dest_rect, angle, sprite.isFlipped() ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE, order);
+}
+
+void engine::render::Renderer::drawTexture(const Camera &camera, SDL_Texture *texture, const glm::vec2 &position, const glm::vec2 &size, const RenderOrder &order)
+{
+    drawTexture(camera, texture, SDL_FRect{0.0f, 0.0f, size.x, size.y}, position, size, order);
 }
 
-void engine::render::Renderer::drawParallx(const Camera &camera, const engine::render::Sprite &sprite, const glm::vec2 &position, const glm::vec2 &scroll_factor, const glm::bvec2 &repeat, const glm::vec2 &scale)
+void engine::render::Renderer::drawTexture(const Camera &camera, SDL_Texture *texture, const SDL_FRect &src_rect, const glm::vec2 &position, const glm::vec2 &size,
+                                           const RenderOrder &order)
 {
-    auto texture = _resource_manager->getTexture(sprite.getTextureId());
     if (!texture)
     {
-        spdlog::error("Texture not found:{}", sprite.getTextureId());
         return;
     }
-    auto src_rect = getSpriteSrcRect(sprite);
-    if (!src_rect.has_value())
+    glm::vec2 position_screen = camera.world2Screen(position);
+    SDL_FRect dest_rect = {position_screen.x, position_screen.y, size.x, size.y};
+    if (!isRectInViewport(camera, dest_rect))
+    {
+        ++_frame_stats.sprites_culled;
+        return;
+    }
+    submitQuad(texture, src_rect, dest_rect, 0.0, SDL_FLIP_NONE, order);
+}
+
+void engine::render::Renderer::drawParallx(const Camera &camera, const engine::render::Sprite &sprite, const glm::vec2 &position, const glm::vec2 &scroll_factor, const glm::bvec2 &repeat, const glm::vec2 &scale,
+                                           const RenderOrder &order)
+{
+    auto source = getSpriteSource(sprite);
+    if (!source.has_value())
     {
-        spdlog::error("Invalid source rectangle:{}", sprite.getTextureId());
         return;
     }
     glm::vec2 position_screen = camera.world2ScreenWithParallax(position, scroll_factor);
-    float scale_w = src_rect.value().w * scale.x;
-    float scale_h = src_rect.value().h * scale.y;
+    float scale_w = source->src_rect.w * scale.x;
+    float scale_h = source->src_rect.h * scale.y;
+    if (scale_w <= 0.0f || scale_h <= 0.0f)
+    {
+        return;
+    }
+    glm::vec2 viewport_size = camera.getViewportSize();
+
+    if ((repeat.x || repeat.y) && canWrapTexture(source.value()))
+    {
+        // 重复方向上用一个四边形铺满视口,滚动偏移换算为纹理坐标,由WRAP寻址平铺
+        SDL_FRect dest_rect = {position_screen.x, position_screen.y, scale_w, scale_h};
+        SDL_FRect src_rect = source->src_rect;
+        if (repeat.x)
+        {
+            dest_rect.x = 0.0f;
+            dest_rect.w = viewport_size.x;
+            src_rect.x = glm::mod(-position_screen.x / scale.x, source->src_rect.w);
+            src_rect.w = viewport_size.x / scale.x;
+        }
+        if (repeat.y)
+        {
+            dest_rect.y = 0.0f;
+            dest_rect.h = viewport_size.y;
+            src_rect.y = glm::mod(-position_screen.y / scale.y, source->src_rect.h);
+            src_rect.h = viewport_size.y / scale.y;
+        }
+        submitQuad(source->texture, src_rect, dest_rect, 0.0, SDL_FLIP_NONE, order, RenderMaterial::WRAP);
+        return;
+    }
+
     glm::vec2 start;
     glm::vec2 stop;
-    glm::vec2 viewport_size = camera.getViewportSize();
     if (repeat.x)
     {
         start.x = glm::mod(position_screen.x, scale_w) - scale_w;
@@ -91,32 +148,22 @@ void engine::render::Renderer::drawParallx(const Camera &camera, const engine::r
         stop.y = glm::min(position_screen.y + scale_h, viewport_size.y);
     }
 
+    // 不能平铺寻址时逐块绘制,与普通精灵一样经过队列和批处理
     for (float y = start.y; y < stop.y; y += scale_h)
     {
         for (float x = start.x; x < stop.x; x += scale_w)
         {
             SDL_FRect dest_rect = {x, y, scale_w, scale_h};
-            if (!SDL_RenderTexture(_renderer, texture, nullptr, &dest_rect))
-            {
-                spdlog::error("Render texture failed:{},{}", sprite.getTextureId(), SDL_GetError());
-                return;
-            }
+            submitQuad(source->texture, source->src_rect, dest_rect, 0.0, SDL_FLIP_NONE, order);
         }
     }
 }
 
 void engine::render::Renderer::drawUISprite(const engine::render::Sprite &sprite, const glm::vec2 &position, const std::optional<glm::vec2> &size)
 {
-    auto texture = _resource_manager->getTexture(sprite.getTextureId());
-    if (!texture)
-    {
-        spdlog::error("Texture not found:{}", sprite.getTextureId());
-        return;
-    }
-    auto src_rct = getSpriteSrcRect(sprite);
-    if (!src_rct.has_value())
+    auto source = getSpriteSource(sprite);
+    if (!source.has_value())
     {
-        spdlog::error("Invalid source rectangle:{}", sprite.getTextureId());
         return;
     }
     SDL_FRect dest_rect = {position.x, position.y, 0, 0};
@@ -127,17 +174,20 @@ void engine::render::Renderer::drawUISprite(const engine::render::Sprite &sprite
     }
     else
     {
-        dest_rect.w = src_rct.value().w;
-        dest_rect.h = src_rct.value().h;
-    }
-    if (!SDL_RenderTextureRotated(_renderer, texture, &src_rct.value(), &dest_rect, 0, nullptr, sprite.isFlipped() ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE))
-    {
-        spdlog::error("Render texture failed:{},{}", sprite.getTextureId(), SDL_GetError());
+        dest_rect.w = source->src_rect.w;
+        dest_rect.h = source->src_rect.h;
     }
+    _sprite_batch->draw(source->texture, source->src_rect, dest_rect, 0.0, sprite.isFlipped() ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE);
 }
 
 void engine::render::Renderer::drawUIFillRect(const engine::utils::Rect &rect, const engine::utils::FColor &color)
 {
+    flush();
+    if (!isDrawingEnabled())
+    {
+        return;
+    }
+    ++_frame_stats.draw_calls;
     setDrawColorFloat(color.r, color.g, color.b, color.a);
     SDL_FRect sdl_rect = {rect.position.x, rect.position.y, rect.size.x, rect.size.y};
     if (!SDL_RenderFillRect(_renderer, &sdl_rect))
@@ -147,13 +197,43 @@ void engine::render::Renderer::drawUIFillRect(const engine::utils::Rect &rect, c
     setDrawColorFloat(0.0f, 0.0f, 0.0f, 1.0f);
 }
 
+void engine::render::Renderer::flush()
+{
+    _sprite_batch->flush();
+}
+
+void engine::render::Renderer::beginQueue()
+{
+    _render_queue->begin();
+}
+
+void engine::render::Renderer::submitQueue()
+{
+    _render_queue->submit(*_sprite_batch);
+}
+
 void engine::render::Renderer::present()
 {
-    SDL_RenderPresent(_renderer);
+    flush();
+    const auto batch_stats = _sprite_batch->takeStats();
+    _frame_stats.draw_calls += static_cast<uint32_t>(batch_stats.draw_calls);
+    _frame_stats.sprites_submitted = static_cast<uint32_t>(batch_stats.quads);
+    _frame_stats.texture_switches = static_cast<uint32_t>(batch_stats.texture_switches);
+    _frame_stats.vertices = static_cast<uint32_t>(batch_stats.vertices);
+    _last_frame_stats = std::exchange(_frame_stats, RenderStats{});
+    if (isDrawingEnabled())
+    {
+        SDL_RenderPresent(_renderer);
+    }
 }
 
 void engine::render::Renderer::clearScreen()
 {
+    flush();
+    if (!isDrawingEnabled())
+    {
+        return;
+    }
     if (!SDL_RenderClear(_renderer))
     {
         spdlog::error("Render clear failed:{}", SDL_GetError());
@@ -176,41 +256,34 @@ void engine::render::Renderer::setDrawColorFloat(float r, float g, float b, floa
     }
 }
 
-std::optional<SDL_FRect> engine::render::Renderer::getSpriteSrcRect(const Sprite &sprite)
+std::optional<engine::render::Renderer::SpriteSource> engine::render::Renderer::getSpriteSource(const Sprite &sprite)
 {
-    SDL_Texture *texture = _resource_manager->getTexture(sprite.getTextureId());
-    if (!texture)
+    // 句柄按下标取区域;首次绘制或纹理被卸载后才按纹理ID重新解析一次
+    const auto *region = _resource_manager->resolveTexture(sprite.getTextureHandle());
+    if (!region)
     {
-        spdlog::error("Texture not found: {}", sprite.getTextureId());
-        return std::nullopt;
+        sprite.setTextureHandle(_resource_manager->getTextureHandle(sprite.getTextureId()));
+        region = _resource_manager->resolveTexture(sprite.getTextureHandle());
     }
-    auto src_rect = sprite.getSourceRect();
-    if (src_rect.has_value())
+    if (!region || !region->texture)
     {
-        const auto &rect = src_rect.value();
-        if (rect.w <= 0 || rect.h <= 0)
-        {
-            spdlog::error("Invalid source rectangle: texture={}, rect=({},{},{},{})",
-                          sprite.getTextureId(), rect.x, rect.y, rect.w, rect.h);
-            return std::nullopt;
-        }
-        // 将 SDL_Rect (int) 转换为 SDL_FRect (float)
-        return SDL_FRect{
-            static_cast<float>(rect.x),
-            static_cast<float>(rect.y),
-            static_cast<float>(rect.w),
-            static_cast<float>(rect.h)};
+        return std::nullopt;
     }
-    else
+    // 纹理可能已打包进图集,源矩形相对于纹理ID对应的区域
+    if (sprite.getSourceRect().has_value())
     {
-        SDL_FRect result = {0, 0, 0, 0};
-        if (!SDL_GetTextureSize(texture, &result.w, &result.h))
+        const SDL_FRect &rect = sprite.getSourceFRect();
+        if (rect.w <= 0.0f || rect.h <= 0.0f)
         {
-            spdlog::error("Get texture size failed:{}", sprite.getTextureId());
             return std::nullopt;
         }
-        return result;
+        return SpriteSource{region->texture, SDL_FRect{region->rect.x + rect.x, region->rect.y + rect.y, rect.w, rect.h}};
     }
+    return SpriteSource{region->texture, SDL_FRect{
+                                             static_cast<float>(region->rect.x),
+                                             static_cast<float>(region->rect.y),
+                                             static_cast<float>(region->rect.w),
+                                             static_cast<float>(region->rect.h)}};
 }
 
 bool engine::render::Renderer::isRectInViewport(const Camera &camera, const SDL_FRect &rect)
@@ -218,3 +291,60 @@ bool engine::render::Renderer::isRectInViewport(const Camera &camera, const SDL_
     glm::vec2 viewport_size = camera.getViewportSize();
     return rect.x + rect.w >= 0 && rect.x <= viewport_size.x && rect.y + rect.h >= 0 && rect.y <= viewport_size.y;
 }
+
+void engine::render::Renderer::submitQuad(SDL_Texture *texture, const SDL_FRect &src_rect, const SDL_FRect &dest_rect, double angle, SDL_FlipMode flip, const RenderOrder &order,
+                                          RenderMaterial material)
+{
+    if (_render_queue->isActive())
+    {
+        _render_queue->push(order, material, RenderQueue::Command{texture, src_rect, dest_rect, static_cast<float>(angle), flip});
+        return;
+    }
+    if (material == RenderMaterial::WRAP)
+    {
+        _sprite_batch->setWrap(true);
+        _sprite_batch->draw(texture, src_rect, dest_rect, angle, flip);
+        _sprite_batch->setWrap(false);
+        return;
+    }
+    _sprite_batch->draw(texture, src_rect, dest_rect, angle, flip);
+}
+
+bool engine::render::Renderer::canWrapTexture(const SpriteSource &source) const
+{
+    // SDL 3.4之前没有纹理寻址方式,视差背景逐块绘制
+    if (!SpriteBatch::WRAP_SUPPORTED)
+    {
+        return false;
+    }
+    // 平铺作用于整张纹理,图集中的区域或子矩形不能用
+    float width = 0.0f;
+    float height = 0.0f;
+    if (!SDL_GetTextureSize(source.texture, &width, &height) || width <= 0.0f || height <= 0.0f)
+    {
+        return false;
+    }
+    if (source.src_rect.x != 0.0f || source.src_rect.y != 0.0f || source.src_rect.w != width || source.src_rect.h != height)
+    {
+        return false;
+    }
+    if (_texture_wrapping)
+    {
+        return true;
+    }
+    // 不支持非2的幂纹理平铺的渲染器上,2的幂纹理仍可平铺
+    const auto is_power_of_two = [](float value)
+    {
+        const auto n = static_cast<uint32_t>(value);
+        return (n & (n - 1)) == 0;
+    };
+    return is_power_of_two(width) && is_power_of_two(height);
+}
+bool engine::render::Renderer::onRenderEvent(void *userdata, SDL_Event *event)
+{
+    if (event->type == SDL_EVENT_RENDER_TARGETS_RESET || event->type == SDL_EVENT_RENDER_DEVICE_RESET)
+    {
+        static_cast<Renderer *>(userdata)->_render_target_resets.fetch_add(1, std::memory_order_acq_rel);
+    }
+    return true;
+}
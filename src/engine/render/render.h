@@ -3,8 +3,12 @@
 #include <optional>
 #include <glm/glm.hpp>
 #include "../utils/math.h"
-struct SDL_Renderer;
-struct SDL_FRect;
+#include "sprite_batch.h"
+#include "render_queue.h"
+#include "render_backend.h"
+#include "render_stats.h"
+#include <atomic>
+#include <memory>
 
 namespace engine::resource
 {
@@ -19,13 +23,35 @@ namespace engine::render
     class Renderer final
     {
     private:
+        /// @brief 精灵解析后的纹理和源矩形
+        struct SpriteSource
+        {
+            SDL_Texture *texture;
+            SDL_FRect src_rect;
+        };
+
         /// @brief 指向主SDL渲染器的非拥有指针
         SDL_Renderer *_renderer{nullptr};
         /// @brief 指向资源管理器的非拥有指针
         engine::resource::ResourceManager *_resource_manager{nullptr};
+        /// @brief 精灵和UI图片都经由批处理提交
+        std::unique_ptr<SpriteBatch> _sprite_batch;
+        /// @brief 本帧累计中的统计(批处理之外的部分),present时与批处理统计合并
+        RenderStats _frame_stats;
+        /// @brief 上一帧的统计,在present时更新
+        RenderStats _last_frame_stats;
+        /// @brief 记录期间的世界绘制先入队,排序后再送入批处理
+        std::unique_ptr<RenderQueue> _render_queue;
+        /// @brief 渲染器是否支持非2的幂纹理的WRAP寻址
+        bool _texture_wrapping{false};
+        RenderBackend _backend{RenderBackend::SDL};
+        /// @brief 渲染目标或渲染设备被重置的次数,此时目标纹理的内容已丢失
+        std::atomic<uint32_t> _render_target_resets{0};
 
     public:
-        Renderer(SDL_Renderer *sdl_renderer, engine::resource::ResourceManager *resource_manager);
+        /// @param backend 为NONE时所有绘制只统计不提交,sdl_renderer仅用于创建纹理
+        Renderer(SDL_Renderer *sdl_renderer, engine::resource::ResourceManager *resource_manager, RenderBackend backend = RenderBackend::SDL);
+        ~Renderer();
         Renderer(const Renderer &) = delete;
         Renderer &operator=(const Renderer &) = delete;
         Renderer(Renderer &&) = delete;
@@ -37,9 +63,20 @@ namespace engine::render
         /// @param position
         /// @param scale
         /// @param angle
-        void drawSprite(const Camera &camera, const engine::render::Sprite &sprite, const glm::vec2 &position, const glm::vec2 &scale = {1.0f, 1.0f}, double angle = 0.0f);
+        /// @param order 绘制队列记录期间使用的层和深度
+        void drawSprite(const Camera &camera, const engine::render::Sprite &sprite, const glm::vec2 &position, const glm::vec2 &scale = {1.0f, 1.0f}, double angle = 0.0f,
+                        const RenderOrder &order = {});
+
+        /// @brief 绘制整张纹理(如预渲染的瓦片区块)
+        /// @param position 左上角的世界坐标
+        /// @param size 绘制尺寸
+        void drawTexture(const Camera &camera, SDL_Texture *texture, const glm::vec2 &position, const glm::vec2 &size, const RenderOrder &order = {});
+        /// @brief 绘制纹理中的一块区域(如粒子的当前帧)
+        /// @param src_rect 纹理中的源矩形
+        void drawTexture(const Camera &camera, SDL_Texture *texture, const SDL_FRect &src_rect, const glm::vec2 &position, const glm::vec2 &size,
+                         const RenderOrder &order = {});
 
-        /// @brief 绘制视差滚动背景
+        /// @brief 绘制视差滚动背景,可平铺寻址时整层只提交一个四边形
         /// @param camera
         /// @param sprite
         /// @param position
@@ -47,7 +84,13 @@ namespace engine::render
         /// @param repeat 是否重复
         /// @param scale 缩放因子
         void drawParallx(const Camera &camera, const engine::render::Sprite &sprite, const glm::vec2 &position,
-                         const glm::vec2 &scroll_factor, const glm::bvec2 &repeat = {true, true}, const glm::vec2 &scale = {1.0f, 1.0f});
+                         const glm::vec2 &scroll_factor, const glm::bvec2 &repeat = {true, true}, const glm::vec2 &scale = {1.0f, 1.0f},
+                         const RenderOrder &order = {});
+
+        /// @brief 开始记录世界绘制命令,场景渲染游戏对象之前调用
+        void beginQueue();
+        /// @brief 排序并提交记录的命令,之后的绘制(如UI)立即进入批处理
+        void submitQueue();
 
         /// @brief 绘制UI
         /// @param sprite
@@ -56,6 +99,8 @@ namespace engine::render
         void drawUISprite(const engine::render::Sprite &sprite, const glm::vec2 &position, const std::optional<glm::vec2> &size = std::nullopt);
 
         void drawUIFillRect(const engine::utils::Rect &rect, const engine::utils::FColor &color);
+        /// @brief 提交累积的精灵批次,直接调用SDL绘制之前必须调用
+        void flush();
         /// @brief 更新屏幕
         void present();
         /// @brief 清空屏幕
@@ -65,16 +110,36 @@ namespace engine::render
         void setDrawColorFloat(float r, float g, float b, float a = 1.0f);
 
         SDL_Renderer *getSDLRenderer() const { return _renderer; }
+        const RenderStats &getLastFrameStats() const { return _last_frame_stats; }
+        /// @brief 记录绕过批处理的文字绘制,由TextRenderer调用
+        void recordText(uint32_t text_objects, uint32_t draw_calls)
+        {
+            _frame_stats.text_objects += text_objects;
+            _frame_stats.draw_calls += draw_calls;
+        }
+        RenderBackend getBackend() const { return _backend; }
+        /// @brief 是否真正向SDL提交绘制
+        bool isDrawingEnabled() const { return _backend != RenderBackend::NONE; }
+        size_t getLastQueueCommandCount() const { return _render_queue->getLastCommandCount(); }
+        /// @brief 与上次读取的值不同时,之前绘制到目标纹理上的内容需要重新绘制
+        uint32_t getRenderTargetResets() const { return _render_target_resets.load(std::memory_order_acquire); }
 
     private:
-        /// @brief 获取精灵的源矩形
+        /// @brief 精灵实际使用的纹理和源矩形(纹理打包进图集时为图集坐标)
         /// @param sprite
-        /// @return
-        std::optional<SDL_FRect> getSpriteSrcRect(const Sprite &sprite);
+        /// @return 纹理不存在或源矩形无效时返回std::nullopt
+        std::optional<SpriteSource> getSpriteSource(const Sprite &sprite);
         /// @brief 判断矩形是否在视口内
         /// @param camera
         /// @param rect
         /// @return
         bool isRectInViewport(const Camera &camera, const SDL_FRect &rect);
+        /// @brief 记录期间入队,否则直接送入批处理
+        void submitQuad(SDL_Texture *texture, const SDL_FRect &src_rect, const SDL_FRect &dest_rect, double angle, SDL_FlipMode flip, const RenderOrder &order,
+                        RenderMaterial material = RenderMaterial::DEFAULT);
+        /// @brief 纹理能否用WRAP寻址平铺:源矩形为整张纹理,且渲染器支持该纹理尺寸
+        bool canWrapTexture(const SpriteSource &source) const;
+        /// @brief SDL事件监视回调,记录SDL_EVENT_RENDER_TARGETS_RESET和SDL_EVENT_RENDER_DEVICE_RESET
+        static bool onRenderEvent(void *userdata, SDL_Event *event);
     };
 }
\ No newline at end of file
@@ -0,0 +1,32 @@
+#include "render_backend.h"
+
+std::optional<engine::render::RenderBackend> engine::render::parseRenderBackend(std::string_view name)
+{
+    if (name == "sdl")
+    {
+        return RenderBackend::SDL;
+    }
+    if (name == "offscreen")
+    {
+        return RenderBackend::OFFSCREEN;
+    }
+    if (name == "null" || name == "none")
+    {
+        return RenderBackend::NONE;
+    }
+    return std::nullopt;
+}
+
+std::string_view engine::render::toString(RenderBackend backend)
+{
+    switch (backend)
+    {
+    case RenderBackend::SDL:
+        return "sdl";
+    case RenderBackend::OFFSCREEN:
+        return "offscreen";
+    case RenderBackend::NONE:
+        return "null";
+    }
+    return "unknown";
+}
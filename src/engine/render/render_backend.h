@@ -0,0 +1,21 @@
+#pragma once
+#include <optional>
+#include <string_view>
+
+namespace engine::render
+{
+    /// @brief 渲染后端
+    enum class RenderBackend
+    {
+        /// @brief 窗口加SDL硬件渲染器
+        SDL,
+        /// @brief 无窗口,SDL软件渲染器绘制到内存中的SDL_Surface
+        OFFSCREEN,
+        /// @brief 不绘制,只统计批次和四边形;纹理仍在1x1的软件渲染器上创建以提供尺寸
+        NONE,
+    };
+
+    /// @brief 解析配置或命令行中的后端名称: sdl, offscreen, null
+    std::optional<RenderBackend> parseRenderBackend(std::string_view name);
+    std::string_view toString(RenderBackend backend);
+}
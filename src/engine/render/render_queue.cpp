@@ -0,0 +1,110 @@
+#include "render_queue.h"
+#include "sprite_batch.h"
+#include <algorithm>
+#include <array>
+
+void engine::render::RenderQueue::begin()
+{
+    _commands.clear();
+    _keys.clear();
+    _sequence = 0;
+    _texture_groups.clear();
+    _last_texture_group = 0;
+    _active = true;
+}
+
+void engine::render::RenderQueue::push(const RenderOrder &order, RenderMaterial material, const Command &command)
+{
+    // 深度加偏移转为无符号,使负深度排在前面;提交序号在材质之前,同层同深度内不会因纹理或材质改变先后。
+    // 无序命令以纹理分组代替提交序号,同组命令仍按提交顺序(基数排序稳定)
+    const uint64_t depth = static_cast<uint16_t>(static_cast<int32_t>(order.depth) + 32768);
+    const uint64_t sequence = (order.unordered ? textureGroup(command.texture) : _sequence++) & 0x7FFFFFFF;
+    _keys.push_back(static_cast<uint64_t>(order.layer) << 56 | depth << 40 | static_cast<uint64_t>(order.unordered) << 39 | sequence << 8 |
+                    static_cast<uint64_t>(material));
+    _commands.push_back(command);
+}
+
+void engine::render::RenderQueue::submit(SpriteBatch &batch)
+{
+    _active = false;
+    sort();
+    // 排序后_keys与_order一一对应,材质从键中取出
+    for (size_t i = 0; i < _order.size(); ++i)
+    {
+        const auto material = static_cast<RenderMaterial>(_keys[i] & 0xFF);
+        batch.setWrap(material == RenderMaterial::WRAP);
+        const auto &command = _commands[_order[i]];
+        batch.draw(command.texture, command.src_rect, command.dest_rect, command.angle, command.flip);
+    }
+    batch.setWrap(false);
+    _last_command_count = _commands.size();
+    _commands.clear();
+    _keys.clear();
+}
+
+uint32_t engine::render::RenderQueue::textureGroup(SDL_Texture *texture)
+{
+    // 每帧用到的纹理很少,先查上一次命中的分组,再线性查找
+    if (_last_texture_group < _texture_groups.size() && _texture_groups[_last_texture_group] == texture)
+    {
+        return static_cast<uint32_t>(_last_texture_group);
+    }
+    auto it = std::find(_texture_groups.begin(), _texture_groups.end(), texture);
+    _last_texture_group = static_cast<size_t>(it - _texture_groups.begin());
+    if (it == _texture_groups.end())
+    {
+        _texture_groups.push_back(texture);
+    }
+    return static_cast<uint32_t>(_last_texture_group);
+}
+
+void engine::render::RenderQueue::sort()
+{
+    const size_t count = _keys.size();
+    _order.resize(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        _order[i] = i;
+    }
+    // 对象大多按层的顺序提交,已有序时无需排序
+    if (count < 2 || std::is_sorted(_keys.begin(), _keys.end()))
+    {
+        return;
+    }
+
+    // 一次遍历统计8个字节位的直方图,所有键在某字节上相同时跳过该趟
+    std::array<std::array<uint32_t, 256>, 8> histograms{};
+    for (uint64_t key : _keys)
+    {
+        for (size_t byte = 0; byte < 8; ++byte)
+        {
+            ++histograms[byte][(key >> (byte * 8)) & 0xFF];
+        }
+    }
+
+    _scratch_keys.resize(count);
+    _scratch_order.resize(count);
+    for (size_t byte = 0; byte < 8; ++byte)
+    {
+        auto &histogram = histograms[byte];
+        if (histogram[(_keys[0] >> (byte * 8)) & 0xFF] == count)
+        {
+            continue;
+        }
+        uint32_t offset = 0;
+        for (auto &bucket : histogram)
+        {
+            const uint32_t bucket_count = bucket;
+            bucket = offset;
+            offset += bucket_count;
+        }
+        for (size_t i = 0; i < count; ++i)
+        {
+            const uint32_t position = histogram[(_keys[i] >> (byte * 8)) & 0xFF]++;
+            _scratch_keys[position] = _keys[i];
+            _scratch_order[position] = _order[i];
+        }
+        _keys.swap(_scratch_keys);
+        _order.swap(_scratch_order);
+    }
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <SDL3/SDL_render.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace engine::render
+{
+    class SpriteBatch;
+
+    /// @brief 显式的绘制顺序: 先按层,同层再按深度,数值小的先画
+    struct RenderOrder
+    {
+        /// @brief 未指定时的层,高于关卡中的所有图层(特效等运行时对象默认画在最上面)
+        static constexpr uint8_t DEFAULT_LAYER = 200;
+        /// @brief 关卡图层从该层开始按Tiled中的顺序编号
+        static constexpr uint8_t LEVEL_LAYER_BASE = 16;
+
+        uint8_t layer = DEFAULT_LAYER;
+        int16_t depth = 0;
+        /// @brief 同层同深度内先后无关(网格中互不重叠的瓦片、粒子),可按纹理分组绘制
+        bool unordered = false;
+    };
+
+    /// @brief 排序键中的材质,决定提交时的渲染状态
+    enum class RenderMaterial : uint8_t
+    {
+        DEFAULT = 0,
+        /// @brief 纹理坐标超出[0,1]时平铺(视差背景)
+        WRAP = 1,
+    };
+
+    /**
+     * @brief 每帧的世界绘制命令队列
+     *
+     * 场景渲染期间的世界绘制只记录命令和64位排序键(层|深度|无序标记|提交序号或纹理分组|材质),
+     * 提交时基数排序后依次送入SpriteBatch。同层同深度的有序命令严格按提交顺序绘制;
+     * 标记为无序的命令排在其后,按纹理分组(组内保持提交顺序),减少纹理切换。
+     * 每帧结果确定;相邻的同纹理命令由SpriteBatch合并为一个批次。
+     */
+    class RenderQueue final
+    {
+    public:
+        struct Command
+        {
+            SDL_Texture *texture;
+            SDL_FRect src_rect;
+            SDL_FRect dest_rect;
+            float angle;
+            SDL_FlipMode flip;
+        };
+
+    private:
+        std::vector<Command> _commands;
+        std::vector<uint64_t> _keys;
+        std::vector<uint32_t> _order;
+        /// @brief 排序时复用的缓冲
+        std::vector<uint64_t> _scratch_keys;
+        std::vector<uint32_t> _scratch_order;
+        bool _active{false};
+        /// @brief 本帧下一条命令的提交序号
+        uint32_t _sequence{0};
+        /// @brief 本帧无序命令用到的纹理,下标即纹理分组,按首次出现的顺序编号
+        std::vector<SDL_Texture *> _texture_groups;
+        size_t _last_texture_group{0};
+        size_t _last_command_count{0};
+
+    public:
+        RenderQueue() = default;
+
+        RenderQueue(const RenderQueue &) = delete;
+        RenderQueue &operator=(const RenderQueue &) = delete;
+        RenderQueue(RenderQueue &&) = delete;
+        RenderQueue &operator=(RenderQueue &&) = delete;
+
+        /// @brief 开始记录,之前未提交的命令被丢弃
+        void begin();
+        bool isActive() const { return _active; }
+        void push(const RenderOrder &order, RenderMaterial material, const Command &command);
+        /// @brief 排序后把所有命令送入batch并结束记录
+        void submit(SpriteBatch &batch);
+
+        size_t getLastCommandCount() const { return _last_command_count; }
+
+    private:
+        uint32_t textureGroup(SDL_Texture *texture);
+        void sort();
+    };
+}
@@ -0,0 +1,29 @@
+#include "render_stats.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <stdexcept>
+
+engine::render::RenderStatsCsvWriter::RenderStatsCsvWriter(const std::string &file_path)
+    : _file(file_path, std::ios::out | std::ios::trunc)
+{
+    if (!_file.is_open())
+    {
+        throw std::runtime_error("Failed to open render stats file: " + file_path);
+    }
+    _file << "frame,frame_ms,draw_calls,sprites_submitted,sprites_culled,texture_switches,text_objects,vertices,heap_allocations,"
+             "spawn_pending,spawn_frames_behind,spawn_us\n";
+    spdlog::info("Render stats CSV: {}", file_path);
+}
+
+void engine::render::RenderStatsCsvWriter::write(uint64_t frame, float frame_ms, const RenderStats &stats, size_t heap_allocations,
+                                                 const engine::scene::SpawnQueue::Stats &spawn_stats)
+{
+    // 格式化到栈上缓冲再整行写入,避免每帧临时字符串
+    char line[256];
+    auto result = fmt::format_to_n(line, sizeof(line), "{},{:.3f},{},{},{},{},{},{},{},{},{},{:.1f}\n", frame, frame_ms,
+                                   stats.draw_calls, stats.sprites_submitted, stats.sprites_culled,
+                                   stats.texture_switches, stats.text_objects, stats.vertices, heap_allocations,
+                                   spawn_stats.pending, spawn_stats.oldest_wait_frames, spawn_stats.spent_us);
+    _file.write(line, static_cast<std::streamsize>(std::min(result.size, sizeof(line))));
+    ++_rows;
+}
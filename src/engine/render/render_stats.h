@@ -0,0 +1,49 @@
+#pragma once
+#include "../scene/spawn_queue.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+namespace engine::render
+{
+    /// @brief 一帧的渲染开销,在Renderer::present时结算
+    struct RenderStats
+    {
+        uint32_t draw_calls{0};        ///< @brief 提交给SDL的绘制调用(几何批次、填充矩形、文字)
+        uint32_t sprites_submitted{0}; ///< @brief 进入批处理的四边形
+        uint32_t sprites_culled{0};    ///< @brief 在视口外被剔除的精灵
+        uint32_t texture_switches{0};  ///< @brief 批次之间的纹理切换
+        uint32_t text_objects{0};      ///< @brief 创建的TTF_Text对象
+        uint32_t vertices{0};          ///< @brief 提交的几何顶点
+    };
+
+    /**
+     * @brief 逐帧把渲染统计追加到CSV文件
+     *
+     * 写入经过文件流缓冲,析构时落盘,用于记录整局游戏的渲染开销曲线。
+     * 同一行附带当前场景生成队列的积压情况,便于对照分帧构造造成的开销。
+     */
+    class RenderStatsCsvWriter final
+    {
+    private:
+        std::ofstream _file;
+        uint64_t _rows{0};
+
+    public:
+        /// @throw std::runtime_error 文件无法打开时抛出
+        explicit RenderStatsCsvWriter(const std::string &file_path);
+
+        RenderStatsCsvWriter(const RenderStatsCsvWriter &) = delete;
+        RenderStatsCsvWriter &operator=(const RenderStatsCsvWriter &) = delete;
+        RenderStatsCsvWriter(RenderStatsCsvWriter &&) = delete;
+        RenderStatsCsvWriter &operator=(RenderStatsCsvWriter &&) = delete;
+
+        /// @param frame 帧序号
+        /// @param frame_ms 该帧耗时(毫秒)
+        /// @param heap_allocations 该帧主线程的堆分配次数(未启用ENGINE_TRACK_ALLOCATIONS时为0)
+        /// @param spawn_stats 当前场景生成队列在该帧的处理情况
+        void write(uint64_t frame, float frame_ms, const RenderStats &stats, size_t heap_allocations,
+                   const engine::scene::SpawnQueue::Stats &spawn_stats);
+        uint64_t getRowCount() const { return _rows; }
+    };
+}
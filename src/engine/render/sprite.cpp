@@ -1,6 +1,30 @@
 #include "sprite.h"
 
 engine::render::Sprite::Sprite(const std::string &texture_id, std::optional<SDL_Rect> source_rect, bool is_flipped)
-    : _texture_id(texture_id), _source_rect(source_rect), _is_flipped(is_flipped)
+    : _texture_id(texture_id), _is_flipped(is_flipped)
 {
-}
\ No newline at end of file
+    setSourceRect(source_rect);
+}
+
+void engine::render::Sprite::setTextureId(const std::string &texture_id)
+{
+    if (texture_id != _texture_id)
+    {
+        _texture_id = texture_id;
+        _texture_handle = engine::resource::TextureHandle{};
+    }
+}
+
+void engine::render::Sprite::setSourceRect(const std::optional<SDL_Rect> &source_rect)
+{
+    _source_rect = source_rect;
+    if (_source_rect.has_value())
+    {
+        const auto &rect = _source_rect.value();
+        _source_frect = SDL_FRect{static_cast<float>(rect.x), static_cast<float>(rect.y), static_cast<float>(rect.w), static_cast<float>(rect.h)};
+    }
+    else
+    {
+        _source_frect = SDL_FRect{0.0f, 0.0f, 0.0f, 0.0f};
+    }
+}
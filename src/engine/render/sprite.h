@@ -1,4 +1,5 @@
 #pragma once
+#include "../resource/texture_handle.h"
 #include <SDL3/SDL_rect.h>
 #include <optional>
 #include <string>
@@ -12,6 +13,10 @@ namespace engine::render
         std::string _texture_id;
         /// @brief 源矩形
         std::optional<SDL_Rect> _source_rect;
+        /// @brief 预先转换的浮点源矩形,绘制时直接使用
+        SDL_FRect _source_frect{0.0f, 0.0f, 0.0f, 0.0f};
+        /// @brief 解析后的纹理句柄,由渲染器在首次绘制时填入,纹理ID改变时失效
+        mutable engine::resource::TextureHandle _texture_handle;
         /// @brief 是否翻转
         bool _is_flipped = false;
 
@@ -25,9 +30,13 @@ namespace engine::render
 
         const std::string &getTextureId() const { return _texture_id; }
         const std::optional<SDL_Rect> &getSourceRect() const { return _source_rect; }
+        const SDL_FRect &getSourceFRect() const { return _source_frect; }
+        const engine::resource::TextureHandle &getTextureHandle() const { return _texture_handle; }
         bool isFlipped() const { return _is_flipped; }
-        void setTextureId(const std::string &texture_id) { _texture_id = texture_id; }
-        void setSourceRect(const std::optional<SDL_Rect> &source_rect) { _source_rect = source_rect; }
+        void setTextureId(const std::string &texture_id);
+        void setSourceRect(const std::optional<SDL_Rect> &source_rect);
+        /// @brief 缓存解析结果,不改变精灵的可见状态
+        void setTextureHandle(const engine::resource::TextureHandle &handle) const { _texture_handle = handle; }
         void setFlipped(bool is_flipped) { _is_flipped = is_flipped; }
     };
 
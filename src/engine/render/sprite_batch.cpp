@@ -0,0 +1,133 @@
+#include "sprite_batch.h"
+#include <spdlog/spdlog.h>
+#include <cmath>
+#include <numbers>
+#include <utility>
+
+engine::render::SpriteBatch::SpriteBatch(SDL_Renderer *renderer)
+    : _renderer(renderer)
+{
+    // 足够容纳一屏瓦片,避免首帧反复扩容
+    _vertices.reserve(4096);
+    _indices.reserve(6144);
+}
+
+void engine::render::SpriteBatch::draw(SDL_Texture *texture, const SDL_FRect &src_rect, const SDL_FRect &dest_rect,
+                                       double angle, SDL_FlipMode flip, const SDL_FColor &color)
+{
+    if (!texture)
+    {
+        return;
+    }
+    if (texture != _texture)
+    {
+        flush();
+        if (texture != _last_texture)
+        {
+            ++_stats.texture_switches;
+            _last_texture = texture;
+        }
+        _texture = texture;
+        if (!SDL_GetTextureSize(texture, &_texture_width, &_texture_height) || _texture_width <= 0.0f || _texture_height <= 0.0f)
+        {
+            spdlog::error("SpriteBatch get texture size failed: {}", SDL_GetError());
+            _texture = nullptr;
+            return;
+        }
+    }
+
+    float u0 = src_rect.x / _texture_width;
+    float v0 = src_rect.y / _texture_height;
+    float u1 = (src_rect.x + src_rect.w) / _texture_width;
+    float v1 = (src_rect.y + src_rect.h) / _texture_height;
+    if (flip & SDL_FLIP_HORIZONTAL)
+    {
+        std::swap(u0, u1);
+    }
+    if (flip & SDL_FLIP_VERTICAL)
+    {
+        std::swap(v0, v1);
+    }
+
+    // 以目标矩形中心为原点的四个角: 左上 右上 右下 左下
+    const float half_w = dest_rect.w * 0.5f;
+    const float half_h = dest_rect.h * 0.5f;
+    const float center_x = dest_rect.x + half_w;
+    const float center_y = dest_rect.y + half_h;
+    SDL_FPoint corners[4] = {{-half_w, -half_h}, {half_w, -half_h}, {half_w, half_h}, {-half_w, half_h}};
+    if (angle != 0.0)
+    {
+        const float radians = static_cast<float>(angle * std::numbers::pi / 180.0);
+        const float c = std::cos(radians);
+        const float s = std::sin(radians);
+        for (auto &corner : corners)
+        {
+            corner = {corner.x * c - corner.y * s, corner.x * s + corner.y * c};
+        }
+    }
+    const SDL_FPoint uvs[4] = {{u0, v0}, {u1, v0}, {u1, v1}, {u0, v1}};
+
+    const int base = static_cast<int>(_vertices.size());
+    for (int i = 0; i < 4; ++i)
+    {
+        _vertices.push_back({{center_x + corners[i].x, center_y + corners[i].y}, color, uvs[i]});
+    }
+    _indices.insert(_indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+    ++_stats.quads;
+}
+
+void engine::render::SpriteBatch::setWrap(bool wrap)
+{
+    if (wrap != _wrap)
+    {
+        flush();
+        _wrap = wrap;
+    }
+}
+
+void engine::render::SpriteBatch::flush()
+{
+    if (_indices.empty())
+    {
+        _texture = nullptr;
+        return;
+    }
+    _stats.vertices += _vertices.size();
+    if (_dry_run)
+    {
+        ++_stats.draw_calls;
+        _vertices.clear();
+        _indices.clear();
+        _texture = nullptr;
+        return;
+    }
+#if SDL_VERSION_ATLEAST(3, 4, 0)
+    // 寻址方式是渲染器状态,只在本批次内生效,提交后恢复默认
+    if (_wrap)
+    {
+        SDL_SetRenderTextureAddressMode(_renderer, SDL_TEXTURE_ADDRESS_WRAP, SDL_TEXTURE_ADDRESS_WRAP);
+    }
+#endif
+    if (!SDL_RenderGeometry(_renderer, _texture, _vertices.data(), static_cast<int>(_vertices.size()),
+                            _indices.data(), static_cast<int>(_indices.size())))
+    {
+        spdlog::error("SpriteBatch SDL_RenderGeometry failed: {}", SDL_GetError());
+    }
+#if SDL_VERSION_ATLEAST(3, 4, 0)
+    if (_wrap)
+    {
+        SDL_SetRenderTextureAddressMode(_renderer, SDL_TEXTURE_ADDRESS_AUTO, SDL_TEXTURE_ADDRESS_AUTO);
+    }
+#endif
+    ++_stats.draw_calls;
+    _vertices.clear();
+    _indices.clear();
+    // 下一批重新查询纹理尺寸,纹理在帧之间可能被释放并在同一地址重建
+    _texture = nullptr;
+}
+
+engine::render::SpriteBatch::Stats engine::render::SpriteBatch::takeStats()
+{
+    _last_texture = nullptr;
+    return std::exchange(_stats, Stats{});
+}
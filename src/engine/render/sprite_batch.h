@@ -0,0 +1,68 @@
+#pragma once
+#include <SDL3/SDL_render.h>
+#include <SDL3/SDL_version.h>
+#include <cstddef>
+#include <vector>
+
+namespace engine::render
+{
+    /**
+     * @brief 精灵批处理
+     *
+     * 把连续使用同一纹理的四边形累积到顶点/索引缓冲中,纹理切换或flush时
+     * 以一次SDL_RenderGeometry提交。翻转和旋转在CPU上计算到顶点中。
+     * 其他直接调用SDL渲染的代码在绘制前必须先flush,以保持绘制顺序。
+     */
+    class SpriteBatch final
+    {
+    public:
+        /// @brief 纹理寻址方式是SDL 3.4新增的接口,更早的版本上不能平铺,调用方应退回逐块绘制
+        static constexpr bool WRAP_SUPPORTED = SDL_VERSION_ATLEAST(3, 4, 0);
+
+        /// @brief 一帧内的提交情况
+        struct Stats
+        {
+            size_t draw_calls{0};       ///< @brief SDL_RenderGeometry调用次数
+            size_t quads{0};            ///< @brief 提交的四边形数量
+            size_t texture_switches{0}; ///< @brief 新批次的纹理与上一批次不同的次数
+            size_t vertices{0};         ///< @brief 提交的顶点数量
+        };
+
+    private:
+        SDL_Renderer *_renderer{nullptr};
+        /// @brief 当前批次的纹理及其尺寸(用于计算UV)
+        SDL_Texture *_texture{nullptr};
+        float _texture_width{1.0f};
+        float _texture_height{1.0f};
+        /// @brief 上一批次的纹理,仅用于统计纹理切换
+        const SDL_Texture *_last_texture{nullptr};
+        /// @brief 当前批次是否使用WRAP寻址,UV超出[0,1]时平铺纹理
+        bool _wrap{false};
+        /// @brief 为true时flush只统计不提交,用于不绘制的渲染后端
+        bool _dry_run{false};
+        std::vector<SDL_Vertex> _vertices;
+        std::vector<int> _indices;
+        Stats _stats;
+
+    public:
+        explicit SpriteBatch(SDL_Renderer *renderer);
+
+        SpriteBatch(const SpriteBatch &) = delete;
+        SpriteBatch &operator=(const SpriteBatch &) = delete;
+        SpriteBatch(SpriteBatch &&) = delete;
+        SpriteBatch &operator=(SpriteBatch &&) = delete;
+
+        /// @brief 添加一个四边形,与SDL_RenderTextureRotated的参数含义一致(绕目标矩形中心顺时针旋转)
+        void draw(SDL_Texture *texture, const SDL_FRect &src_rect, const SDL_FRect &dest_rect,
+                  double angle = 0.0, SDL_FlipMode flip = SDL_FLIP_NONE, const SDL_FColor &color = {1.0f, 1.0f, 1.0f, 1.0f});
+        /// @brief 设置之后的四边形是否用WRAP寻址,与当前批次不同时先提交;WRAP_SUPPORTED为false时不起作用
+        void setWrap(bool wrap);
+        /// @brief 提交当前批次
+        void flush();
+        void setDryRun(bool dry_run) { _dry_run = dry_run; }
+
+        /// @brief 返回自上次调用以来的统计并清零
+        Stats takeStats();
+        bool empty() const { return _indices.empty(); }
+    };
+}
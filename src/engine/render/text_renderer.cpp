@@ -1,19 +1,24 @@
 #include "text_renderer.h"
 #include "camera.h"
+#include "render.h"
 #include "../resource/resource_manager.h"
 #include <SDL3_ttf/SDL_ttf.h>
 #include <spdlog/spdlog.h>
 #include <stdexcept>
-engine::render::TextRenderer::TextRenderer(SDL_Renderer *sdl_renderer, engine::resource::ResourceManager *resource_manager)
-    : _sdl_renderer(sdl_renderer), _resource_manager(resource_manager)
+engine::render::TextRenderer::TextRenderer(SDL_Renderer *sdl_renderer, engine::resource::ResourceManager *resource_manager, Renderer *renderer)
+    : _sdl_renderer(sdl_renderer), _resource_manager(resource_manager), _renderer(renderer)
 {
     if (!_sdl_renderer || !_resource_manager)
     {
         throw std::runtime_error("TextRenderer init failed");
     }
-    if (!TTF_WasInit() && TTF_Init() == false)
+    if (!TTF_WasInit())
     {
-        throw std::runtime_error("TTF_Init failed");
+        if (TTF_Init() == false)
+        {
+            throw std::runtime_error("TTF_Init failed");
+        }
+        _owns_ttf = true;
     }
     _text_engine = TTF_CreateRendererTextEngine(_sdl_renderer);
     if (!_text_engine)
@@ -40,11 +45,21 @@ void engine::render::TextRenderer::close()
         _text_engine = nullptr;
         spdlog::info("TextRenderer close successfully");
     }
-    TTF_Quit();
+    if (_owns_ttf)
+    {
+        TTF_Quit();
+        _owns_ttf = false;
+    }
 }
 
 void engine::render::TextRenderer::drawUIText(const std::string &text, const std::string &font_id, int font_size, const glm::vec2 &position, const engine::utils::FColor &color)
 {
+    if (_renderer && !_renderer->isDrawingEnabled())
+    {
+        // 空后端不创建文字也不绘制,但仍计入文字数,使统计与真实后端可比
+        _renderer->recordText(1, 0);
+        return;
+    }
     TTF_Font *font = _resource_manager->getFont(font_id, font_size);
     if (!font)
     {
@@ -57,6 +72,12 @@ void engine::render::TextRenderer::drawUIText(const std::string &text, const std
         spdlog::error("TTF_CreateText failed");
         return;
     }
+    if (_renderer)
+    {
+        _renderer->flush();
+        // 阴影和正文各一次绘制
+        _renderer->recordText(1, 2);
+    }
     TTF_SetTextColorFloat(temp_text_object, 0.0f, 0.0f, 0.0f, 1.0f);
     if (!TTF_DrawRendererText(temp_text_object, position.x + 2, position.y + 2))
     {
@@ -92,6 +113,10 @@ glm::vec2 engine::render::TextRenderer::getTextSize(const std::string &text, con
         return glm::vec2{0, 0};
     }
 
+    if (_renderer)
+    {
+        _renderer->recordText(1, 0);
+    }
     int width, height;
     TTF_GetTextSize(temp_text_object, &width, &height);
     TTF_DestroyText(temp_text_object);
@@ -14,15 +14,20 @@ namespace engine::resource
 namespace engine::render
 {
     class Camera;
+    class Renderer;
     class TextRenderer final
     {
     private:
         SDL_Renderer *_sdl_renderer = nullptr;
         engine::resource::ResourceManager *_resource_manager = nullptr;
         TTF_TextEngine *_text_engine = nullptr;
+        /// @brief 绘制文字前先提交其精灵批次,保持与精灵的绘制顺序
+        Renderer *_renderer = nullptr;
+        /// @brief TTF由本对象初始化时才在close中退出,避免影响共享TTF的其他实例
+        bool _owns_ttf = false;
 
     public:
-        TextRenderer(SDL_Renderer *sdl_renderer, engine::resource::ResourceManager *resource_manager);
+        TextRenderer(SDL_Renderer *sdl_renderer, engine::resource::ResourceManager *resource_manager, Renderer *renderer = nullptr);
         ~TextRenderer();
         TextRenderer(const TextRenderer &) = delete;
         TextRenderer(TextRenderer &&) = delete;
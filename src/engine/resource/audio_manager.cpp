@@ -2,13 +2,19 @@
 #include <algorithm>
 #include <spdlog/spdlog.h>
 #include <stdexcept>
-engine::resource::AudioManager::AudioManager()
+engine::resource::AudioManager::AudioManager(bool enable_device)
 {
+    if (!enable_device)
+    {
+        spdlog::info("AudioManager created without audio device");
+        return;
+    }
     if (!MIX_Init())
     {
         throw std::runtime_error("SDL_mixer Init Failed" + std::string(SDL_GetError()));
         return;
     }
+    _mixer_initialized = true;
     SDL_AudioSpec spec{};
     spec.freq = 48000;
     spec.format = SDL_AUDIO_F32;
@@ -26,11 +32,18 @@ engine::resource::AudioManager::~AudioManager()
         MIX_DestroyMixer(_mixer);
         _mixer = nullptr;
     }
-    MIX_Quit();
+    if (_mixer_initialized)
+    {
+        MIX_Quit();
+    }
 }
 
 MIX_Audio *engine::resource::AudioManager::loadSound(const std::string &file_path)
 {
+    if (!_mixer_initialized)
+    {
+        return nullptr;
+    }
     // 检查是否已经加载
     auto it = _audios.find(file_path);
     if (it != _audios.end())
@@ -54,6 +67,10 @@ MIX_Audio *engine::resource::AudioManager::loadSound(const std::string &file_pat
 
 MIX_Audio *engine::resource::AudioManager::loadMusic(const std::string &file_path)
 {
+    if (!_mixer_initialized)
+    {
+        return nullptr;
+    }
     // 检查是否已经加载
     auto it = _musics.find(file_path);
     if (it != _musics.end())
@@ -16,7 +16,8 @@ namespace engine::resource
         friend class ResourceManager;
 
     public:
-        AudioManager();
+        /// @param enable_device 为false时不初始化SDL_mixer也不打开输出设备(无头运行),所有加载返回nullptr
+        explicit AudioManager(bool enable_device = true);
         AudioManager(const AudioManager &) = delete;
         AudioManager &operator=(const AudioManager &) = delete;
         AudioManager(AudioManager &&) = delete;
@@ -38,6 +39,7 @@ namespace engine::resource
         };
 
         MIX_Mixer *_mixer = nullptr;
+        bool _mixer_initialized = false;
         std::unordered_map<std::string, std::unique_ptr<MIX_Audio, SDLAudioDeleter>> _audios;
         std::unordered_map<std::string, std::unique_ptr<MIX_Audio, SDLAudioDeleter>> _musics;
 
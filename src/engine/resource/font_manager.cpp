@@ -3,10 +3,13 @@
 #include <stdexcept>
 engine::resource::FontManager::FontManager()
 {
-    if (!TTF_WasInit() && !TTF_Init())
+    if (!TTF_WasInit())
     {
-        /* code */
-        throw std::runtime_error("FontManager init failed");
+        if (!TTF_Init())
+        {
+            throw std::runtime_error("FontManager init failed");
+        }
+        _owns_ttf = true;
     }
     spdlog::info("FontManager init successfully");
 }
@@ -18,7 +21,10 @@ engine::resource::FontManager::~FontManager()
         spdlog::info("FontManager not empty, dmynically clear fonts");
         clearFonts();
     }
-    TTF_Quit();
+    if (_owns_ttf)
+    {
+        TTF_Quit();
+    }
     spdlog::info("FontManager quit successfully");
 }
 
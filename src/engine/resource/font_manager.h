@@ -47,6 +47,8 @@ namespace engine::resource
 
         SDL_Renderer *_renderer = nullptr;
         std::unordered_map<FontKey, std::unique_ptr<TTF_Font, SDLFontDeleter>, FontKeyHash> _fonts;
+        /// @brief TTF由本对象初始化时才在析构时退出
+        bool _owns_ttf = false;
 
         TTF_Font *loadFont(const std::string &file_path, int font_size);
         void unloadFont(const std::string &file_path, int font_size);
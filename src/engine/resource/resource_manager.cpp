@@ -7,10 +7,10 @@
 #include "texture_manager.h"
 #include "audio_manager.h"
 #include "font_manager.h"
-engine::resource::ResourceManager::ResourceManager(SDL_Renderer *renderer)
+engine::resource::ResourceManager::ResourceManager(SDL_Renderer *renderer, bool enable_audio)
 {
     _texture_manager = std::make_unique<TextureManager>(renderer);
-    _audio_manager = std::make_unique<AudioManager>();
+    _audio_manager = std::make_unique<AudioManager>(enable_audio);
     _font_manager = std::make_unique<FontManager>();
 
     spdlog::info("ResourceManager init successfully");
@@ -50,6 +50,36 @@ glm::vec2 engine::resource::ResourceManager::getTextureSize(const std::string &f
 {
     return _texture_manager->getTextureSize(file_path);
 }
+engine::resource::TextureRegion engine::resource::ResourceManager::getTextureRegion(const std::string &file_path)
+{
+    return _texture_manager->getTextureRegion(file_path);
+}
+
+engine::resource::TextureHandle engine::resource::ResourceManager::getTextureHandle(const std::string &file_path)
+{
+    return _texture_manager->getTextureHandle(file_path);
+}
+
+const engine::resource::TextureRegion *engine::resource::ResourceManager::resolveTexture(const TextureHandle &handle) const
+{
+    return _texture_manager->resolveTexture(handle);
+}
+
+size_t engine::resource::ResourceManager::packLoadedTextures()
+{
+    return _texture_manager->packLoadedTextures();
+}
+
+size_t engine::resource::ResourceManager::getAtlasCount() const
+{
+    return _texture_manager->getAtlasCount();
+}
+
+void engine::resource::ResourceManager::excludeFromAtlas(const std::string &file_path)
+{
+    _texture_manager->excludeFromAtlas(file_path);
+}
+
 void engine::resource::ResourceManager::clearTextures()
 {
     _texture_manager->clearTextures();
@@ -2,6 +2,8 @@
 #include <string>
 #include <memory>
 #include <glm/glm.hpp>
+#include <SDL3/SDL_rect.h>
+#include "texture_handle.h"
 
 struct SDL_Renderer;
 struct SDL_Texture;
@@ -15,6 +17,13 @@ namespace engine::resource
     class AudioManager;
     class FontManager;
 
+    /// @brief 纹理ID实际对应的纹理和区域,打包进图集后指向图集中的子矩形
+    struct TextureRegion
+    {
+        SDL_Texture *texture{nullptr};
+        SDL_Rect rect{0, 0, 0, 0};
+    };
+
     /// @brief 资源管理器中央控制器
     class ResourceManager
     {
@@ -24,7 +33,9 @@ namespace engine::resource
         std::unique_ptr<FontManager> _font_manager{nullptr};
 
     public:
-        explicit ResourceManager(SDL_Renderer *renderer);
+        /// @param renderer 纹理所属的渲染器
+        /// @param enable_audio 为false时不打开音频设备,用于无头运行
+        explicit ResourceManager(SDL_Renderer *renderer, bool enable_audio = true);
 
         ~ResourceManager();
         ResourceManager(const ResourceManager &) = delete;
@@ -41,6 +52,19 @@ namespace engine::resource
         SDL_Texture *getTexture(const std::string &file_path);
         void unloadTexture(const std::string &file_path);
         glm::vec2 getTextureSize(const std::string &file_path);
+        /// @brief 获取纹理ID对应的纹理和区域,未加载时自动加载
+        TextureRegion getTextureRegion(const std::string &file_path);
+        /// @brief 获取纹理ID对应的句柄,未加载时自动加载;同一ID总是返回同一槽位
+        TextureHandle getTextureHandle(const std::string &file_path);
+        /// @brief 按句柄取纹理区域,不做字符串查找
+        /// @return 句柄无效或纹理已卸载时返回nullptr
+        const TextureRegion *resolveTexture(const TextureHandle &handle) const;
+        /// @brief 把上次打包后新加载的独立小纹理打包进图集(优先放进已有页面),之后原纹理ID透明地映射到图集区域
+        /// @return 打包的纹理数
+        size_t packLoadedTextures();
+        size_t getAtlasCount() const;
+        /// @brief 该纹理始终保持独立,不参与图集打包
+        void excludeFromAtlas(const std::string &file_path);
         void clearTextures();
 
         //=====Sound=====
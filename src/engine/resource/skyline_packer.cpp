@@ -0,0 +1,116 @@
+#include "skyline_packer.h"
+#include <algorithm>
+#include <limits>
+
+engine::resource::SkylinePacker::SkylinePacker(const glm::ivec2 &size)
+    : _size(size)
+{
+    reset();
+}
+
+void engine::resource::SkylinePacker::reset()
+{
+    _skyline.clear();
+    _skyline.push_back(Node{0, 0, _size.x});
+    _used_height = 0;
+}
+
+void engine::resource::SkylinePacker::limitHeight(int height)
+{
+    _size.y = std::min(_size.y, std::max(height, _used_height));
+}
+
+std::optional<glm::ivec2> engine::resource::SkylinePacker::insert(const glm::ivec2 &rect_size)
+{
+    if (rect_size.x <= 0 || rect_size.y <= 0)
+    {
+        return std::nullopt;
+    }
+    size_t best_index = _skyline.size();
+    int best_bottom = std::numeric_limits<int>::max();
+    int best_width = std::numeric_limits<int>::max();
+    int best_y = 0;
+    for (size_t i = 0; i < _skyline.size(); ++i)
+    {
+        auto y = fit(i, rect_size);
+        if (!y.has_value())
+        {
+            continue;
+        }
+        const int bottom = y.value() + rect_size.y;
+        if (bottom < best_bottom || (bottom == best_bottom && _skyline[i].width < best_width))
+        {
+            best_index = i;
+            best_bottom = bottom;
+            best_width = _skyline[i].width;
+            best_y = y.value();
+        }
+    }
+    if (best_index == _skyline.size())
+    {
+        return std::nullopt;
+    }
+    const glm::ivec2 position(_skyline[best_index].x, best_y);
+    addNode(best_index, position, rect_size);
+    _used_height = std::max(_used_height, best_bottom);
+    return position;
+}
+
+std::optional<int> engine::resource::SkylinePacker::fit(size_t index, const glm::ivec2 &rect_size) const
+{
+    const int x = _skyline[index].x;
+    if (x + rect_size.x > _size.x)
+    {
+        return std::nullopt;
+    }
+    // 矩形跨过的所有线段中最高的一段决定放置高度
+    int y = 0;
+    int remaining = rect_size.x;
+    for (size_t i = index; remaining > 0; ++i)
+    {
+        y = std::max(y, _skyline[i].y);
+        if (y + rect_size.y > _size.y)
+        {
+            return std::nullopt;
+        }
+        remaining -= _skyline[i].width;
+    }
+    return y;
+}
+
+void engine::resource::SkylinePacker::addNode(size_t index, const glm::ivec2 &position, const glm::ivec2 &rect_size)
+{
+    _skyline.insert(_skyline.begin() + index, Node{position.x, position.y + rect_size.y, rect_size.x});
+
+    // 截掉被新线段覆盖的部分
+    const int right = position.x + rect_size.x;
+    for (size_t i = index + 1; i < _skyline.size();)
+    {
+        Node &node = _skyline[i];
+        if (node.x >= right)
+        {
+            break;
+        }
+        const int shrink = right - node.x;
+        if (node.width <= shrink)
+        {
+            _skyline.erase(_skyline.begin() + i);
+            continue;
+        }
+        node.x += shrink;
+        node.width -= shrink;
+        break;
+    }
+
+    // 合并高度相同的相邻线段
+    for (size_t i = 0; i + 1 < _skyline.size();)
+    {
+        if (_skyline[i].y == _skyline[i + 1].y)
+        {
+            _skyline[i].width += _skyline[i + 1].width;
+            _skyline.erase(_skyline.begin() + i + 1);
+            continue;
+        }
+        ++i;
+    }
+}
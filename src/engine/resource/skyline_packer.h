@@ -0,0 +1,49 @@
+#pragma once
+#include <glm/vec2.hpp>
+#include <optional>
+#include <vector>
+
+namespace engine::resource
+{
+    /**
+     * @brief 天际线矩形装箱
+     *
+     * 记录已放置矩形的上轮廓(天际线),每个新矩形放在使其底边最低的位置,
+     * 同样高度时选择较窄的线段。按高度降序插入时空间利用率较好。
+     */
+    class SkylinePacker final
+    {
+    private:
+        /// @brief 天际线上的一段水平线
+        struct Node
+        {
+            int x;
+            int y;
+            int width;
+        };
+
+        glm::ivec2 _size;
+        std::vector<Node> _skyline;
+        /// @brief 已使用的最大高度
+        int _used_height{0};
+
+    public:
+        explicit SkylinePacker(const glm::ivec2 &size);
+
+        /// @brief 放置一个矩形
+        /// @return 左上角位置,放不下时返回std::nullopt
+        std::optional<glm::ivec2> insert(const glm::ivec2 &rect_size);
+        /// @brief 清空所有已放置的矩形
+        void reset();
+        /// @brief 缩小可放置的高度,已放置的矩形不受影响
+        void limitHeight(int height);
+
+        const glm::ivec2 &getSize() const { return _size; }
+        int getUsedHeight() const { return _used_height; }
+
+    private:
+        /// @brief 矩形左边对齐第index段时的放置高度,越界返回std::nullopt
+        std::optional<int> fit(size_t index, const glm::ivec2 &rect_size) const;
+        void addNode(size_t index, const glm::ivec2 &position, const glm::ivec2 &rect_size);
+    };
+}
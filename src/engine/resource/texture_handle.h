@@ -0,0 +1,16 @@
+#pragma once
+#include <cstdint>
+
+namespace engine::resource
+{
+    /// @brief 纹理槽位的句柄,按下标直接访问;纹理卸载后槽位代数增加,旧句柄随之失效
+    struct TextureHandle
+    {
+        static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+        uint32_t index{INVALID_INDEX};
+        uint32_t generation{0};
+
+        bool isValid() const { return index != INVALID_INDEX; }
+    };
+}
@@ -1,8 +1,37 @@
 #include "texture_manager.h"
+#include "skyline_packer.h"
 #include <SDL3_image/SDL_image.h>
 #include <spdlog/spdlog.h>
+#include <algorithm>
 #include <stdexcept>
 
+namespace
+{
+    /// @brief 把source复制到atlas的position处,并向四周各复制padding宽的边缘像素
+    void blitWithPadding(SDL_Surface *source, SDL_Surface *atlas, const glm::ivec2 &position, int padding)
+    {
+        const int w = source->w;
+        const int h = source->h;
+        SDL_Rect dest = {position.x, position.y, w, h};
+        SDL_BlitSurface(source, nullptr, atlas, &dest);
+        for (int i = 1; i <= padding; ++i)
+        {
+            SDL_Rect left_src = {0, 0, 1, h};
+            SDL_Rect left_dest = {position.x - i, position.y, 1, h};
+            SDL_BlitSurface(source, &left_src, atlas, &left_dest);
+            SDL_Rect right_src = {w - 1, 0, 1, h};
+            SDL_Rect right_dest = {position.x + w - 1 + i, position.y, 1, h};
+            SDL_BlitSurface(source, &right_src, atlas, &right_dest);
+            SDL_Rect top_src = {0, 0, w, 1};
+            SDL_Rect top_dest = {position.x, position.y - i, w, 1};
+            SDL_BlitSurface(source, &top_src, atlas, &top_dest);
+            SDL_Rect bottom_src = {0, h - 1, w, 1};
+            SDL_Rect bottom_dest = {position.x, position.y + h - 1 + i, w, 1};
+            SDL_BlitSurface(source, &bottom_src, atlas, &bottom_dest);
+        }
+    }
+}
+
 engine::resource::TextureManager::TextureManager(SDL_Renderer *renderer)
     : _renderer(renderer)
 {
@@ -20,7 +49,19 @@ SDL_Texture *engine::resource::TextureManager::loadTexture(const std::string &fi
     {
         return it->second.get();
     }
-    SDL_Texture *raw_texture = IMG_LoadTexture(_renderer, file_path.c_str());
+    if (auto region = _regions.find(file_path); region != _regions.end())
+    {
+        return region->second.texture;
+    }
+    // 自己解码再上传,可打包的小纹理保留解码结果,打包时不必从文件重新解码
+    SurfacePtr loaded(IMG_Load(file_path.c_str()));
+    SurfacePtr surface(loaded ? SDL_ConvertSurface(loaded.get(), SDL_PIXELFORMAT_RGBA32) : nullptr);
+    SDL_Texture *raw_texture = surface ? SDL_CreateTextureFromSurface(_renderer, surface.get()) : nullptr;
+    if (!raw_texture)
+    {
+        spdlog::error("Load texture failed: {} , SDL error: {}", file_path, SDL_GetError());
+        return nullptr;
+    }
 
     if (!SDL_SetTextureScaleMode(raw_texture, SDL_SCALEMODE_NEAREST))
     {
@@ -28,12 +69,10 @@ SDL_Texture *engine::resource::TextureManager::loadTexture(const std::string &fi
         spdlog::warn("Set texture scale mode failed: {}", file_path);
     }
 
-    if (!raw_texture)
+    if (!_atlas_excluded.contains(file_path) && surface->w <= MAX_ATLAS_ENTRY && surface->h <= MAX_ATLAS_ENTRY)
     {
-        spdlog::error("Load texture failed: {} , SDL error: {}", file_path, SDL_GetError());
-        return nullptr;
+        _pending_surfaces[file_path] = std::move(surface);
     }
-
     _textures.emplace(file_path, std::unique_ptr<SDL_Texture, SDLTextureDeleter>(raw_texture));
     spdlog::info("Load texture successfully: {}", file_path);
 
@@ -47,12 +86,20 @@ SDL_Texture *engine::resource::TextureManager::getTexture(const std::string &fil
     {
         return it->second.get();
     }
+    if (auto region = _regions.find(file_path); region != _regions.end())
+    {
+        return region->second.texture;
+    }
     spdlog::warn("Texture not found: {}", file_path);
     return loadTexture(file_path);
 }
 
 glm::vec2 engine::resource::TextureManager::getTextureSize(const std::string &file_path)
 {
+    if (auto region = _regions.find(file_path); region != _regions.end())
+    {
+        return glm::vec2(region->second.rect.w, region->second.rect.h);
+    }
     SDL_Texture *texture = getTexture(file_path);
     if (!texture)
     {
@@ -69,8 +116,229 @@ glm::vec2 engine::resource::TextureManager::getTextureSize(const std::string &fi
     return size;
 }
 
+engine::resource::TextureRegion engine::resource::TextureManager::getTextureRegion(const std::string &file_path)
+{
+    if (auto region = _regions.find(file_path); region != _regions.end())
+    {
+        return region->second;
+    }
+    TextureRegion region;
+    region.texture = getTexture(file_path);
+    if (!region.texture)
+    {
+        return region;
+    }
+    float w = 0.0f;
+    float h = 0.0f;
+    if (!SDL_GetTextureSize(region.texture, &w, &h))
+    {
+        spdlog::error("Get texture size failed: {}", file_path);
+        return TextureRegion{};
+    }
+    region.rect = SDL_Rect{0, 0, static_cast<int>(w), static_cast<int>(h)};
+    return region;
+}
+
+size_t engine::resource::TextureManager::packLoadedTextures()
+{
+    struct Entry
+    {
+        std::string file_path;
+        SDL_Surface *surface;
+        /// @brief 已有页面的下标,新页面从_atlases.size()开始编号
+        size_t page{0};
+        glm::ivec2 position{0, 0};
+    };
+    std::vector<Entry> entries;
+    for (const auto &[file_path, surface] : _pending_surfaces)
+    {
+        if (_textures.contains(file_path))
+        {
+            entries.push_back(Entry{file_path, surface.get()});
+        }
+    }
+    // 没有可以共享的页面时,单个纹理打包没有意义,留到下次
+    if (entries.empty() || (entries.size() < 2 && _atlases.empty()))
+    {
+        return 0;
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b)
+              { return a.surface->h != b.surface->h ? a.surface->h > b.surface->h : a.surface->w > b.surface->w; });
+
+    // 先确定每个纹理的页和位置:优先放进已有页面的空隙,再按实际用到的高度创建新页面
+    std::vector<SkylinePacker> packers;
+    for (auto &entry : entries)
+    {
+        const glm::ivec2 padded = glm::ivec2(entry.surface->w, entry.surface->h) + glm::ivec2(ATLAS_PADDING * 2);
+        std::optional<glm::ivec2> position;
+        for (size_t page = 0; page < _atlases.size() && !position.has_value(); ++page)
+        {
+            position = _atlases[page].packer.insert(padded);
+            entry.page = page;
+        }
+        if (!position.has_value())
+        {
+            position = packers.empty() ? std::nullopt : packers.back().insert(padded);
+            if (!position.has_value())
+            {
+                packers.emplace_back(glm::ivec2(ATLAS_SIZE, ATLAS_SIZE));
+                position = packers.back().insert(padded);
+            }
+            entry.page = _atlases.size() + packers.size() - 1;
+        }
+        entry.position = position.value() + glm::ivec2(ATLAS_PADDING);
+    }
+
+    const size_t first_page = _atlases.size();
+    for (auto &packer : packers)
+    {
+        SurfacePtr atlas_surface(SDL_CreateSurface(ATLAS_SIZE, packer.getUsedHeight(), SDL_PIXELFORMAT_RGBA32));
+        SDL_Texture *atlas = atlas_surface ? SDL_CreateTexture(_renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, ATLAS_SIZE, packer.getUsedHeight()) : nullptr;
+        if (!atlas)
+        {
+            // 放不进已创建页面的纹理保持独立,仍留在待打包列表中
+            spdlog::error("Create atlas page failed: {}", SDL_GetError());
+            break;
+        }
+        SDL_SetTextureScaleMode(atlas, SDL_SCALEMODE_NEAREST);
+        SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND);
+        const size_t page = _atlases.size();
+        for (const auto &entry : entries)
+        {
+            if (entry.page == page)
+            {
+                SDL_SetSurfaceBlendMode(entry.surface, SDL_BLENDMODE_NONE);
+                blitWithPadding(entry.surface, atlas_surface.get(), entry.position, ATLAS_PADDING);
+            }
+        }
+        SDL_UpdateTexture(atlas, nullptr, atlas_surface->pixels, atlas_surface->pitch);
+        // 页面只有已用的高度,之后只能往其中的空隙放置
+        packer.limitHeight(packer.getUsedHeight());
+        _atlases.push_back(AtlasPage{std::unique_ptr<SDL_Texture, SDLTextureDeleter>(atlas), std::move(packer)});
+    }
+
+    size_t packed = 0;
+    for (const auto &entry : entries)
+    {
+        if (entry.page >= _atlases.size())
+        {
+            continue;
+        }
+        AtlasPage &page = _atlases[entry.page];
+        const glm::ivec2 size(entry.surface->w, entry.surface->h);
+        if (entry.page < first_page)
+        {
+            // 放进已有页面的空隙:单独拼出带边缘的小块再上传
+            const glm::ivec2 padded = size + glm::ivec2(ATLAS_PADDING * 2);
+            SurfacePtr piece(SDL_CreateSurface(padded.x, padded.y, SDL_PIXELFORMAT_RGBA32));
+            if (!piece)
+            {
+                spdlog::warn("Texture kept out of atlas: {}, {}", entry.file_path, SDL_GetError());
+                continue;
+            }
+            SDL_SetSurfaceBlendMode(entry.surface, SDL_BLENDMODE_NONE);
+            blitWithPadding(entry.surface, piece.get(), glm::ivec2(ATLAS_PADDING), ATLAS_PADDING);
+            const SDL_Rect dest{entry.position.x - ATLAS_PADDING, entry.position.y - ATLAS_PADDING, padded.x, padded.y};
+            SDL_UpdateTexture(page.texture.get(), &dest, piece->pixels, piece->pitch);
+        }
+        const TextureRegion region{page.texture.get(), SDL_Rect{entry.position.x, entry.position.y, size.x, size.y}};
+        ++page.entries;
+        _regions[entry.file_path] = region;
+        _textures.erase(entry.file_path);
+        // 纹理ID不变,已发出的句柄继续有效并指向图集区域
+        if (auto slot = _slot_indices.find(entry.file_path); slot != _slot_indices.end() && _slots[slot->second].resolved)
+        {
+            _slots[slot->second].region = region;
+        }
+        ++packed;
+    }
+    // 最后才释放解码结果,entries中的指针在此之前一直有效
+    for (const auto &entry : entries)
+    {
+        if (!_textures.contains(entry.file_path))
+        {
+            _pending_surfaces.erase(entry.file_path);
+        }
+    }
+    spdlog::info("Packed {} textures, {} new atlas pages, {} pages in total", packed, _atlases.size() - first_page, _atlases.size());
+    return packed;
+}
+
+engine::resource::TextureHandle engine::resource::TextureManager::getTextureHandle(const std::string &file_path)
+{
+    auto [it, inserted] = _slot_indices.try_emplace(file_path, static_cast<uint32_t>(_slots.size()));
+    if (inserted)
+    {
+        _slots.emplace_back();
+    }
+    TextureSlot &slot = _slots[it->second];
+    if (!slot.resolved)
+    {
+        slot.region = getTextureRegion(file_path);
+        slot.resolved = true;
+        if (!slot.region.texture)
+        {
+            spdlog::error("Texture handle resolved to missing texture: {}", file_path);
+        }
+    }
+    return TextureHandle{it->second, slot.generation};
+}
+
+const engine::resource::TextureRegion *engine::resource::TextureManager::resolveTexture(const TextureHandle &handle) const
+{
+    if (handle.index >= _slots.size())
+    {
+        return nullptr;
+    }
+    const TextureSlot &slot = _slots[handle.index];
+    if (!slot.resolved || slot.generation != handle.generation)
+    {
+        return nullptr;
+    }
+    return &slot.region;
+}
+
+void engine::resource::TextureManager::invalidateSlot(const std::string &file_path)
+{
+    if (auto it = _slot_indices.find(file_path); it != _slot_indices.end())
+    {
+        TextureSlot &slot = _slots[it->second];
+        ++slot.generation;
+        slot.region = TextureRegion{};
+        slot.resolved = false;
+    }
+}
+
+void engine::resource::TextureManager::releaseAtlasEntry(SDL_Texture *atlas)
+{
+    auto page = std::find_if(_atlases.begin(), _atlases.end(), [atlas](const AtlasPage &p)
+                             { return p.texture.get() == atlas; });
+    if (page != _atlases.end() && --page->entries == 0)
+    {
+        spdlog::info("Release empty atlas page, {} pages left", _atlases.size() - 1);
+        _atlases.erase(page);
+    }
+}
+
+void engine::resource::TextureManager::excludeFromAtlas(const std::string &file_path)
+{
+    _atlas_excluded.insert(file_path);
+    _pending_surfaces.erase(file_path);
+}
+
 void engine::resource::TextureManager::unloadTexture(const std::string &file_path)
 {
+    invalidateSlot(file_path);
+    _pending_surfaces.erase(file_path);
+    // 图集页由多个纹理共享,最后一个映射移除时才释放页面
+    if (auto region = _regions.find(file_path); region != _regions.end())
+    {
+        SDL_Texture *atlas = region->second.texture;
+        _regions.erase(region);
+        releaseAtlasEntry(atlas);
+        spdlog::info("Unload atlas texture: {}", file_path);
+        return;
+    }
     auto it = _textures.find(file_path);
     if (it != _textures.end())
     {
@@ -85,10 +353,22 @@ void engine::resource::TextureManager::unloadTexture(const std::string &file_pat
 
 void engine::resource::TextureManager::clearTextures()
 {
-    if (!_textures.empty())
+    if (!_textures.empty() || !_regions.empty())
     {
         /* code */
-        spdlog::info("Clear {} textures", _textures.size());
+        spdlog::info("Clear {} textures, {} atlas entries", _textures.size(), _regions.size());
         _textures.clear();
+        _regions.clear();
+        _atlases.clear();
+    }
+    _pending_surfaces.clear();
+    for (auto &slot : _slots)
+    {
+        if (slot.resolved)
+        {
+            ++slot.generation;
+            slot.region = TextureRegion{};
+            slot.resolved = false;
+        }
     }
 }
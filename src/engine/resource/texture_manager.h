@@ -3,8 +3,12 @@
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include <SDL3/SDL_render.h>
 #include <glm/glm.hpp>
+#include "resource_manager.h"
+#include "skyline_packer.h"
 
 namespace engine::resource
 {
@@ -14,6 +18,13 @@ namespace engine::resource
         friend class ResourceManager;
 
     public:
+        /// @brief 图集页的边长
+        static constexpr int ATLAS_SIZE = 2048;
+        /// @brief 宽或高超过该值的纹理(背景等)不打包
+        static constexpr int MAX_ATLAS_ENTRY = 512;
+        /// @brief 图集中每个纹理四周复制边缘像素的宽度,避免缩放采样时混入相邻纹理
+        static constexpr int ATLAS_PADDING = 1;
+
         explicit TextureManager(SDL_Renderer *renderer);
         TextureManager(const TextureManager &) = delete;
         TextureManager &operator=(const TextureManager &) = delete;
@@ -30,8 +41,46 @@ namespace engine::resource
             }
         };
 
+        struct SDLSurfaceDeleter
+        {
+            void operator()(SDL_Surface *surface) const
+            {
+                SDL_DestroySurface(surface);
+            }
+        };
+        using SurfacePtr = std::unique_ptr<SDL_Surface, SDLSurfaceDeleter>;
+
+        /// @brief 图集页,页面按创建时已用的高度分配,之后的纹理只能放进其中剩余的空隙
+        struct AtlasPage
+        {
+            std::unique_ptr<SDL_Texture, SDLTextureDeleter> texture;
+            SkylinePacker packer;
+            /// @brief 仍映射到该页的纹理数,归零时释放页面
+            size_t entries{0};
+        };
+
         /// @brief 存储文件路径和指向管理纹理贴图的指针
         std::unordered_map<std::string, std::unique_ptr<SDL_Texture, SDLTextureDeleter>> _textures;
+        /// @brief 等待打包的小纹理解码后的像素,打包后释放
+        std::unordered_map<std::string, SurfacePtr> _pending_surfaces;
+        /// @brief 图集页
+        std::vector<AtlasPage> _atlases;
+        /// @brief 已打包进图集的纹理ID到图集区域的映射
+        std::unordered_map<std::string, TextureRegion> _regions;
+        /// @brief 需要整张纹理(如平铺寻址)而不打包的纹理ID
+        std::unordered_set<std::string> _atlas_excluded;
+
+        /// @brief 句柄指向的槽位,保存解析好的纹理区域
+        struct TextureSlot
+        {
+            TextureRegion region;
+            /// @brief 卸载时增加,使旧句柄失效
+            uint32_t generation{1};
+            bool resolved{false};
+        };
+        std::vector<TextureSlot> _slots;
+        /// @brief 纹理ID到槽位下标,槽位一经分配不再回收
+        std::unordered_map<std::string, uint32_t> _slot_indices;
 
         /// @brief 指向主SDL渲染器的非拥有指针
         SDL_Renderer *_renderer{nullptr};
@@ -55,6 +104,26 @@ namespace engine::resource
         /// @return
         glm::vec2 getTextureSize(const std::string &file_path);
 
+        /// @brief 获取纹理ID对应的纹理和区域,独立纹理的区域为整张纹理
+        TextureRegion getTextureRegion(const std::string &file_path);
+
+        /// @brief 把上次打包后新加载的小纹理按高度降序用天际线算法打包,先填已有页面的空隙,放不下时新开一页
+        /// @return 打包的纹理数,没有新纹理时为0
+        size_t packLoadedTextures();
+
+        size_t getAtlasCount() const { return _atlases.size(); }
+        void excludeFromAtlas(const std::string &file_path);
+
+        /// @brief 获取纹理ID的句柄,槽位未解析时加载纹理;加载失败也会记下,之后不再重试
+        TextureHandle getTextureHandle(const std::string &file_path);
+        /// @brief 按句柄取纹理区域
+        /// @return 句柄无效或代数不符时返回nullptr
+        const TextureRegion *resolveTexture(const TextureHandle &handle) const;
+        /// @brief 纹理被卸载后使对应槽位的句柄失效
+        void invalidateSlot(const std::string &file_path);
+        /// @brief 图集区域被移除后减少所在页面的计数,页面不再被引用时释放
+        void releaseAtlasEntry(SDL_Texture *atlas);
+
         /// @brief 清除所有纹理资源
         void clearTextures();
     };
@@ -13,11 +13,14 @@
 #include "../core/context.h"
 #include "../resource/resource_manager.h"
 #include "../render/sprite.h"
+#include "../render/render_queue.h"
 #include "../utils/math.h"
 #include "../object/game_object.h"
+#include "../object/prefab.h"
 
 #include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
+#include "../utils/log.h"
 #include <fstream>
 #include <glm/vec2.hpp>
 #include <glm/glm.hpp>
@@ -73,6 +76,9 @@ bool engine::scene::LevelLoader::loadLevel(const std::string &level_path, Scene
         return false;
     }
 
+    // 图层顺序即绘制顺序,超出范围的图层共用最后一层,仍低于运行时生成的对象
+    constexpr uint8_t max_level_layer = engine::render::RenderOrder::DEFAULT_LAYER - 1;
+    _render_layer = engine::render::RenderOrder::LEVEL_LAYER_BASE;
     for (const auto &layer_json : json_data["layers"])
     {
         std::string layer_type = layer_json.value("type", "none");
@@ -97,6 +103,11 @@ bool engine::scene::LevelLoader::loadLevel(const std::string &level_path, Scene
         else
         {
             spdlog::warn("Unknown layer type: {}", layer_type);
+            continue;
+        }
+        if (_render_layer < max_level_layer)
+        {
+            ++_render_layer;
         }
     }
     spdlog::info("Map file loaded: {}", level_path);
@@ -122,7 +133,13 @@ void engine::scene::LevelLoader::loadImageLayer(const nlohmann::json &layer_json
 
     auto game_object = std::make_unique<engine::object::GameObject>(layer_name);
     game_object->addComponent<engine::component::TransformComponent>(offset);
-    game_object->addComponent<engine::component::ParallaxComponent>(texture_id, scroll_factor, repeat);
+    if (repeat.x || repeat.y)
+    {
+        // 平铺的背景用WRAP寻址一次绘制,需要保持独立纹理
+        scene.getContext().getResourceManager().excludeFromAtlas(texture_id);
+    }
+    auto *parallax = game_object->addComponent<engine::component::ParallaxComponent>(texture_id, scroll_factor, repeat);
+    parallax->setRenderLayer(_render_layer);
     scene.addGameObject(std::move(game_object));
     spdlog::info("Image layer loaded: {}", file_path);
 }
@@ -165,6 +182,7 @@ void engine::scene::LevelLoader::loadTileLayer(const nlohmann::json &layer_json,
     auto game_object = std::make_unique<engine::object::GameObject>(layer_name);
     auto *tile_layer = game_object->addComponent<engine::component::TileLayerComponent>(_tile_size, _map_size, std::move(tiles));
     tile_layer->setOffset(offset);
+    tile_layer->setRenderLayer(_render_layer);
     scene.addGameObject(std::move(game_object));
 }
 
@@ -186,7 +204,7 @@ void engine::scene::LevelLoader::loadObjectLayer(const nlohmann::json &layer_jso
         /* code */
         auto gid = object.value("gid", 0);
         const std::string &object_name = object.value("name", "Unamed");
-        spdlog::info("Processing object: {} (gid: {})", object_name, gid);
+        ENGINE_LOG_DEBUG("Processing object: {} (gid: {})", object_name, gid);
 
         // 如果gid为0 代表绘制的形状 可能是碰撞盒 触发器
         if (gid == 0)
@@ -224,141 +242,161 @@ void engine::scene::LevelLoader::loadObjectLayer(const nlohmann::json &layer_jso
         }
         else
         {
-            auto tile_info = getTileInfoByGid(gid);
-            if (tile_info.sprite.getTextureId().empty())
+            // 同一瓦片只解析一次,之后的对象直接克隆预制体
+            const auto *prefab = getTilePrefab(gid, scene.getContext().getPrefabRegistry());
+            if (!prefab)
             {
-                spdlog::error("Failed to find tileset for gid: {}", gid);
                 continue;
             }
             auto position = glm::vec2(object.value("x", 0.0f), object.value("y", 0.0f));
             auto dst_size = glm::vec2(object.value("width", 0.0f), object.value("height", 0.0f));
 
-            spdlog::info("Object {} original position: ({}, {}), size: ({}, {})",
-                         object_name, position.x, position.y, dst_size.x, dst_size.y);
-
             // Tiled 对象的 Y 坐标是底部位置，转换为顶部位置
             position = glm::vec2(position.x, position.y - dst_size.y);
 
             auto rotation = object.value("rotation", 0.0f);
-            auto src_size_opt = tile_info.sprite.getSourceRect();
-            if (!src_size_opt)
+            const auto &src_rect = prefab->sprite->getSourceRect();
+            auto src_size = glm::vec2(src_rect->w, src_rect->h);
+            auto scale = dst_size / src_size;
+
+            // 预制体由注册表持有,延迟构造时只需按值捕获对象自身的参数
+            auto make_object = [prefab, &context = scene.getContext(), position, scale, rotation, name = object_name, render_layer = _render_layer]()
+            {
+                auto game_object = engine::object::PrefabRegistry::instantiate(*prefab, context, position, scale, rotation, name);
+                if (auto *sprite = game_object->getComponent<engine::component::SpriteComponent>(); sprite)
+                {
+                    sprite->setRenderLayer(render_layer);
+                }
+                return game_object;
+            };
+            if (_defer_objects)
             {
-                spdlog::error("Failed to find source rect for gid: {}", gid);
+                scene.queueSpawn(std::move(make_object), position + dst_size * 0.5f);
+                ENGINE_LOG_DEBUG("Object queued: {}", object_name);
                 continue;
             }
+            scene.addGameObject(make_object());
+            ENGINE_LOG_DEBUG("Object loaded: {}", object_name);
+        }
+    }
+}
 
-            auto src_size = glm::vec2(src_size_opt->w, src_size_opt->h);
-            auto scale = dst_size / src_size;
-
-            spdlog::info("Object {} adjusted position: ({}, {}), scale: ({}, {}), src_size: ({}, {})",
-                         object_name, position.x, position.y, scale.x, scale.y, src_size.x, src_size.y);
-
-            auto game_object = std::make_unique<engine::object::GameObject>(object_name);
-            game_object->addComponent<engine::component::TransformComponent>(position, scale, rotation);
-            game_object->addComponent<engine::component::SpriteComponent>(std::move(tile_info.sprite), scene.getContext().getResourceManager());
-
-            auto tile_json_opt = getTileJsonByGid(gid);
-            if (!tile_json_opt)
-                continue;
-            const auto &tile_json = tile_json_opt.value();
+const engine::object::Prefab *engine::scene::LevelLoader::getTilePrefab(int gid, engine::object::PrefabRegistry &registry)
+{
+    auto tileset_it = _tileset_data.upper_bound(gid);
+    if (tileset_it == _tileset_data.begin())
+    {
+        spdlog::error("Failed to find tileset for gid: {}", gid);
+        return nullptr;
+    }
+    --tileset_it;
+    // 以瓦片集文件和局部ID为键,不同地图引用同一瓦片集时也能复用
+    auto key = tileset_it->second.value("file_path", "") + "#" + std::to_string(gid - tileset_it->first);
+    if (const auto *prefab = registry.find(key); prefab)
+    {
+        return prefab;
+    }
 
-            if (tile_info.type == engine::component::TileType::SOLID)
-            {
-                auto collider = std::make_unique<engine::physics::AABBCollider>(src_size);
-                game_object->addComponent<engine::component::ColliderComponent>(std::move(collider));
+    auto tile_info = getTileInfoByGid(gid);
+    if (tile_info.sprite.getTextureId().empty())
+    {
+        spdlog::error("Failed to find tileset for gid: {}", gid);
+        return nullptr;
+    }
+    auto src_size_opt = tile_info.sprite.getSourceRect();
+    if (!src_size_opt)
+    {
+        spdlog::error("Failed to find source rect for gid: {}", gid);
+        return nullptr;
+    }
+    auto src_size = glm::vec2(src_size_opt->w, src_size_opt->h);
 
-                game_object->addComponent<engine::component::PhysicsComponent>(&scene.getContext().getPhysicsEngine(), false);
-                game_object->setTarget("solid");
-            }
-            else if (auto rect = getColliderRect(tile_json); rect)
-            {
-                auto collider = std::make_unique<engine::physics::AABBCollider>(rect->size);
-                auto *cc = game_object->addComponent<engine::component::ColliderComponent>(std::move(collider));
-                cc->setOffset(rect->position);
-                game_object->addComponent<engine::component::PhysicsComponent>(&scene.getContext().getPhysicsEngine(), false);
-            }
+    auto tile_json_opt = getTileJsonByGid(gid);
+    if (!tile_json_opt)
+    {
+        return nullptr;
+    }
+    const auto &tile_json = tile_json_opt.value();
 
-            auto tag = getTileProperty<std::string>(tile_json, "tag");
-            if (tag)
-            {
-                game_object->setTarget(tag.value());
-            }
-            else if (tile_info.type == engine::component::TileType::HAZARD)
-            {
-                /* code */
-                game_object->setTarget("hazard");
-            }
+    engine::object::Prefab prefab;
+    prefab.name = key;
+    prefab.sprite = std::move(tile_info.sprite);
 
-            auto gravity = getTileProperty<bool>(tile_json, "gravity");
-            if (gravity)
-            {
-                auto *pc = game_object->getComponent<engine::component::PhysicsComponent>();
-                if (pc)
-                {
-                    pc->setUseGravity(gravity.value());
-                }
-                else
-                {
-                    spdlog::warn("Object {} has no physics component", object_name);
-                    game_object->addComponent<engine::component::PhysicsComponent>(&scene.getContext().getPhysicsEngine(), gravity.value());
-                }
-            }
+    if (tile_info.type == engine::component::TileType::SOLID)
+    {
+        prefab.collider = engine::object::PrefabCollider{src_size};
+        prefab.has_physics = true;
+        prefab.tag = "solid";
+    }
+    else if (auto rect = getColliderRect(tile_json); rect)
+    {
+        prefab.collider = engine::object::PrefabCollider{rect->size, rect->position};
+        prefab.has_physics = true;
+    }
 
-            // 获取动画信息并设置
-            auto anim_string = getTileProperty<std::string>(tile_json, "animation");
-            if (anim_string)
-            {
-                nlohmann::json anim_json;
-                try
-                {
-                    anim_json = nlohmann::json::parse(anim_string.value());
-                }
-                catch (const nlohmann::json::exception &e)
-                {
-                    spdlog::error("Failed to parse animation json: {},{},{},{}", anim_string.value(), e.what(), __FILE__, __LINE__);
-                    continue;
-                }
-                auto *ac = game_object->addComponent<engine::component::AnimationComponent>();
-                addAnimation(anim_json, ac, src_size);
-            }
+    auto tag = getTileProperty<std::string>(tile_json, "tag");
+    if (tag)
+    {
+        prefab.tag = tag.value();
+    }
+    else if (tile_info.type == engine::component::TileType::HAZARD)
+    {
+        prefab.tag = "hazard";
+    }
 
-            // 获取音效信息并设置
-            auto sound_string = getTileProperty<std::string>(tile_json, "sound");
-            if (sound_string)
-            {
-                nlohmann::json sound_json;
-                try
-                {
-                    sound_json = nlohmann::json::parse(sound_string.value());
-                }
-                catch (const nlohmann::json::exception &e)
-                {
-                    spdlog::error("Failed to parse sound json: {},{},{},{}", sound_string.value(), e.what(), __FILE__, __LINE__);
-                    continue;
-                }
-                auto *ac = game_object->addComponent<engine::component::AudioComponent>(&scene.getContext().getAudioPlayer(),
-                                                                                        &scene.getContext().getCamera());
-                addSound(sound_json, ac);
-            }
+    auto gravity = getTileProperty<bool>(tile_json, "gravity");
+    if (gravity)
+    {
+        prefab.has_physics = true;
+        prefab.use_gravity = gravity.value();
+    }
 
-            // 获取生命信息并设置
-            auto health = getTileProperty<int>(tile_json, "health");
-            if (health)
-            {
-                game_object->addComponent<engine::component::HealthComponent>(health.value());
-            }
+    // 获取动画信息
+    auto anim_string = getTileProperty<std::string>(tile_json, "animation");
+    if (anim_string)
+    {
+        nlohmann::json anim_json;
+        try
+        {
+            anim_json = nlohmann::json::parse(anim_string.value());
+        }
+        catch (const nlohmann::json::exception &e)
+        {
+            spdlog::error("Failed to parse animation json: {},{},{},{}", anim_string.value(), e.what(), __FILE__, __LINE__);
+            return nullptr;
+        }
+        addAnimation(anim_json, prefab, src_size);
+    }
 
-            scene.addGameObject(std::move(game_object));
-            spdlog::info("Object loaded: {}", object_name);
+    // 获取音效信息
+    auto sound_string = getTileProperty<std::string>(tile_json, "sound");
+    if (sound_string)
+    {
+        nlohmann::json sound_json;
+        try
+        {
+            sound_json = nlohmann::json::parse(sound_string.value());
+        }
+        catch (const nlohmann::json::exception &e)
+        {
+            spdlog::error("Failed to parse sound json: {},{},{},{}", sound_string.value(), e.what(), __FILE__, __LINE__);
+            return nullptr;
         }
+        addSound(sound_json, prefab);
     }
+
+    // 获取生命信息
+    prefab.health = getTileProperty<int>(tile_json, "health");
+
+    ENGINE_LOG_DEBUG("Tile prefab created: {}", key);
+    return registry.registerPrefab(key, std::move(prefab));
 }
 
-void engine::scene::LevelLoader::addAnimation(const nlohmann::json &anim_json, engine::component::AnimationComponent *ac, const glm::vec2 &sprite_size)
+void engine::scene::LevelLoader::addAnimation(const nlohmann::json &anim_json, engine::object::Prefab &prefab, const glm::vec2 &sprite_size)
 {
-    if (!anim_json.is_object() || !ac)
+    if (!anim_json.is_object())
     {
-        spdlog::error("Invalid animation json or animation component");
+        spdlog::error("Invalid animation json");
         return;
     }
 
@@ -381,7 +419,8 @@ void engine::scene::LevelLoader::addAnimation(const nlohmann::json &anim_json, e
             continue;
         }
 
-        auto animation = std::make_unique<engine::render::Animation>(anim_name);
+        engine::object::PrefabAnimation animation;
+        animation.name = anim_name;
 
         for (const auto &frame : anim_info["frames"])
         {
@@ -394,18 +433,18 @@ void engine::scene::LevelLoader::addAnimation(const nlohmann::json &anim_json, e
             SDL_Rect src_rect =
                 {
                     column * sprite_size.x, row * sprite_size.y, sprite_size.x, sprite_size.y};
-            animation->addFrame(src_rect, duration);
+            animation.frames.push_back({src_rect, duration});
         }
 
-        ac->addAnimation(std::move(animation));
+        prefab.animations.push_back(std::move(animation));
     }
 }
 
-void engine::scene::LevelLoader::addSound(const nlohmann::json &sound_json, engine::component::AudioComponent *ac)
+void engine::scene::LevelLoader::addSound(const nlohmann::json &sound_json, engine::object::Prefab &prefab)
 {
-    if (!sound_json.is_object() || !ac)
+    if (!sound_json.is_object())
     {
-        spdlog::error("Invalid sound json or sound component");
+        spdlog::error("Invalid sound json");
         return;
     }
     for (const auto &sound : sound_json.items())
@@ -416,7 +455,7 @@ void engine::scene::LevelLoader::addSound(const nlohmann::json &sound_json, engi
         {
             continue;
         }
-        ac->addSound(sound_id, sound_path);
+        prefab.sounds.emplace_back(sound_id, sound_path);
     }
 }
 
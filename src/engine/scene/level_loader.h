@@ -1,6 +1,7 @@
 #pragma once
 #include <nlohmann/json.hpp>
 #include <glm/vec2.hpp>
+#include <cstdint>
 namespace engine::component
 {
     struct TileInfo;
@@ -12,6 +13,11 @@ namespace engine::utils
 {
     struct Rect;
 }
+namespace engine::object
+{
+    struct Prefab;
+    class PrefabRegistry;
+}
 namespace engine::scene
 {
     class Scene;
@@ -23,6 +29,10 @@ namespace engine::scene
 
         bool loadLevel(const std::string &map_path, Scene &scene);
 
+        /// @brief 对象层中由预制体生成的对象改为经场景的生成队列分帧构造,加载时不再一次性创建。
+        /// 只适合加载后不需要立即按名称查找这些对象的场景(如标题背景)
+        void setDeferObjects(bool defer) { _defer_objects = defer; }
+
         const glm::ivec2 &getMapSize() const { return _map_size; }
         const glm::ivec2 &getTileSize() const { return _tile_size; }
 
@@ -32,14 +42,24 @@ namespace engine::scene
         glm::ivec2 _tile_size;
         /// @brief 瓦片集数据
         std::map<int, nlohmann::json> _tileset_data;
+        /// @brief 当前图层的绘制层,按Tiled中的图层顺序递增
+        uint8_t _render_layer{0};
+        /// @brief 预制体对象是否经生成队列延迟构造
+        bool _defer_objects{false};
 
         void loadImageLayer(const nlohmann::json &layer_json, Scene &scene);
         void loadTileLayer(const nlohmann::json &layer_json, Scene &scene);
         void loadObjectLayer(const nlohmann::json &layer_json, Scene &scene);
 
-        void addAnimation(const nlohmann::json &anim_json, engine::component::AnimationComponent *ac, const glm::vec2 &sprite_size);
+        /// @brief 获取瓦片对应的预制体,注册表中没有时解析瓦片属性并注册
+        /// @param gid 瓦片gid
+        /// @param registry 预制体注册表
+        /// @return 预制体,解析失败返回nullptr
+        const engine::object::Prefab *getTilePrefab(int gid, engine::object::PrefabRegistry &registry);
+
+        void addAnimation(const nlohmann::json &anim_json, engine::object::Prefab &prefab, const glm::vec2 &sprite_size);
 
-        void addSound(const nlohmann::json &sound_json, engine::component::AudioComponent *ac);
+        void addSound(const nlohmann::json &sound_json, engine::object::Prefab &prefab);
 
         /// @brief 从瓦片json中获取属性
         /// @tparam T
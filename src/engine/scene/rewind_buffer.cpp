@@ -0,0 +1,318 @@
+#include "rewind_buffer.h"
+#include "../object/game_object.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <functional>
+
+namespace
+{
+    /// @brief 单帧记录的耗时预算(微秒)
+    constexpr float CAPTURE_BUDGET_US = 100.0f;
+    /// @brief 帧缓冲首次分配的槽位数
+    constexpr size_t MIN_FRAME_CAPACITY = 64;
+
+    void writeVarint(std::vector<std::byte> &out, size_t value)
+    {
+        while (value >= 0x80)
+        {
+            out.push_back(static_cast<std::byte>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<std::byte>(value));
+    }
+
+    bool readVarint(const std::vector<std::byte> &in, size_t &offset, size_t &value)
+    {
+        value = 0;
+        for (int shift = 0; offset < in.size() && shift < 64; shift += 7)
+        {
+            auto byte = static_cast<uint8_t>(in[offset++]);
+            value |= static_cast<size_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+engine::scene::RewindBuffer::RewindBuffer(float max_seconds, size_t memory_cap, size_t keyframe_interval)
+    : _max_seconds(max_seconds), _memory_cap(memory_cap), _keyframe_interval(keyframe_interval)
+{
+    spdlog::trace("RewindBuffer created: {}s, {} bytes, keyframe every {} frames", max_seconds, memory_cap, keyframe_interval);
+}
+
+std::vector<std::byte> &engine::scene::RewindBuffer::beginFrame()
+{
+    _capture_start = std::chrono::steady_clock::now();
+    _scratch_raw.clear();
+    _scratch_raw.reserve(_latest_raw.size());
+    return _scratch_raw;
+}
+
+void engine::scene::RewindBuffer::commitFrame(const ObjectList &objects, float dt)
+{
+    // 对象列表未变化且布局一致时只记录差分,否则记录关键帧
+    const bool can_delta = _frame_count > 0 && _frames_since_keyframe < _keyframe_interval &&
+                           _latest_raw.size() == _scratch_raw.size() &&
+                           _object_sets[frameAt(_frame_count - 1).object_set].objects == objects;
+    const uint32_t previous_set = can_delta ? frameAt(_frame_count - 1).object_set : 0;
+
+    Frame &frame = pushFrame();
+    frame.dt = dt;
+    frame.raw_size = static_cast<uint32_t>(_scratch_raw.size());
+    if (can_delta)
+    {
+        frame.keyframe = false;
+        frame.object_set = previous_set;
+        ++_object_sets[previous_set].frames;
+        encode(_scratch_raw, &_latest_raw, frame.payload);
+        ++_frames_since_keyframe;
+        frame.memory = frame.payload.capacity();
+    }
+    else
+    {
+        frame.keyframe = true;
+        frame.object_set = acquireObjectSet(objects);
+        encode(_scratch_raw, nullptr, frame.payload);
+        _frames_since_keyframe = 0;
+        frame.memory = frame.payload.capacity() + objects.size() * 2 * sizeof(engine::object::GameObject *);
+    }
+    _latest_raw.swap(_scratch_raw);
+
+    _memory_usage += frame.memory;
+    _recorded_seconds += frame.dt;
+
+    while (_recorded_seconds > _max_seconds || _memory_usage > _memory_cap)
+    {
+        if (!evictFront())
+        {
+            // 只剩最新的一组,下一帧起新的关键帧组,之后才能淘汰这一组
+            _frames_since_keyframe = _keyframe_interval;
+            break;
+        }
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - _capture_start;
+    _last_capture_us = std::chrono::duration<float, std::micro>(elapsed).count();
+    if (_last_capture_us > CAPTURE_BUDGET_US && !_budget_warned)
+    {
+        _budget_warned = true;
+        spdlog::warn("RewindBuffer capture took {:.1f}us ({} objects, {} bytes), over the {:.0f}us budget",
+                     _last_capture_us, objects.size(), _latest_raw.size(), CAPTURE_BUDGET_US);
+    }
+}
+
+bool engine::scene::RewindBuffer::stepBack()
+{
+    if (_frame_count < 2)
+    {
+        return false;
+    }
+    Frame &latest = frameAt(_frame_count - 1);
+    --_frame_count;
+    _memory_usage -= latest.memory;
+    _recorded_seconds -= latest.dt;
+
+    // 差分是对称的,异或回去即得到上一帧;关键帧则需要从上一个关键帧重新解码
+    if (latest.keyframe)
+    {
+        decodeFrame(_frame_count - 1, _latest_raw);
+    }
+    else
+    {
+        applyXor(latest.payload, _latest_raw);
+    }
+    releaseObjects(latest);
+
+    _frames_since_keyframe = 0;
+    for (size_t i = _frame_count; i > 0 && !frameAt(i - 1).keyframe; --i)
+    {
+        ++_frames_since_keyframe;
+    }
+    return true;
+}
+
+const engine::scene::RewindBuffer::ObjectList &engine::scene::RewindBuffer::getLatestObjects() const
+{
+    static const ObjectList empty;
+    return _frame_count == 0 ? empty : _object_sets[frameAt(_frame_count - 1).object_set].objects;
+}
+
+void engine::scene::RewindBuffer::clear()
+{
+    _frame_head = 0;
+    _frame_count = 0;
+    _free_object_sets.clear();
+    for (size_t i = 0; i < _object_sets.size(); ++i)
+    {
+        _object_sets[i].frames = 0;
+        _free_object_sets.push_back(static_cast<uint32_t>(i));
+    }
+    _latest_raw.clear();
+    _recorded_seconds = 0.0f;
+    _memory_usage = 0;
+    _frames_since_keyframe = 0;
+    _has_released_objects = true;
+}
+
+bool engine::scene::RewindBuffer::references(const engine::object::GameObject *game_object) const
+{
+    for (const auto &object_set : _object_sets)
+    {
+        if (object_set.frames > 0 && std::binary_search(object_set.sorted.begin(), object_set.sorted.end(), game_object, std::less<const engine::object::GameObject *>()))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool engine::scene::RewindBuffer::consumeReleasedObjects()
+{
+    bool released = _has_released_objects;
+    _has_released_objects = false;
+    return released;
+}
+
+engine::scene::RewindBuffer::Frame &engine::scene::RewindBuffer::pushFrame()
+{
+    if (_frame_count == _frames.size())
+    {
+        // 按时间顺序搬到新缓冲的开头
+        std::vector<Frame> frames(std::max<size_t>(MIN_FRAME_CAPACITY, _frames.size() * 2));
+        for (size_t i = 0; i < _frame_count; ++i)
+        {
+            frames[i] = std::move(frameAt(i));
+        }
+        _frames = std::move(frames);
+        _frame_head = 0;
+    }
+    Frame &frame = frameAt(_frame_count++);
+    frame.payload.clear();
+    return frame;
+}
+
+bool engine::scene::RewindBuffer::evictFront()
+{
+    // 差分帧离开关键帧就无法解码,整组淘汰;最新的一组是回退的起点,保留
+    size_t group_end = 1;
+    while (group_end < _frame_count && !frameAt(group_end).keyframe)
+    {
+        ++group_end;
+    }
+    if (group_end == _frame_count)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < group_end; ++i)
+    {
+        const Frame &oldest = frameAt(0);
+        _memory_usage -= oldest.memory;
+        _recorded_seconds -= oldest.dt;
+        releaseObjects(oldest);
+        _frame_head = (_frame_head + 1) % _frames.size();
+        --_frame_count;
+    }
+    return true;
+}
+
+uint32_t engine::scene::RewindBuffer::acquireObjectSet(const ObjectList &objects)
+{
+    uint32_t index = 0;
+    if (!_free_object_sets.empty())
+    {
+        index = _free_object_sets.back();
+        _free_object_sets.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(_object_sets.size());
+        _object_sets.emplace_back();
+    }
+    auto &object_set = _object_sets[index];
+    object_set.objects.assign(objects.begin(), objects.end());
+    object_set.sorted.assign(objects.begin(), objects.end());
+    std::sort(object_set.sorted.begin(), object_set.sorted.end(), std::less<const engine::object::GameObject *>());
+    object_set.frames = 1;
+    return index;
+}
+
+void engine::scene::RewindBuffer::releaseObjects(const Frame &frame)
+{
+    auto &object_set = _object_sets[frame.object_set];
+    if (--object_set.frames == 0)
+    {
+        _free_object_sets.push_back(frame.object_set);
+        _has_released_objects = true;
+    }
+}
+
+void engine::scene::RewindBuffer::decodeFrame(size_t index, std::vector<std::byte> &out) const
+{
+    size_t keyframe_index = index;
+    while (keyframe_index > 0 && !frameAt(keyframe_index).keyframe)
+    {
+        --keyframe_index;
+    }
+    out.assign(frameAt(keyframe_index).raw_size, std::byte{0});
+    for (size_t i = keyframe_index; i <= index; ++i)
+    {
+        applyXor(frameAt(i).payload, out);
+    }
+}
+
+void engine::scene::RewindBuffer::encode(const std::vector<std::byte> &raw, const std::vector<std::byte> *base, std::vector<std::byte> &out)
+{
+    // 格式: [零字节个数][字面量长度][字面量]...,相邻帧大部分字节不变,异或后多为零
+    const size_t size = raw.size();
+    size_t pos = 0;
+    while (pos < size)
+    {
+        size_t zero_start = pos;
+        while (pos < size && (raw[pos] ^ (base ? (*base)[pos] : std::byte{0})) == std::byte{0})
+        {
+            ++pos;
+        }
+        size_t literal_start = pos;
+        while (pos < size && (raw[pos] ^ (base ? (*base)[pos] : std::byte{0})) != std::byte{0})
+        {
+            ++pos;
+        }
+        writeVarint(out, literal_start - zero_start);
+        writeVarint(out, pos - literal_start);
+        for (size_t i = literal_start; i < pos; ++i)
+        {
+            out.push_back(raw[i] ^ (base ? (*base)[i] : std::byte{0}));
+        }
+    }
+}
+
+void engine::scene::RewindBuffer::applyXor(const std::vector<std::byte> &payload, std::vector<std::byte> &out)
+{
+    size_t offset = 0;
+    size_t pos = 0;
+    while (offset < payload.size())
+    {
+        size_t zeros = 0;
+        size_t literals = 0;
+        if (!readVarint(payload, offset, zeros) || !readVarint(payload, offset, literals))
+        {
+            spdlog::error("RewindBuffer payload is corrupted");
+            return;
+        }
+        pos += zeros;
+        if (pos + literals > out.size() || offset + literals > payload.size())
+        {
+            spdlog::error("RewindBuffer payload does not match frame size");
+            return;
+        }
+        for (size_t i = 0; i < literals; ++i)
+        {
+            out[pos + i] ^= payload[offset + i];
+        }
+        pos += literals;
+        offset += literals;
+    }
+}
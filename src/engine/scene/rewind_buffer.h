@@ -0,0 +1,127 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace engine::object
+{
+    class GameObject;
+}
+
+namespace engine::scene
+{
+    /**
+     * @brief 时间回溯用的环形帧缓冲
+     *
+     * 每帧记录场景对象列表和所有对象saveState的结果。对象列表与上一帧相同时,
+     * 只保存与上一帧按字节异或后的差分(再做零游程压缩),否则保存关键帧。
+     * 超出时长或内存上限时从最旧的关键帧组开始淘汰,但总保留最新的一组。
+     * 帧、对象列表和压缩缓冲都循环复用,预热之后记录一帧不分配堆内存。
+     * 回退一帧时用最新帧的差分异或回上一帧,不需要从关键帧重新解码。
+     */
+    class RewindBuffer final
+    {
+    public:
+        using ObjectList = std::vector<engine::object::GameObject *>;
+
+    private:
+        struct Frame
+        {
+            float dt{0.0f};
+            bool keyframe{false};
+            uint32_t raw_size{0};           ///< @brief 未压缩数据的长度
+            uint32_t object_set{0};         ///< @brief 对象列表在_object_sets中的下标,差分帧与前一帧共用
+            size_t memory{0};               ///< @brief 计入内存上限的字节数
+            std::vector<std::byte> payload; ///< @brief 压缩后的数据
+        };
+
+        /// @brief 一组关键帧及其差分帧共用的对象列表,释放后保留容量供下一个关键帧复用
+        struct ObjectSet
+        {
+            ObjectList objects;  ///< @brief 写入顺序
+            ObjectList sorted;   ///< @brief 按地址排序,用于references的二分查找
+            uint32_t frames{0};  ///< @brief 引用这份列表的帧数,为0时空闲
+        };
+
+        /// @brief 环形帧缓冲,_frame_count帧从_frame_head开始;写满时扩容。空出的槽位保留压缩缓冲的容量供新帧复用
+        std::vector<Frame> _frames;
+        size_t _frame_head{0};
+        size_t _frame_count{0};
+        std::vector<ObjectSet> _object_sets;
+        std::vector<uint32_t> _free_object_sets;
+
+        float _max_seconds;
+        size_t _memory_cap;
+        size_t _keyframe_interval;
+
+        float _recorded_seconds{0.0f};
+        size_t _memory_usage{0};
+        size_t _frames_since_keyframe{0};
+        /// @brief 最新一帧的未压缩数据,作为下一帧差分的基准
+        std::vector<std::byte> _latest_raw;
+        /// @brief 正在写入的帧的未压缩数据
+        std::vector<std::byte> _scratch_raw;
+        /// @brief 最近一次淘汰后有对象列表不再被引用
+        bool _has_released_objects{false};
+
+        std::chrono::steady_clock::time_point _capture_start;
+        float _last_capture_us{0.0f};
+        bool _budget_warned{false};
+
+    public:
+        /// @param max_seconds 保留的最长时长
+        /// @param memory_cap 压缩数据和对象列表占用的内存上限(字节)
+        /// @param keyframe_interval 连续差分帧的最大数量
+        RewindBuffer(float max_seconds, size_t memory_cap, size_t keyframe_interval = 30);
+
+        RewindBuffer(const RewindBuffer &) = delete;
+        RewindBuffer &operator=(const RewindBuffer &) = delete;
+        RewindBuffer(RewindBuffer &&) = delete;
+        RewindBuffer &operator=(RewindBuffer &&) = delete;
+
+        /// @brief 开始写入一帧,返回的缓冲区由调用者填入所有对象的状态
+        std::vector<std::byte> &beginFrame();
+        /// @brief 提交beginFrame写入的数据
+        /// @param objects 本帧的对象列表(与写入顺序一致)
+        /// @param dt 本帧时长
+        void commitFrame(const ObjectList &objects, float dt);
+
+        /// @brief 丢弃最新一帧,回到上一帧
+        /// @return 缓冲中不足两帧时返回false
+        bool stepBack();
+        /// @brief 最新一帧的对象列表和未压缩数据,stepBack后用于恢复场景
+        const ObjectList &getLatestObjects() const;
+        const std::vector<std::byte> &getLatestData() const { return _latest_raw; }
+
+        void clear();
+        /// @brief 对象是否仍被某一帧引用(被移出场景的这类对象需要保留)
+        bool references(const engine::object::GameObject *game_object) const;
+        /// @brief 取出并清除"有对象不再被引用"的标记
+        bool consumeReleasedObjects();
+
+        size_t getFrameCount() const { return _frame_count; }
+        float getRecordedSeconds() const { return _recorded_seconds; }
+        size_t getMemoryUsage() const { return _memory_usage; }
+        /// @brief 最近一帧从beginFrame到commitFrame的耗时(微秒)
+        float getLastCaptureMicros() const { return _last_capture_us; }
+
+    private:
+        Frame &frameAt(size_t index) { return _frames[(_frame_head + index) % _frames.size()]; }
+        const Frame &frameAt(size_t index) const { return _frames[(_frame_head + index) % _frames.size()]; }
+        Frame &pushFrame();
+        /// @brief 淘汰最旧的关键帧组
+        /// @return 缓冲中只剩最新的一组时不淘汰,返回false
+        bool evictFront();
+        /// @brief 取一份空闲的对象列表并填入objects
+        uint32_t acquireObjectSet(const ObjectList &objects);
+        /// @brief 帧被移除时调用,对象列表已无其他帧引用则释放
+        void releaseObjects(const Frame &frame);
+        /// @brief 从关键帧起逐帧解码,得到第index帧的未压缩数据
+        void decodeFrame(size_t index, std::vector<std::byte> &out) const;
+
+        static void encode(const std::vector<std::byte> &raw, const std::vector<std::byte> *base, std::vector<std::byte> &out);
+        /// @brief 把压缩数据异或到out上(out为全零时即为解码)
+        static void applyXor(const std::vector<std::byte> &payload, std::vector<std::byte> &out);
+    };
+}
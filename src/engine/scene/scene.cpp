@@ -3,13 +3,25 @@
 #include "scene_manager.h"
 #include "../object/game_object.h"
 #include "../render/camera.h"
+#include "../render/render.h"
 #include "../core/context.h"
 #include "../core/game_state.h"
 #include "../ui/ui_manager.h"
 #include "../physics/physics_engine.h"
+#include "../utils/binary_stream.h"
+#include "../component/transform_component.h"
+#include "rewind_buffer.h"
+#include "spawn_queue.h"
+#include "../render/animation_system.h"
+#include "../render/particle_system.h"
+#include "../component/animation_component.h"
 #include <algorithm>
+
 engine::scene::Scene::Scene(const std::string &scene_name, engine::core::Context &context, engine::scene::SceneManager &scene_manager)
-    : _scene_name(scene_name), _context(context), _scene_manager(scene_manager), _is_initialized(false), _ui_manager(std::make_unique<engine::ui::UIManager>())
+    : _scene_name(scene_name), _context(context), _scene_manager(scene_manager), _is_initialized(false), _ui_manager(std::make_unique<engine::ui::UIManager>()),
+      _spawn_queue(std::make_unique<SpawnQueue>()),
+      _animation_system(std::make_unique<engine::render::AnimationSystem>()),
+      _particle_system(std::make_unique<engine::render::ParticleSystem>())
 {
     spdlog::info("Scene {} created", _scene_name);
 }
@@ -36,24 +48,14 @@ void engine::scene::Scene::update(float dt)
     }
 
     // 更新所有游戏对象
-    for (auto it = _game_objects.begin(); it != _game_objects.end();)
-    {
-        if (*it && !(*it)->getNeedRemove())
-        {
-            (*it)->update(dt, _context);
-            ++it;
-        }
-        else
-        {
-            if (*it)
-            {
-                (*it)->clean();
-            }
-            it = _game_objects.erase(it);
-        }
-    }
+    updateAnimations(dt);
+    updateGameObjects(dt);
+    updateParticles(dt);
     _ui_manager->update(dt, _context);
     processPendingAdditions();
+    processSpawnQueue();
+    resolveTransforms();
+    recordRewindFrame(dt);
 }
 
 void engine::scene::Scene::render()
@@ -63,6 +65,17 @@ void engine::scene::Scene::render()
         /* code */
         return;
     }
+    // 世界绘制先入队,按层和深度排序后提交,同层同深度保持提交顺序(标记无序的瓦片、粒子按纹理分组);UI直接绘制在最上面
+    auto &renderer = _context.getRender();
+    // 预渲染会切换渲染目标,必须在队列开启之前完成
+    for (const auto &game_object : _game_objects)
+    {
+        if (game_object)
+        {
+            game_object->prepareRender(_context);
+        }
+    }
+    renderer.beginQueue();
     for (const auto &game_object : _game_objects)
     {
         if (game_object)
@@ -70,6 +83,8 @@ void engine::scene::Scene::render()
             game_object->render(_context);
         }
     }
+    _particle_system->render(_context);
+    renderer.submitQueue();
     _ui_manager->render(_context);
 }
 
@@ -84,20 +99,16 @@ void engine::scene::Scene::handleInput()
         return;
     }
 
-    for (auto it = _game_objects.begin(); it != _game_objects.end();)
+    // 已标记删除的对象留到update末尾统一压缩,这里只跳过
+    for (const auto &game_object : _game_objects)
     {
-        if (*it && !(*it)->getNeedRemove())
+        if (game_object && !game_object->getNeedRemove())
         {
-            (*it)->handleInput(_context);
-            ++it;
+            game_object->handleInput(_context);
         }
         else
         {
-            if (*it)
-            {
-                (*it)->clean();
-            }
-            it = _game_objects.erase(it);
+            _has_pending_removals = true;
         }
     }
 }
@@ -116,7 +127,22 @@ void engine::scene::Scene::clean()
             game_object->clean();
         }
     }
+    // 先清空登记再销毁对象,避免访问已销毁的组件
+    _animation_system->clear();
     _game_objects.clear();
+    _spawn_queue->clear();
+    _particle_system->clear();
+    if (_rewind_buffer)
+    {
+        _rewind_buffer->clear();
+    }
+    discardSnapshot();
+    _object_indices.clear();
+    _name_index.clear();
+    _tag_index.clear();
+    _hierarchy_transforms.clear();
+    _hierarchy_order_dirty = false;
+    _has_pending_removals = false;
     _is_initialized = false;
     spdlog::info("Scene {} cleaned", _scene_name);
 }
@@ -126,6 +152,7 @@ void engine::scene::Scene::addGameObject(std::unique_ptr<engine::object::GameObj
     if (game_object)
     {
         /* code */
+        registerGameObject(game_object.get(), _game_objects.size());
         _game_objects.push_back(std::move(game_object));
     }
     else
@@ -142,6 +169,11 @@ void engine::scene::Scene::safeAddGameObject(std::unique_ptr<engine::object::Gam
         spdlog::warn("{} scene add game object is nullptr", _scene_name);
 }
 
+void engine::scene::Scene::queueSpawn(std::function<std::unique_ptr<engine::object::GameObject>()> factory, const glm::vec2 &position)
+{
+    _spawn_queue->push(std::move(factory), position);
+}
+
 void engine::scene::Scene::removeGameObject(engine::object::GameObject *game_object_ptr)
 {
     if (!game_object_ptr)
@@ -150,14 +182,15 @@ void engine::scene::Scene::removeGameObject(engine::object::GameObject *game_obj
         spdlog::warn("{} scene remove game object is nullptr", _scene_name);
         return;
     }
-    auto it = std::remove_if(_game_objects.begin(), _game_objects.end(),
-                             [game_object_ptr](std::unique_ptr<engine::object::GameObject> &obj)
-                             { return obj.get() == game_object_ptr; });
-    if (it != _game_objects.end())
+    auto it = _object_indices.find(game_object_ptr);
+    if (it != _object_indices.end())
     {
         /* code */
-        (*it)->clean();
-        _game_objects.erase(it, _game_objects.end());
+        // 立即清理并销毁对象,只留下空槽位,由compactGameObjects统一回收,避免中间erase移动尾部元素
+        auto &slot = _game_objects[it->second.index];
+        unregisterGameObject(game_object_ptr);
+        retireGameObject(std::move(slot));
+        _has_pending_removals = true;
         spdlog::info("{} scene remove game object", _scene_name);
     }
     else
@@ -169,20 +202,254 @@ void engine::scene::Scene::removeGameObject(engine::object::GameObject *game_obj
 void engine::scene::Scene::safeRemoveGameObject(engine::object::GameObject *game_object_ptr)
 {
     game_object_ptr->setNeedRemove(true);
+    _has_pending_removals = true;
 }
 
 engine::object::GameObject *engine::scene::Scene::findGameObjectByName(const std::string &name) const
+{
+    // 只查找不驻留,从未出现过的名称不会污染全局表
+    auto name_id = engine::utils::SymbolTable::getInstance().find(name);
+    if (name_id == engine::utils::INVALID_SYMBOL)
+    {
+        return nullptr;
+    }
+    return findGameObjectByName(name_id);
+}
+
+engine::object::GameObject *engine::scene::Scene::findGameObjectByName(engine::utils::SymbolId name_id) const
+{
+    auto it = _name_index.find(name_id);
+    if (it == _name_index.end())
+    {
+        return nullptr;
+    }
+    // 桶内无序,按登记序号取最早加入者,保持"最早加入者优先"的查找语义
+    const auto &bucket = it->second;
+    auto first = std::min_element(bucket.sequences.begin(), bucket.sequences.end());
+    return bucket.objects[static_cast<size_t>(first - bucket.sequences.begin())];
+}
+
+const std::vector<engine::object::GameObject *> &engine::scene::Scene::findGameObjectsByName(engine::utils::SymbolId name_id) const
+{
+    static const std::vector<engine::object::GameObject *> empty;
+    auto it = _name_index.find(name_id);
+    return it != _name_index.end() ? it->second.objects : empty;
+}
+
+const std::vector<engine::object::GameObject *> &engine::scene::Scene::findGameObjectsByTag(engine::utils::SymbolId tag_id) const
+{
+    static const std::vector<engine::object::GameObject *> empty;
+    auto it = _tag_index.find(tag_id);
+    return it != _tag_index.end() ? it->second.objects : empty;
+}
+
+void engine::scene::Scene::onGameObjectRenamed(engine::object::GameObject *game_object_ptr, engine::utils::SymbolId old_name_id)
+{
+    auto it = _object_indices.find(game_object_ptr);
+    if (it == _object_indices.end())
+    {
+        spdlog::warn("{} scene game object not found", _scene_name);
+        return;
+    }
+    removeFromIndex(_name_index, old_name_id, it->second, &ObjectSlot::name_slot);
+    addToIndex(_name_index, game_object_ptr->getNameId(), game_object_ptr, it->second, &ObjectSlot::name_slot);
+}
+
+void engine::scene::Scene::onGameObjectRetagged(engine::object::GameObject *game_object_ptr, engine::utils::SymbolId old_tag_id)
+{
+    auto it = _object_indices.find(game_object_ptr);
+    if (it == _object_indices.end())
+    {
+        spdlog::warn("{} scene game object not found", _scene_name);
+        return;
+    }
+    removeFromIndex(_tag_index, old_tag_id, it->second, &ObjectSlot::tag_slot);
+    addToIndex(_tag_index, game_object_ptr->getTargetId(), game_object_ptr, it->second, &ObjectSlot::tag_slot);
+}
+
+void engine::scene::Scene::onTransformHierarchyChanged(engine::component::TransformComponent *transform)
+{
+    auto it = std::find(_hierarchy_transforms.begin(), _hierarchy_transforms.end(), transform);
+    if (transform->getParent())
+    {
+        if (it == _hierarchy_transforms.end())
+        {
+            _hierarchy_transforms.push_back(transform);
+        }
+    }
+    else if (it != _hierarchy_transforms.end())
+    {
+        _hierarchy_transforms.erase(it);
+    }
+    _hierarchy_order_dirty = true;
+}
+
+void engine::scene::Scene::onAnimationPlaybackChanged(engine::component::AnimationComponent *animation_component)
+{
+    _animation_system->sync(animation_component);
+}
+
+void engine::scene::Scene::registerGameObject(engine::object::GameObject *game_object_ptr, size_t index)
+{
+    auto &object_slot = _object_indices[game_object_ptr] = ObjectSlot{index, 0, 0, _next_object_sequence++};
+    addToIndex(_name_index, game_object_ptr->getNameId(), game_object_ptr, object_slot, &ObjectSlot::name_slot);
+    addToIndex(_tag_index, game_object_ptr->getTargetId(), game_object_ptr, object_slot, &ObjectSlot::tag_slot);
+    game_object_ptr->setScene(this);
+    auto transform = game_object_ptr->getComponent<engine::component::TransformComponent>();
+    if (transform && transform->getParent())
+    {
+        onTransformHierarchyChanged(transform);
+    }
+    if (auto animation = game_object_ptr->getComponent<engine::component::AnimationComponent>(); animation && animation->isPlaying())
+    {
+        _animation_system->sync(animation);
+    }
+}
+
+void engine::scene::Scene::unregisterGameObject(engine::object::GameObject *game_object_ptr)
+{
+    if (auto it = _object_indices.find(game_object_ptr); it != _object_indices.end())
+    {
+        removeFromIndex(_name_index, game_object_ptr->getNameId(), it->second, &ObjectSlot::name_slot);
+        removeFromIndex(_tag_index, game_object_ptr->getTargetId(), it->second, &ObjectSlot::tag_slot);
+        _object_indices.erase(it);
+    }
+    game_object_ptr->setScene(nullptr);
+    auto transform = game_object_ptr->getComponent<engine::component::TransformComponent>();
+    if (transform && std::erase(_hierarchy_transforms, transform) > 0)
+    {
+        _hierarchy_order_dirty = true;
+    }
+    if (auto animation = game_object_ptr->getComponent<engine::component::AnimationComponent>())
+    {
+        _animation_system->remove(animation);
+    }
+}
+
+void engine::scene::Scene::addToIndex(SymbolIndex &index, engine::utils::SymbolId id, engine::object::GameObject *game_object_ptr, ObjectSlot &object_slot, size_t ObjectSlot::*slot)
+{
+    if (id == engine::utils::INVALID_SYMBOL)
+    {
+        return;
+    }
+    auto &bucket = index[id];
+    object_slot.*slot = bucket.objects.size();
+    bucket.objects.push_back(game_object_ptr);
+    bucket.sequences.push_back(object_slot.sequence);
+}
+
+void engine::scene::Scene::removeFromIndex(SymbolIndex &index, engine::utils::SymbolId id, ObjectSlot &object_slot, size_t ObjectSlot::*slot)
+{
+    auto it = index.find(id);
+    if (it == index.end())
+    {
+        return;
+    }
+    auto &bucket = it->second;
+    const size_t position = object_slot.*slot;
+    // 与末尾对象交换后弹出,只需更新被移动对象记下的位置
+    if (const size_t last = bucket.objects.size() - 1; position != last)
+    {
+        bucket.objects[position] = bucket.objects[last];
+        bucket.sequences[position] = bucket.sequences[last];
+        _object_indices.find(bucket.objects[position])->second.*slot = position;
+    }
+    bucket.objects.pop_back();
+    bucket.sequences.pop_back();
+    if (bucket.objects.empty())
+    {
+        index.erase(it);
+    }
+}
+
+void engine::scene::Scene::resolveTransforms()
+{
+    if (_hierarchy_transforms.empty())
+    {
+        return;
+    }
+    if (_hierarchy_order_dirty)
+    {
+        std::stable_sort(_hierarchy_transforms.begin(), _hierarchy_transforms.end(),
+                         [](const auto *a, const auto *b)
+                         { return a->getDepth() < b->getDepth(); });
+        _hierarchy_order_dirty = false;
+    }
+    // 父变换排在前面,解析子变换时父变换已是最新,不会向上递归
+    for (auto *transform : _hierarchy_transforms)
+    {
+        transform->resolveWorldTransform();
+    }
+}
+
+std::ptrdiff_t engine::scene::Scene::indexOfGameObject(const engine::object::GameObject *game_object_ptr) const
+{
+    auto it = _object_indices.find(game_object_ptr);
+    if (it == _object_indices.end())
+    {
+        return -1;
+    }
+    return static_cast<std::ptrdiff_t>(it->second.index);
+}
+
+void engine::scene::Scene::updateAnimations(float dt)
+{
+    _animation_system->update(dt);
+}
+
+void engine::scene::Scene::updateParticles(float dt)
+{
+    _particle_system->update(dt);
+}
+
+void engine::scene::Scene::updateGameObjects(float dt)
 {
     for (const auto &game_object : _game_objects)
     {
-        /* code */
-        if (game_object && game_object->getName() == name)
+        if (!game_object || game_object->getNeedRemove())
+        {
+            _has_pending_removals = true;
+            continue;
+        }
+        game_object->update(dt, _context);
+        // 本帧update中才被标记删除的对象(如单次动画播放完毕的特效)同样留待压缩
+        if (game_object->getNeedRemove())
+        {
+            _has_pending_removals = true;
+        }
+    }
+    compactGameObjects();
+}
+
+void engine::scene::Scene::compactGameObjects()
+{
+    if (!_has_pending_removals)
+    {
+        return;
+    }
+    // 单次遍历: 读指针扫描全部对象,写指针只前移存活对象,整帧的删除只移动一次尾部
+    size_t write_index = 0;
+    for (size_t read_index = 0; read_index < _game_objects.size(); ++read_index)
+    {
+        auto &game_object = _game_objects[read_index];
+        if (!game_object || game_object->getNeedRemove())
+        {
+            if (game_object)
+            {
+                unregisterGameObject(game_object.get());
+                retireGameObject(std::move(game_object));
+            }
+            continue;
+        }
+        if (write_index != read_index)
         {
-            /* code */
-            return game_object.get();
+            _object_indices[game_object.get()].index = write_index;
+            _game_objects[write_index] = std::move(game_object);
         }
+        ++write_index;
     }
-    return nullptr;
+    _game_objects.resize(write_index);
+    _has_pending_removals = false;
 }
 
 void engine::scene::Scene::processPendingAdditions()
@@ -190,7 +457,243 @@ void engine::scene::Scene::processPendingAdditions()
     for (auto &game_object : _pending_additions)
     {
         /* code */
+        registerGameObject(game_object.get(), _game_objects.size());
         _game_objects.push_back(std::move(game_object));
     }
     _pending_additions.clear();
 }
+
+void engine::scene::Scene::processSpawnQueue()
+{
+    // 队列为空时也要处理一次,使本帧统计归零,而不是停留在最后一次生成时
+    const auto &camera = _context.getCamera();
+    _spawn_queue->process(camera.getPosition() + camera.getViewportSize() * 0.5f,
+                          [this](std::unique_ptr<engine::object::GameObject> &&game_object)
+                          { addGameObject(std::move(game_object)); });
+}
+
+void engine::scene::Scene::retireGameObject(std::unique_ptr<engine::object::GameObject> &&game_object)
+{
+    if (!game_object)
+    {
+        return;
+    }
+    if (isRetained(game_object.get()))
+    {
+        game_object->deactivate();
+        _dormant_objects.push_back(std::move(game_object));
+        return;
+    }
+    game_object->clean();
+    game_object.reset();
+}
+
+void engine::scene::Scene::captureSnapshot()
+{
+    // 新快照取代旧快照,不在新快照中的暂存对象不再需要
+    discardSnapshot();
+    processPendingAdditions();
+    compactGameObjects();
+
+    _snapshot.objects.reserve(_game_objects.size());
+    _snapshot_members.reserve(_game_objects.size());
+    engine::utils::BinaryWriter writer(_snapshot.data);
+    for (const auto &game_object : _game_objects)
+    {
+        _snapshot.objects.push_back(game_object.get());
+        _snapshot_members.insert(game_object.get());
+        game_object->saveState(writer);
+    }
+    spdlog::info("Scene {} snapshot captured: {} objects, {} bytes", _scene_name, _snapshot.objects.size(), writer.size());
+}
+
+bool engine::scene::Scene::restoreSnapshot()
+{
+    if (!hasSnapshot())
+    {
+        spdlog::warn("Scene {} has no snapshot to restore", _scene_name);
+        return false;
+    }
+    // 快照之后记录的回溯历史和排队中的生成请求随之作废
+    _spawn_queue->clear();
+    if (_rewind_buffer)
+    {
+        _rewind_buffer->clear();
+    }
+    engine::utils::BinaryReader reader(_snapshot.data);
+    if (!restoreObjects(_snapshot.objects, reader))
+    {
+        spdlog::error("Scene {} snapshot restore failed", _scene_name);
+        return false;
+    }
+    spdlog::info("Scene {} snapshot restored", _scene_name);
+    return true;
+}
+
+void engine::scene::Scene::discardSnapshot()
+{
+    _snapshot_members.clear();
+    _snapshot.objects.clear();
+    _snapshot.data.clear();
+    pruneDormantObjects();
+}
+
+void engine::scene::Scene::enableRewind(float max_seconds, size_t memory_cap)
+{
+    _rewind_buffer = std::make_unique<RewindBuffer>(max_seconds, memory_cap);
+    pruneDormantObjects();
+    spdlog::info("Scene {} rewind enabled: {}s, {} KB", _scene_name, max_seconds, memory_cap / 1024);
+}
+
+void engine::scene::Scene::disableRewind()
+{
+    _rewind_buffer.reset();
+    _rewind_objects.clear();
+    pruneDormantObjects();
+}
+
+bool engine::scene::Scene::rewindStep()
+{
+    if (!_rewind_buffer || !_rewind_buffer->stepBack())
+    {
+        return false;
+    }
+    engine::utils::BinaryReader reader(_rewind_buffer->getLatestData());
+    if (!restoreObjects(_rewind_buffer->getLatestObjects(), reader) || !loadRewindState(reader))
+    {
+        spdlog::error("Scene {} rewind failed, history dropped", _scene_name);
+        _rewind_buffer->clear();
+        pruneDormantObjects();
+        return false;
+    }
+    if (_rewind_buffer->consumeReleasedObjects())
+    {
+        pruneDormantObjects();
+    }
+    return true;
+}
+
+void engine::scene::Scene::recordRewindFrame(float dt)
+{
+    if (!_rewind_buffer)
+    {
+        return;
+    }
+    engine::utils::BinaryWriter writer(_rewind_buffer->beginFrame());
+    _rewind_objects.clear();
+    for (const auto &game_object : _game_objects)
+    {
+        if (game_object)
+        {
+            _rewind_objects.push_back(game_object.get());
+            game_object->saveState(writer);
+        }
+    }
+    saveRewindState(writer);
+    _rewind_buffer->commitFrame(_rewind_objects, dt);
+    if (_rewind_buffer->consumeReleasedObjects())
+    {
+        pruneDormantObjects();
+    }
+}
+
+bool engine::scene::Scene::isRetained(const engine::object::GameObject *game_object) const
+{
+    return _snapshot_members.contains(game_object) || (_rewind_buffer && _rewind_buffer->references(game_object));
+}
+
+void engine::scene::Scene::pruneDormantObjects()
+{
+    std::erase_if(_dormant_objects, [this](const std::unique_ptr<engine::object::GameObject> &game_object)
+                  {
+        if (isRetained(game_object.get()))
+        {
+            return false;
+        }
+        game_object->clean();
+        return true; });
+}
+
+bool engine::scene::Scene::restoreObjects(const std::vector<engine::object::GameObject *> &objects, engine::utils::BinaryReader &reader)
+{
+    // 粒子只是表现,不随快照或回溯恢复,直接清空
+    _particle_system->clear();
+    // 尚未加入的对象直接清理
+    for (auto &game_object : _pending_additions)
+    {
+        game_object->clean();
+    }
+    _pending_additions.clear();
+
+    std::unordered_map<engine::object::GameObject *, std::unique_ptr<engine::object::GameObject>> owned;
+    owned.reserve(objects.size());
+    for (auto *game_object_ptr : objects)
+    {
+        owned.emplace(game_object_ptr, nullptr);
+    }
+
+    // 暂存对象: 在目标列表中的重新激活,其余仍被引用的继续暂存
+    auto dormant_objects = std::move(_dormant_objects);
+    _dormant_objects.clear();
+    for (auto &game_object : dormant_objects)
+    {
+        if (auto it = owned.find(game_object.get()); it != owned.end())
+        {
+            game_object->reactivate();
+            it->second = std::move(game_object);
+        }
+        else if (isRetained(game_object.get()))
+        {
+            _dormant_objects.push_back(std::move(game_object));
+        }
+        else
+        {
+            game_object->clean();
+        }
+    }
+    // 现存对象: 不在目标列表中的移出场景
+    for (auto &game_object : _game_objects)
+    {
+        if (!game_object)
+        {
+            continue;
+        }
+        if (auto it = owned.find(game_object.get()); it != owned.end())
+        {
+            it->second = std::move(game_object);
+        }
+        else
+        {
+            // 完整注销: 否则层级变换列表和动画批量推进仍持有它的组件,暂存或销毁后会被继续访问
+            unregisterGameObject(game_object.get());
+            retireGameObject(std::move(game_object));
+        }
+    }
+
+    // 按目标顺序重建对象列表和索引
+    _game_objects.clear();
+    _object_indices.clear();
+    _name_index.clear();
+    _tag_index.clear();
+    _game_objects.reserve(objects.size());
+    bool success = true;
+    for (auto *game_object_ptr : objects)
+    {
+        auto &game_object = owned[game_object_ptr];
+        if (!game_object)
+        {
+            spdlog::error("Scene {} restore target object lost", _scene_name);
+            success = false;
+            continue;
+        }
+        registerGameObject(game_object_ptr, _game_objects.size());
+        _game_objects.push_back(std::move(game_object));
+        // 某个对象的数据对不上后,后续数据的位置也不可信,只重建列表不再回写状态
+        if (success && !game_object_ptr->loadState(reader))
+        {
+            success = false;
+        }
+    }
+    _has_pending_removals = true;
+    return success;
+}
@@ -2,6 +2,13 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <glm/vec2.hpp>
+#include "../utils/symbol_table.h"
 
 namespace engine::core
 {
@@ -27,9 +34,29 @@ namespace engine::object
     class GameObject;
 }
 
+namespace engine::component
+{
+    class TransformComponent;
+    class AnimationComponent;
+}
+
+namespace engine::render
+{
+    class AnimationSystem;
+    class ParticleSystem;
+}
+
+namespace engine::utils
+{
+    class BinaryWriter;
+    class BinaryReader;
+}
+
 namespace engine::scene
 {
     class SceneManager;
+    class RewindBuffer;
+    class SpawnQueue;
     /// @brief 场景基类,复制场景中的游戏对象和场景的生命周期
     class Scene
     {
@@ -43,6 +70,59 @@ namespace engine::scene
         std::vector<std::unique_ptr<engine::object::GameObject>> _game_objects;
         /// @brief 将要添加的游戏对象
         std::vector<std::unique_ptr<engine::object::GameObject>> _pending_additions;
+        /// @brief 分帧构造的生成请求
+        std::unique_ptr<SpawnQueue> _spawn_queue;
+        /// @brief 批量推进场景中正在播放的动画
+        std::unique_ptr<engine::render::AnimationSystem> _animation_system;
+        /// @brief 场景中的粒子特效,不属于任何游戏对象
+        std::unique_ptr<engine::render::ParticleSystem> _particle_system;
+        /// @brief 游戏对象在场景各索引中的位置
+        struct ObjectSlot
+        {
+            size_t index{0};     ///< @brief 在_game_objects中的下标
+            size_t name_slot{0}; ///< @brief 在名称索引桶中的位置
+            size_t tag_slot{0};  ///< @brief 在标签索引桶中的位置
+            uint64_t sequence{0}; ///< @brief 登记到场景的序号,同名对象中序号最小者优先
+        };
+        /// @brief 同一名称或标签下的游戏对象,不保证顺序,删除时与末尾交换后弹出
+        struct SymbolBucket
+        {
+            std::vector<engine::object::GameObject *> objects;
+            std::vector<uint64_t> sequences; ///< @brief 与objects一一对应的登记序号
+        };
+        using SymbolIndex = std::unordered_map<engine::utils::SymbolId, SymbolBucket>;
+
+        /// @brief 游戏对象指针到其下标和索引位置的映射,用于O(1)查找和删除
+        std::unordered_map<const engine::object::GameObject *, ObjectSlot> _object_indices;
+        /// @brief 下一个登记对象的序号
+        uint64_t _next_object_sequence{0};
+        /// @brief 本帧是否有待压缩的(已标记删除或已置空的)游戏对象
+        bool _has_pending_removals{false};
+        /// @brief 名称ID到游戏对象的索引,空名称不入索引
+        SymbolIndex _name_index;
+        /// @brief 标签ID到游戏对象的索引,空标签不入索引
+        SymbolIndex _tag_index;
+        /// @brief 有父变换的变换组件,按层级深度排序后父变换总在子变换之前;扁平场景中为空
+        std::vector<engine::component::TransformComponent *> _hierarchy_transforms;
+        /// @brief 层级关系变化后需要重新排序
+        bool _hierarchy_order_dirty{false};
+
+        /// @brief 场景快照: 快照时的对象顺序和所有对象状态的二进制数据
+        struct Snapshot
+        {
+            std::vector<engine::object::GameObject *> objects;
+            std::vector<std::byte> data;
+        };
+        Snapshot _snapshot;
+        /// @brief 快照中的对象,被移除时不销毁而是暂存到_dormant_objects
+        std::unordered_set<const engine::object::GameObject *> _snapshot_members;
+        /// @brief 已移出场景但为快照或回溯缓冲保留的对象
+        /// 快照被替换或丢弃、回溯帧被淘汰时,不再被任何一方引用的对象随即清理销毁
+        std::vector<std::unique_ptr<engine::object::GameObject>> _dormant_objects;
+        /// @brief 时间回溯缓冲,未启用时为空
+        std::unique_ptr<RewindBuffer> _rewind_buffer;
+        /// @brief 记录回溯帧时复用的对象列表
+        std::vector<engine::object::GameObject *> _rewind_objects;
 
     public:
         /// @brief
@@ -68,6 +148,13 @@ namespace engine::scene
         /// @brief 安全地添加游戏对象。（添加到pending_additions_中）
         /// @param game_object
         virtual void safeAddGameObject(std::unique_ptr<engine::object::GameObject> &&game_object);
+        /// @brief 延迟构造游戏对象: 在每帧的生成预算内按离相机由近到远调用factory并加入场景
+        /// @param factory 构造对象的回调,可能在之后若干帧才被调用
+        /// @param position 对象的大致位置,用于决定构造顺序
+        void queueSpawn(std::function<std::unique_ptr<engine::object::GameObject>()> factory, const glm::vec2 &position);
+        SpawnQueue &getSpawnQueue() const { return *_spawn_queue; }
+        engine::render::ParticleSystem &getParticleSystem() const { return *_particle_system; }
+        engine::render::AnimationSystem &getAnimationSystem() const { return *_animation_system; }
         /// @brief  移除游戏对象
         /// @param game_object
         virtual void removeGameObject(engine::object::GameObject *game_object_ptr);
@@ -78,6 +165,34 @@ namespace engine::scene
         std::vector<std::unique_ptr<engine::object::GameObject>> &getGameObjects() { return _game_objects; }
 
         engine::object::GameObject *findGameObjectByName(const std::string &name) const;
+        engine::object::GameObject *findGameObjectByName(engine::utils::SymbolId name_id) const;
+        /// @brief 获取所有同名游戏对象(顺序不保证),不存在时返回空列表
+        const std::vector<engine::object::GameObject *> &findGameObjectsByName(engine::utils::SymbolId name_id) const;
+        /// @brief 获取所有带指定标签的游戏对象(顺序不保证),不存在时返回空列表
+        const std::vector<engine::object::GameObject *> &findGameObjectsByTag(engine::utils::SymbolId tag_id) const;
+        /// @brief 查询游戏对象当前在_game_objects中的下标
+        /// @return 不存在时返回-1
+        std::ptrdiff_t indexOfGameObject(const engine::object::GameObject *game_object_ptr) const;
+
+        /// @brief 记录当前所有对象的动态状态(变换、速度、生命、AI计时器、删除标记等)
+        /// 之后被移除的快照对象会被保留,restoreSnapshot可原地恢复而无需重新加载关卡
+        void captureSnapshot();
+        /// @brief 恢复到最近一次快照: 找回被移除的对象,销毁快照后新建的对象,回写所有对象状态
+        /// @return 没有快照或恢复失败返回false
+        virtual bool restoreSnapshot();
+        bool hasSnapshot() const { return !_snapshot.objects.empty(); }
+        /// @brief 丢弃快照并销毁不再需要的暂存对象
+        void discardSnapshot();
+
+        /// @brief 启用时间回溯,之后每帧update末尾记录一帧
+        /// @param max_seconds 保留的最长时长
+        /// @param memory_cap 回溯数据的内存上限(字节)
+        void enableRewind(float max_seconds, size_t memory_cap);
+        void disableRewind();
+        /// @brief 回退一帧
+        /// @return 未启用、没有更早的帧或恢复失败时返回false
+        bool rewindStep();
+        RewindBuffer *getRewindBuffer() const { return _rewind_buffer.get(); }
 
         void setName(const std::string &name) { _scene_name = name; }
         std::string getName() const { return _scene_name; }
@@ -87,8 +202,52 @@ namespace engine::scene
         engine::core::Context &getContext() const { return _context; }
         engine::scene::SceneManager &getSceneManager() const { return _scene_manager; }
 
+        /// @brief 游戏对象名称变化时由GameObject调用,更新名称索引
+        void onGameObjectRenamed(engine::object::GameObject *game_object_ptr, engine::utils::SymbolId old_name_id);
+        /// @brief 游戏对象标签变化时由GameObject调用,更新标签索引
+        void onGameObjectRetagged(engine::object::GameObject *game_object_ptr, engine::utils::SymbolId old_tag_id);
+        /// @brief 变换组件的父变换变化时由TransformComponent调用,更新层级列表
+        void onTransformHierarchyChanged(engine::component::TransformComponent *transform);
+        /// @brief 动画开始或停止播放时由AnimationComponent调用,更新批量推进的登记
+        void onAnimationPlaybackChanged(engine::component::AnimationComponent *animation_component);
+
     protected:
+        /// @brief 登记游戏对象的下标、名称和标签索引
+        void registerGameObject(engine::object::GameObject *game_object_ptr, size_t index);
+        /// @brief 从下标、名称和标签索引中移除游戏对象
+        void unregisterGameObject(engine::object::GameObject *game_object_ptr);
+        /// @brief 将游戏对象追加到索引桶末尾,并记下其位置
+        void addToIndex(SymbolIndex &index, engine::utils::SymbolId id, engine::object::GameObject *game_object_ptr, ObjectSlot &object_slot, size_t ObjectSlot::*slot);
+        /// @brief 将游戏对象与桶末尾的对象交换后弹出,并更新被移动对象的位置
+        void removeFromIndex(SymbolIndex &index, engine::utils::SymbolId id, ObjectSlot &object_slot, size_t ObjectSlot::*slot);
+        /// @brief 批量推进所有正在播放的动画,在updateGameObjects之前调用
+        void updateAnimations(float dt);
+        /// @brief 推进所有粒子,在updateGameObjects之后调用(本帧碰撞中发射的粒子从下一帧开始移动)
+        void updateParticles(float dt);
+        /// @brief 更新所有存活的游戏对象,跳过已标记删除的对象,最后统一压缩一次
+        void updateGameObjects(float dt);
+        /// @brief 单次遍历移除所有已标记删除的对象,保持剩余对象的相对顺序(即渲染顺序)
+        void compactGameObjects();
         /// @brief 待处理的添加，每轮更新的最后调用
         void processPendingAdditions();
+        /// @brief 在预算内构造生成队列中的对象,在processPendingAdditions之后调用
+        void processSpawnQueue();
+        /// @brief 按深度顺序线性解析所有层级变换的世界变换,之后的读取都命中缓存
+        void resolveTransforms();
+        /// @brief 对象离开场景: 快照或回溯缓冲仍引用的对象暂存,其余清理后销毁
+        void retireGameObject(std::unique_ptr<engine::object::GameObject> &&game_object);
+        /// @brief 记录一帧回溯数据,启用回溯时由update末尾调用
+        void recordRewindFrame(float dt);
+        /// @brief 派生场景在回溯帧中附加的场景级状态(如分数)
+        virtual void saveRewindState(engine::utils::BinaryWriter &) const {}
+        virtual bool loadRewindState(engine::utils::BinaryReader &) { return true; }
+
+    private:
+        bool isRetained(const engine::object::GameObject *game_object) const;
+        /// @brief 销毁不再被快照和回溯缓冲引用的暂存对象
+        void pruneDormantObjects();
+        /// @brief 把场景对象恢复为给定列表(顺序一致),并从reader中回写各对象状态
+        /// 不在列表中的现存对象按retireGameObject处理,列表中的暂存对象重新激活
+        bool restoreObjects(const std::vector<engine::object::GameObject *> &objects, engine::utils::BinaryReader &reader);
     };
 }
\ No newline at end of file
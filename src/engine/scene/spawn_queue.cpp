@@ -0,0 +1,90 @@
+#include "spawn_queue.h"
+#include "../object/game_object.h"
+#include <spdlog/spdlog.h>
+#include "../utils/log.h"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace
+{
+    /// @brief 排队超过该帧数时警告一次
+    constexpr uint32_t BACKLOG_WARN_FRAMES = 60;
+}
+
+engine::scene::SpawnQueue::SpawnQueue(float budget_us)
+    : _budget_us(budget_us)
+{
+    spdlog::trace("SpawnQueue created, budget {}us per frame", budget_us);
+}
+
+void engine::scene::SpawnQueue::push(Factory factory, const glm::vec2 &position)
+{
+    if (!factory)
+    {
+        spdlog::warn("SpawnQueue push with empty factory");
+        return;
+    }
+    _requests.push_back({std::move(factory), position, _next_sequence++, _frame});
+}
+
+void engine::scene::SpawnQueue::process(const glm::vec2 &focus, const Sink &sink)
+{
+    ++_frame;
+    _stats.spawned = 0;
+    _stats.spent_us = 0.0f;
+    if (_requests.empty())
+    {
+        _stats.pending = 0;
+        _stats.oldest_wait_frames = 0;
+        _backlog_warned = false;
+        return;
+    }
+
+    // 最近的排在末尾,构造时从尾部弹出;距离相同时先入队的先构造
+    for (auto &request : _requests)
+    {
+        const glm::vec2 offset = request.position - focus;
+        request.priority = offset.x * offset.x + offset.y * offset.y;
+    }
+    std::sort(_requests.begin(), _requests.end(), [](const Request &a, const Request &b)
+              { return a.priority != b.priority ? a.priority > b.priority : a.sequence > b.sequence; });
+
+    const auto start = std::chrono::steady_clock::now();
+    do
+    {
+        auto request = std::move(_requests.back());
+        _requests.pop_back();
+        if (auto game_object = request.factory())
+        {
+            sink(std::move(game_object));
+            ++_stats.spawned;
+        }
+        _stats.spent_us = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+    } while (!_requests.empty() && _stats.spent_us < _budget_us);
+
+    _stats.total_spawned += _stats.spawned;
+    _stats.pending = _requests.size();
+    uint64_t oldest_frame = _frame;
+    for (const auto &request : _requests)
+    {
+        oldest_frame = std::min(oldest_frame, request.queued_frame);
+    }
+    _stats.oldest_wait_frames = static_cast<uint32_t>(std::min<uint64_t>(_frame - oldest_frame, std::numeric_limits<uint32_t>::max()));
+
+    ENGINE_LOG_TRACE("SpawnQueue spawned {} in {:.1f}us, {} pending", _stats.spawned, _stats.spent_us, _stats.pending);
+    if (_stats.oldest_wait_frames > BACKLOG_WARN_FRAMES && !_backlog_warned)
+    {
+        _backlog_warned = true;
+        spdlog::warn("SpawnQueue is {} frames behind with {} pending requests (budget {}us)",
+                     _stats.oldest_wait_frames, _stats.pending, _budget_us);
+    }
+}
+
+void engine::scene::SpawnQueue::clear()
+{
+    _requests.clear();
+    _stats.pending = 0;
+    _stats.oldest_wait_frames = 0;
+    _backlog_warned = false;
+}
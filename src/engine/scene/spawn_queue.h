@@ -0,0 +1,81 @@
+#pragma once
+#include <glm/vec2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace engine::object
+{
+    class GameObject;
+}
+
+namespace engine::scene
+{
+    /**
+     * @brief 带每帧时间预算的延迟构造队列
+     *
+     * 大批量生成对象时,构造(添加组件、加载资源)不再集中在同一帧完成,
+     * 而是每帧在预算内按离关注点(通常是相机中心)由近到远依次构造,其余留到后续帧。
+     * 每帧至少构造一个对象,保证队列总能推进。
+     */
+    class SpawnQueue final
+    {
+    public:
+        /// @brief 构造对象的回调,返回nullptr表示放弃生成
+        using Factory = std::function<std::unique_ptr<engine::object::GameObject>()>;
+        /// @brief 构造完成的对象交给场景
+        using Sink = std::function<void(std::unique_ptr<engine::object::GameObject> &&)>;
+
+        /// @brief 最近一帧的处理情况,用于性能分析
+        struct Stats
+        {
+            size_t pending{0};              ///< @brief 处理后仍在排队的数量
+            size_t spawned{0};              ///< @brief 本帧构造的数量
+            float spent_us{0.0f};           ///< @brief 本帧构造耗时(微秒)
+            uint32_t oldest_wait_frames{0}; ///< @brief 排队最久的请求已等待的帧数
+            size_t total_spawned{0};        ///< @brief 累计构造的数量
+        };
+
+    private:
+        struct Request
+        {
+            Factory factory;
+            glm::vec2 position;
+            uint64_t sequence;
+            uint64_t queued_frame;
+            float priority{0.0f};
+        };
+
+        std::vector<Request> _requests;
+        float _budget_us;
+        uint64_t _next_sequence{0};
+        uint64_t _frame{0};
+        Stats _stats;
+        bool _backlog_warned{false};
+
+    public:
+        /// @param budget_us 每帧用于构造对象的时间预算(微秒)
+        explicit SpawnQueue(float budget_us = 1000.0f);
+
+        SpawnQueue(const SpawnQueue &) = delete;
+        SpawnQueue &operator=(const SpawnQueue &) = delete;
+        SpawnQueue(SpawnQueue &&) = delete;
+        SpawnQueue &operator=(SpawnQueue &&) = delete;
+
+        /// @brief 排队一个生成请求
+        /// @param position 对象的大致位置,用于按距离排序
+        void push(Factory factory, const glm::vec2 &position);
+        /// @brief 在预算内构造离focus最近的请求,构造结果交给sink
+        void process(const glm::vec2 &focus, const Sink &sink);
+        /// @brief 放弃所有未构造的请求
+        void clear();
+
+        void setBudget(float budget_us) { _budget_us = budget_us; }
+        float getBudget() const { return _budget_us; }
+        size_t size() const { return _requests.size(); }
+        bool empty() const { return _requests.empty(); }
+        const Stats &getStats() const { return _stats; }
+    };
+}
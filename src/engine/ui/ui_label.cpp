@@ -24,9 +24,10 @@ void engine::ui::UILabel::render(engine::core::Context &context)
     UIElement::render(context);
 }
 
-void engine::ui::UILabel::setText(const std::string &text)
+void engine::ui::UILabel::setText(std::string_view text)
 {
-    _text = text;
+    // assign复用已有容量,频繁更新的文本不会重复分配
+    _text.assign(text);
     _size = _text_renderer.getTextSize(_text, _font_id, _font_size);
 }
 
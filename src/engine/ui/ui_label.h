@@ -3,6 +3,7 @@
 #include "../utils/math.h"
 #include "../render/text_renderer.h"
 #include <string>
+#include <string_view>
 
 namespace engine::ui
 {
@@ -30,7 +31,7 @@ namespace engine::ui
         int getFontSize() const { return _font_size; }
         const engine::utils::FColor &getTextFColor() const { return _text_fcolor; }
 
-        void setText(const std::string &text);      ///< @brief 设置文本内容, 同时更新尺寸
+        void setText(std::string_view text);        ///< @brief 设置文本内容, 同时更新尺寸
         void setFontId(const std::string &font_id); ///< @brief 设置字体ID, 同时更新尺寸
         void setFontSize(int font_size);            ///< @brief 设置字体大小, 同时更新尺寸
         void setTextFColor(engine::utils::FColor text_fcolor);
@@ -0,0 +1,80 @@
+#include "ui_stats_overlay.h"
+#include "ui_panel.h"
+#include "ui_label.h"
+#include "../render/text_renderer.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <iterator>
+
+engine::ui::UIStatsOverlay::UIStatsOverlay(engine::render::TextRenderer &text_renderer, const std::string &font_id, int font_size, const glm::vec2 &viewport_size)
+    : UIElement({0.0f, 0.0f}, viewport_size)
+{
+    auto panel = std::make_unique<UIPanel>(glm::vec2{0.0f, 0.0f}, glm::vec2{0.0f, 0.0f}, engine::utils::FColor{0.0f, 0.0f, 0.0f, 0.6f});
+    _panel = panel.get();
+    for (size_t i = 0; i < LINE_COUNT; ++i)
+    {
+        auto label = std::make_unique<UILabel>(text_renderer, "-", font_id, font_size);
+        _lines[i] = label.get();
+        panel->addChild(std::move(label));
+    }
+    addChild(std::move(panel));
+    layout();
+}
+
+void engine::ui::UIStatsOverlay::setStats(const engine::render::RenderStats &stats, float frame_seconds, const engine::scene::SpawnQueue::Stats &spawn_stats)
+{
+    if (!_visible)
+    {
+        return;
+    }
+    _accumulated_seconds += frame_seconds;
+    ++_accumulated_frames;
+    _refresh_timer += frame_seconds;
+    if (_refresh_timer < REFRESH_INTERVAL && _accumulated_frames > 1)
+    {
+        return;
+    }
+
+    const float average_ms = _accumulated_seconds * 1000.0f / static_cast<float>(_accumulated_frames);
+    const float fps = average_ms > 0.0f ? 1000.0f / average_ms : 0.0f;
+    _refresh_timer = 0.0f;
+    _accumulated_seconds = 0.0f;
+    _accumulated_frames = 0;
+
+    _buffer.clear();
+    fmt::format_to(std::back_inserter(_buffer), "FPS {:.1f}  frame {:.2f}ms", fps, average_ms);
+    setLine(0);
+    _buffer.clear();
+    fmt::format_to(std::back_inserter(_buffer), "draw calls {}  tex switches {}", stats.draw_calls, stats.texture_switches);
+    setLine(1);
+    _buffer.clear();
+    fmt::format_to(std::back_inserter(_buffer), "sprites {}  culled {}", stats.sprites_submitted, stats.sprites_culled);
+    setLine(2);
+    _buffer.clear();
+    fmt::format_to(std::back_inserter(_buffer), "vertices {}  texts {}", stats.vertices, stats.text_objects);
+    setLine(3);
+    _buffer.clear();
+    fmt::format_to(std::back_inserter(_buffer), "spawn pending {}  behind {}f  {:.0f}us", spawn_stats.pending, spawn_stats.oldest_wait_frames, spawn_stats.spent_us);
+    setLine(4);
+    layout();
+}
+
+void engine::ui::UIStatsOverlay::setLine(size_t index)
+{
+    _lines[index]->setText(_buffer);
+}
+
+void engine::ui::UIStatsOverlay::layout()
+{
+    float width = 0.0f;
+    float y = PADDING;
+    for (UILabel *line : _lines)
+    {
+        line->setPosition({PADDING, y});
+        y += line->getSize().y;
+        width = std::max(width, line->getSize().x);
+    }
+    const glm::vec2 panel_size(width + PADDING * 2.0f, y + PADDING);
+    _panel->setSize(panel_size);
+    _panel->setPosition({std::max(0.0f, _size.x - panel_size.x - PADDING), PADDING});
+}
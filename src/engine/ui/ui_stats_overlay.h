@@ -0,0 +1,53 @@
+#pragma once
+#include "ui_element.h"
+#include "../render/render_stats.h"
+#include "../scene/spawn_queue.h"
+#include <array>
+#include <string>
+
+namespace engine::render
+{
+    class TextRenderer;
+}
+
+namespace engine::ui
+{
+    class UIPanel;
+    class UILabel;
+
+    /**
+     * @brief 渲染统计浮层
+     *
+     * 半透明面板加若干文字行,显示在视口右上角。文字每隔REFRESH_INTERVAL刷新一次,
+     * 帧时间取刷新间隔内的平均值;隐藏时不更新,不产生文字开销。
+     */
+    class UIStatsOverlay final : public UIElement
+    {
+    public:
+        static constexpr float REFRESH_INTERVAL = 0.25f;
+        static constexpr size_t LINE_COUNT = 5;
+        static constexpr float PADDING = 4.0f;
+
+    private:
+        UIPanel *_panel{nullptr};
+        std::array<UILabel *, LINE_COUNT> _lines{};
+        /// @brief 格式化文字时复用的缓冲
+        std::string _buffer;
+        float _refresh_timer{0.0f};
+        float _accumulated_seconds{0.0f};
+        uint32_t _accumulated_frames{0};
+
+    public:
+        /// @param viewport_size 逻辑分辨率,浮层靠其右上角放置
+        UIStatsOverlay(engine::render::TextRenderer &text_renderer, const std::string &font_id, int font_size, const glm::vec2 &viewport_size);
+
+        /// @brief 记录一帧的统计,到刷新时间时更新文字
+        /// @param frame_seconds 该帧的真实耗时(不受时间缩放影响)
+        /// @param spawn_stats 当前场景生成队列的处理情况
+        void setStats(const engine::render::RenderStats &stats, float frame_seconds, const engine::scene::SpawnQueue::Stats &spawn_stats);
+
+    private:
+        void setLine(size_t index);
+        void layout();
+    };
+}
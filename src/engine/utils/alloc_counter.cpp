@@ -0,0 +1,116 @@
+#include "alloc_counter.h"
+#include <spdlog/spdlog.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<size_t> g_heap_allocation_count{0};
+    thread_local size_t t_heap_allocation_count = 0;
+}
+
+size_t engine::utils::getHeapAllocationCount()
+{
+    return g_heap_allocation_count.load(std::memory_order_relaxed);
+}
+
+size_t engine::utils::getThreadHeapAllocationCount()
+{
+    return t_heap_allocation_count;
+}
+
+engine::utils::FrameAllocationMonitor::FrameAllocationMonitor(uint64_t warmup_frames)
+    : _warmup_frames(warmup_frames)
+{
+}
+
+void engine::utils::FrameAllocationMonitor::start()
+{
+    _frame = 0;
+    _frame_start = getThreadHeapAllocationCount();
+    _last_frame_allocations = 0;
+    _allocating_frames = 0;
+    _peak_allocations = 0;
+}
+
+size_t engine::utils::FrameAllocationMonitor::endFrame()
+{
+    const size_t now = getThreadHeapAllocationCount();
+    _last_frame_allocations = now - _frame_start;
+    if (_frame >= _warmup_frames && _last_frame_allocations > 0)
+    {
+        ++_allocating_frames;
+        if (_last_frame_allocations > _peak_allocations)
+        {
+            _peak_allocations = _last_frame_allocations;
+            spdlog::warn("Frame {} made {} heap allocations after {} warm-up frames", _frame, _last_frame_allocations, _warmup_frames);
+        }
+    }
+    ++_frame;
+    // 警告本身可能分配,重新取计数使其不计入下一帧
+    _frame_start = getThreadHeapAllocationCount();
+    return _last_frame_allocations;
+}
+
+#ifdef ENGINE_TRACK_ALLOCATIONS
+// 替换全局operator new/delete以统计堆分配次数,仅用于性能检查构建
+namespace
+{
+    void *countedAllocate(size_t size, size_t alignment)
+    {
+        g_heap_allocation_count.fetch_add(1, std::memory_order_relaxed);
+        ++t_heap_allocation_count;
+        if (size == 0)
+        {
+            size = 1;
+        }
+        void *p = nullptr;
+        if (alignment > alignof(std::max_align_t))
+        {
+            size = (size + alignment - 1) / alignment * alignment;
+#ifdef _MSC_VER
+            p = _aligned_malloc(size, alignment);
+#else
+            p = std::aligned_alloc(alignment, size);
+#endif
+        }
+        else
+        {
+            p = std::malloc(size);
+        }
+        if (!p)
+        {
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+
+    void countedFree(void *p, size_t alignment) noexcept
+    {
+#ifdef _MSC_VER
+        if (alignment > alignof(std::max_align_t))
+        {
+            _aligned_free(p);
+            return;
+        }
+#else
+        (void)alignment;
+#endif
+        std::free(p);
+    }
+}
+
+void *operator new(size_t size) { return countedAllocate(size, alignof(std::max_align_t)); }
+void *operator new[](size_t size) { return countedAllocate(size, alignof(std::max_align_t)); }
+void *operator new(size_t size, std::align_val_t alignment) { return countedAllocate(size, static_cast<size_t>(alignment)); }
+void *operator new[](size_t size, std::align_val_t alignment) { return countedAllocate(size, static_cast<size_t>(alignment)); }
+void operator delete(void *p) noexcept { countedFree(p, alignof(std::max_align_t)); }
+void operator delete[](void *p) noexcept { countedFree(p, alignof(std::max_align_t)); }
+void operator delete(void *p, size_t) noexcept { countedFree(p, alignof(std::max_align_t)); }
+void operator delete[](void *p, size_t) noexcept { countedFree(p, alignof(std::max_align_t)); }
+void operator delete(void *p, std::align_val_t alignment) noexcept { countedFree(p, static_cast<size_t>(alignment)); }
+void operator delete[](void *p, std::align_val_t alignment) noexcept { countedFree(p, static_cast<size_t>(alignment)); }
+void operator delete(void *p, size_t, std::align_val_t alignment) noexcept { countedFree(p, static_cast<size_t>(alignment)); }
+void operator delete[](void *p, size_t, std::align_val_t alignment) noexcept { countedFree(p, static_cast<size_t>(alignment)); }
+#endif
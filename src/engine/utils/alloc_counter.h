@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace engine::utils
+{
+    /// @brief 是否启用了全局堆分配计数(编译时定义 ENGINE_TRACK_ALLOCATIONS)
+#ifdef ENGINE_TRACK_ALLOCATIONS
+    inline constexpr bool ALLOCATION_TRACKING_ENABLED = true;
+#else
+    inline constexpr bool ALLOCATION_TRACKING_ENABLED = false;
+#endif
+
+    /// @brief 程序启动以来通过全局operator new进行的堆分配次数
+    /// 未启用ENGINE_TRACK_ALLOCATIONS时恒为0
+    size_t getHeapAllocationCount();
+
+    /// @brief 当前线程通过全局operator new进行的堆分配次数,不受其它线程(日志、任务、音频)干扰
+    /// 未启用ENGINE_TRACK_ALLOCATIONS时恒为0
+    size_t getThreadHeapAllocationCount();
+
+    /**
+     * @brief 逐帧统计当前线程的堆分配次数
+     *
+     * 相邻两次endFrame之间的分配都算入后一帧,在endFrame之后写出的帧统计(CSV)计入下一帧。
+     * 预热帧数之后仍出现分配时发出警告:首次出现以及单帧分配次数创新高时各警告一次。
+     */
+    class FrameAllocationMonitor final
+    {
+    public:
+        /// @brief 默认预热帧数,覆盖资源首次加载和容器首次扩容
+        static constexpr uint64_t DEFAULT_WARMUP_FRAMES = 120;
+
+    private:
+        uint64_t _warmup_frames;
+        uint64_t _frame{0};
+        size_t _frame_start{0};
+        size_t _last_frame_allocations{0};
+        /// @brief 预热后出现分配的帧数
+        uint64_t _allocating_frames{0};
+        /// @brief 预热后单帧分配次数的最大值
+        size_t _peak_allocations{0};
+
+    public:
+        explicit FrameAllocationMonitor(uint64_t warmup_frames = DEFAULT_WARMUP_FRAMES);
+
+        /// @brief 开始统计第一帧
+        void start();
+        /// @brief 结算当前帧并开始统计下一帧
+        /// @return 当前帧的分配次数
+        size_t endFrame();
+
+        size_t getLastFrameAllocations() const { return _last_frame_allocations; }
+        uint64_t getAllocatingFrames() const { return _allocating_frames; }
+        size_t getPeakAllocations() const { return _peak_allocations; }
+        uint64_t getWarmupFrames() const { return _warmup_frames; }
+    };
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace engine::utils
+{
+    /// @brief 把平凡可复制的值按内存布局追加到字节缓冲区,用于进程内快照
+    /// 数据不做字节序/版本处理,不适合持久化到文件
+    class BinaryWriter final
+    {
+    private:
+        std::vector<std::byte> &_buffer;
+
+    public:
+        explicit BinaryWriter(std::vector<std::byte> &buffer) : _buffer(buffer) {}
+
+        template <typename T>
+        void write(const T &value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "BinaryWriter only supports trivially copyable types");
+            const auto offset = _buffer.size();
+            _buffer.resize(offset + sizeof(T));
+            std::memcpy(_buffer.data() + offset, &value, sizeof(T));
+        }
+
+        /// @brief 写入32位长度和字符内容
+        void writeString(std::string_view str)
+        {
+            write(static_cast<uint32_t>(str.size()));
+            const auto offset = _buffer.size();
+            _buffer.resize(offset + str.size());
+            std::memcpy(_buffer.data() + offset, str.data(), str.size());
+        }
+
+        size_t size() const { return _buffer.size(); }
+    };
+
+    /// @brief 按写入顺序从字节缓冲区读出值,越界后进入失败状态并返回默认值
+    class BinaryReader final
+    {
+    private:
+        const std::byte *_data;
+        size_t _size;
+        size_t _offset{0};
+        bool _failed{false};
+
+    public:
+        BinaryReader(const std::byte *data, size_t size) : _data(data), _size(size) {}
+        explicit BinaryReader(const std::vector<std::byte> &buffer) : BinaryReader(buffer.data(), buffer.size()) {}
+
+        template <typename T>
+        T read()
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "BinaryReader only supports trivially copyable types");
+            T value{};
+            if (_failed || _offset + sizeof(T) > _size)
+            {
+                _failed = true;
+                return value;
+            }
+            std::memcpy(&value, _data + _offset, sizeof(T));
+            _offset += sizeof(T);
+            return value;
+        }
+
+        template <typename T>
+        void read(T &value) { value = read<T>(); }
+
+        /// @brief 读出writeString写入的字符串,返回的视图指向缓冲区,不复制
+        std::string_view readString()
+        {
+            const auto length = read<uint32_t>();
+            if (_failed || _offset + length > _size)
+            {
+                _failed = true;
+                return {};
+            }
+            std::string_view str(reinterpret_cast<const char *>(_data + _offset), length);
+            _offset += length;
+            return str;
+        }
+
+        bool failed() const { return _failed; }
+        bool atEnd() const { return _offset == _size; }
+    };
+}
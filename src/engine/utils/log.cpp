@@ -0,0 +1,178 @@
+#include "log.h"
+#include <bit>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+namespace
+{
+    /// @brief 缓冲为空时后台线程的休眠间隔
+    constexpr auto DRAIN_INTERVAL = std::chrono::milliseconds(2);
+}
+
+struct engine::utils::Log::State
+{
+    std::unique_ptr<Record[]> records;
+    size_t mask{0};
+    alignas(64) std::atomic<size_t> enqueue_position{0};
+    alignas(64) size_t dequeue_position{0};
+    std::thread worker;
+    std::atomic<bool> running{false};
+    std::atomic<bool> stopping{false};
+    std::atomic<uint32_t> frame_messages{0};
+    std::atomic<uint32_t> frame_dropped{0};
+    bool drop_warned{false};
+
+    ~State()
+    {
+        // 未调用shutdown就退出时也要回收线程
+        if (worker.joinable())
+        {
+            stopping.store(true, std::memory_order_release);
+            worker.join();
+        }
+    }
+};
+
+engine::utils::Log::State &engine::utils::Log::state()
+{
+    static State log_state;
+    return log_state;
+}
+
+size_t engine::utils::Log::drain(State &log_state)
+{
+    auto *logger = spdlog::default_logger_raw();
+    size_t count = 0;
+    for (;;)
+    {
+        auto &record = log_state.records[log_state.dequeue_position & log_state.mask];
+        if (record.sequence.load(std::memory_order_acquire) != log_state.dequeue_position + 1)
+        {
+            break;
+        }
+        logger->log(record.time, spdlog::source_loc{}, record.level, spdlog::string_view_t(record.text, record.length));
+        record.sequence.store(log_state.dequeue_position + log_state.mask + 1, std::memory_order_release);
+        ++log_state.dequeue_position;
+        ++count;
+    }
+    return count;
+}
+
+void engine::utils::Log::init(size_t capacity)
+{
+    auto &log_state = state();
+    if (log_state.running.load(std::memory_order_acquire))
+    {
+        spdlog::warn("Log is already running");
+        return;
+    }
+    if (log_state.worker.joinable())
+    {
+        log_state.worker.join();
+    }
+    capacity = std::bit_ceil(std::max<size_t>(capacity, 2));
+    log_state.records = std::make_unique<Record[]>(capacity);
+    for (size_t i = 0; i < capacity; ++i)
+    {
+        log_state.records[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    log_state.mask = capacity - 1;
+    log_state.enqueue_position.store(0, std::memory_order_relaxed);
+    log_state.dequeue_position = 0;
+    log_state.drop_warned = false;
+    log_state.stopping.store(false, std::memory_order_relaxed);
+    log_state.worker = std::thread([&log_state]()
+                                   {
+        for (;;)
+        {
+            const bool stopping = log_state.stopping.load(std::memory_order_acquire);
+            if (drain(log_state) == 0)
+            {
+                if (stopping)
+                {
+                    break;
+                }
+                std::this_thread::sleep_for(DRAIN_INTERVAL);
+            }
+        } });
+    log_state.running.store(true, std::memory_order_release);
+    spdlog::info("Log started, {} slots of {} bytes", capacity, MAX_MESSAGE_LENGTH);
+}
+
+void engine::utils::Log::shutdown()
+{
+    auto &log_state = state();
+    if (!log_state.running.exchange(false, std::memory_order_acq_rel))
+    {
+        return;
+    }
+    // 之后的调用直接走spdlog,后台线程写完剩余消息后退出
+    log_state.stopping.store(true, std::memory_order_release);
+    log_state.worker.join();
+    drain(log_state);
+    spdlog::default_logger_raw()->flush();
+}
+
+bool engine::utils::Log::isRunning()
+{
+    return state().running.load(std::memory_order_acquire);
+}
+
+engine::utils::Log::FrameStats engine::utils::Log::endFrame()
+{
+    auto &log_state = state();
+    FrameStats stats;
+    stats.messages = log_state.frame_messages.exchange(0, std::memory_order_relaxed);
+    stats.dropped = log_state.frame_dropped.exchange(0, std::memory_order_relaxed);
+    if (stats.dropped > 0 && !log_state.drop_warned)
+    {
+        log_state.drop_warned = true;
+        spdlog::warn("Log buffer full, {} messages dropped this frame", stats.dropped);
+    }
+    return stats;
+}
+
+engine::utils::Log::Record *engine::utils::Log::acquire()
+{
+    auto &log_state = state();
+    size_t position = log_state.enqueue_position.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        auto &record = log_state.records[position & log_state.mask];
+        const size_t sequence = record.sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+        if (diff == 0)
+        {
+            if (log_state.enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                record.position = position;
+                return &record;
+            }
+        }
+        else if (diff < 0)
+        {
+            // 后台线程还没取走一整圈之前的消息,缓冲已满
+            return nullptr;
+        }
+        else
+        {
+            position = log_state.enqueue_position.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void engine::utils::Log::publish(Record *record)
+{
+    record->sequence.store(record->position + 1, std::memory_order_release);
+}
+
+void engine::utils::Log::countMessage()
+{
+    state().frame_messages.fetch_add(1, std::memory_order_relaxed);
+}
+
+void engine::utils::Log::countDropped()
+{
+    state().frame_dropped.fetch_add(1, std::memory_order_relaxed);
+}
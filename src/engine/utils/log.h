@@ -0,0 +1,142 @@
+#pragma once
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+/// @brief 编译期日志级别,与spdlog::level的取值一致
+#define ENGINE_LOG_LEVEL_TRACE 0
+#define ENGINE_LOG_LEVEL_DEBUG 1
+#define ENGINE_LOG_LEVEL_INFO 2
+#define ENGINE_LOG_LEVEL_WARN 3
+#define ENGINE_LOG_LEVEL_ERROR 4
+#define ENGINE_LOG_LEVEL_OFF 6
+
+/// @brief 低于该级别的ENGINE_LOG_*调用在编译期移除,参数不会被求值
+#ifndef ENGINE_LOG_ACTIVE_LEVEL
+#ifdef NDEBUG
+#define ENGINE_LOG_ACTIVE_LEVEL ENGINE_LOG_LEVEL_INFO
+#else
+#define ENGINE_LOG_ACTIVE_LEVEL ENGINE_LOG_LEVEL_TRACE
+#endif
+#endif
+
+namespace engine::utils
+{
+    /**
+     * @brief 异步日志门面
+     *
+     * 调用线程只把消息格式化进固定大小的环形缓冲槽位(无锁,多生产者),
+     * 后台线程取出后交给spdlog默认logger写入,游戏线程不会因文件I/O阻塞。
+     * 缓冲满时丢弃新消息并计数;未调用init时退化为直接调用spdlog。
+     * 超过槽位长度的消息会被截断。
+     */
+    class Log final
+    {
+    public:
+        /// @brief 单条消息的最大长度(字节)
+        static constexpr size_t MAX_MESSAGE_LENGTH = 240;
+
+        /// @brief 一帧内的日志量
+        struct FrameStats
+        {
+            uint32_t messages{0}; ///< @brief 写入的消息数
+            uint32_t dropped{0};  ///< @brief 缓冲已满而丢弃的消息数
+        };
+
+        Log() = delete;
+
+        /// @brief 启动后台写入线程
+        /// @param capacity 环形缓冲的槽位数,向上取整为2的幂
+        static void init(size_t capacity = 4096);
+        /// @brief 写完缓冲中剩余的消息并停止后台线程
+        static void shutdown();
+        static bool isRunning();
+
+        /// @brief 返回自上次调用以来的日志量并清零,每帧调用一次
+        static FrameStats endFrame();
+
+        template <typename... Args>
+        static void write(spdlog::level::level_enum level, spdlog::format_string_t<Args...> fmt, Args &&...args)
+        {
+            if (!spdlog::should_log(level))
+            {
+                return;
+            }
+            if (!isRunning())
+            {
+                countMessage();
+                spdlog::log(level, fmt, std::forward<Args>(args)...);
+                return;
+            }
+            Record *record = acquire();
+            if (!record)
+            {
+                countDropped();
+                return;
+            }
+            record->time = spdlog::log_clock::now();
+            record->level = level;
+            auto result = fmt::format_to_n(record->text, MAX_MESSAGE_LENGTH, fmt, std::forward<Args>(args)...);
+            record->length = static_cast<uint32_t>(std::min<size_t>(result.size, MAX_MESSAGE_LENGTH));
+            publish(record);
+            countMessage();
+        }
+
+    private:
+        /// @brief 环形缓冲槽位,sequence用于生产者和后台线程之间的交接
+        struct Record
+        {
+            std::atomic<size_t> sequence{0};
+            size_t position{0};
+            spdlog::log_clock::time_point time;
+            spdlog::level::level_enum level{spdlog::level::info};
+            uint32_t length{0};
+            char text[MAX_MESSAGE_LENGTH];
+        };
+        /// @brief 缓冲和后台线程,定义在log.cpp
+        struct State;
+        static State &state();
+        /// @brief 把已发布的消息交给spdlog,只在后台线程(或停止后的调用线程)执行
+        static size_t drain(State &log_state);
+
+        /// @brief 占用一个空槽位,缓冲已满时返回nullptr
+        static Record *acquire();
+        /// @brief 标记槽位已写完,后台线程可以读取
+        static void publish(Record *record);
+        static void countMessage();
+        static void countDropped();
+    };
+}
+
+#if ENGINE_LOG_ACTIVE_LEVEL <= ENGINE_LOG_LEVEL_TRACE
+#define ENGINE_LOG_TRACE(...) ::engine::utils::Log::write(spdlog::level::trace, __VA_ARGS__)
+#else
+#define ENGINE_LOG_TRACE(...) (void)0
+#endif
+
+#if ENGINE_LOG_ACTIVE_LEVEL <= ENGINE_LOG_LEVEL_DEBUG
+#define ENGINE_LOG_DEBUG(...) ::engine::utils::Log::write(spdlog::level::debug, __VA_ARGS__)
+#else
+#define ENGINE_LOG_DEBUG(...) (void)0
+#endif
+
+#if ENGINE_LOG_ACTIVE_LEVEL <= ENGINE_LOG_LEVEL_INFO
+#define ENGINE_LOG_INFO(...) ::engine::utils::Log::write(spdlog::level::info, __VA_ARGS__)
+#else
+#define ENGINE_LOG_INFO(...) (void)0
+#endif
+
+#if ENGINE_LOG_ACTIVE_LEVEL <= ENGINE_LOG_LEVEL_WARN
+#define ENGINE_LOG_WARN(...) ::engine::utils::Log::write(spdlog::level::warn, __VA_ARGS__)
+#else
+#define ENGINE_LOG_WARN(...) (void)0
+#endif
+
+#if ENGINE_LOG_ACTIVE_LEVEL <= ENGINE_LOG_LEVEL_ERROR
+#define ENGINE_LOG_ERROR(...) ::engine::utils::Log::write(spdlog::level::err, __VA_ARGS__)
+#else
+#define ENGINE_LOG_ERROR(...) (void)0
+#endif
@@ -0,0 +1,53 @@
+#include "symbol_table.h"
+
+engine::utils::SymbolTable::SymbolTable()
+{
+    // ID 0 固定为空字符串
+    _names.emplace_back();
+    _ids.emplace(std::string(), INVALID_SYMBOL);
+}
+
+engine::utils::SymbolTable &engine::utils::SymbolTable::getInstance()
+{
+    static SymbolTable instance;
+    return instance;
+}
+
+engine::utils::SymbolId engine::utils::SymbolTable::intern(std::string_view str)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (auto it = _ids.find(str); it != _ids.end())
+    {
+        return it->second;
+    }
+    auto id = static_cast<SymbolId>(_names.size());
+    _names.emplace_back(str);
+    _ids.emplace(_names.back(), id);
+    return id;
+}
+
+engine::utils::SymbolId engine::utils::SymbolTable::find(std::string_view str) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (auto it = _ids.find(str); it != _ids.end())
+    {
+        return it->second;
+    }
+    return INVALID_SYMBOL;
+}
+
+const std::string &engine::utils::SymbolTable::getName(SymbolId id) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (id >= _names.size())
+    {
+        return _names.front();
+    }
+    return _names[id];
+}
+
+size_t engine::utils::SymbolTable::size() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _names.size();
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace engine::utils
+{
+    /// @brief 驻留字符串的32位ID, 0 表示空字符串/无效
+    using SymbolId = std::uint32_t;
+    constexpr SymbolId INVALID_SYMBOL = 0;
+
+    /// @brief 全局字符串驻留表,把名称和标签映射为32位ID,比较和哈希只需比较整数
+    class SymbolTable final
+    {
+    private:
+        /// @brief 支持string_view异构查找的哈希
+        struct StringHash
+        {
+            using is_transparent = void;
+            size_t operator()(std::string_view str) const { return std::hash<std::string_view>{}(str); }
+        };
+
+        mutable std::mutex _mutex;
+        /// @brief 字符串到ID的映射
+        std::unordered_map<std::string, SymbolId, StringHash, std::equal_to<>> _ids;
+        /// @brief ID到字符串的映射,deque保证已驻留字符串的引用不会失效
+        std::deque<std::string> _names;
+
+        SymbolTable();
+
+    public:
+        SymbolTable(const SymbolTable &) = delete;
+        SymbolTable(SymbolTable &&) = delete;
+        SymbolTable &operator=(const SymbolTable &) = delete;
+        SymbolTable &operator=(SymbolTable &&) = delete;
+
+        static SymbolTable &getInstance();
+
+        /// @brief 驻留字符串,已存在时返回原有ID
+        SymbolId intern(std::string_view str);
+        /// @brief 只查找不驻留,不存在时返回INVALID_SYMBOL
+        SymbolId find(std::string_view str) const;
+        /// @brief 获取ID对应的字符串,无效ID返回空字符串
+        const std::string &getName(SymbolId id) const;
+        size_t size() const;
+    };
+
+    /// @brief 便捷函数,等价于SymbolTable::getInstance().intern(str)
+    inline SymbolId intern(std::string_view str) { return SymbolTable::getInstance().intern(str); }
+}
@@ -4,6 +4,11 @@ namespace game::component
 {
     class AIComponent;
 }
+namespace engine::utils
+{
+    class BinaryWriter;
+    class BinaryReader;
+}
 
 namespace game::component::ai
 {
@@ -26,6 +31,8 @@ namespace game::component::ai
     protected:
         virtual void enter(AIComponent &) {}           ///< @brief enter函数可选是否实现，默认为空
         virtual void update(float, AIComponent &) = 0; ///< @brief 更新 AI 行为逻辑(具体策略)，必须实现
+        virtual void saveState(engine::utils::BinaryWriter &) const {} ///< @brief 写入运行时状态(计时器、方向)到场景快照
+        virtual void loadState(engine::utils::BinaryReader &) {}       ///< @brief 从场景快照恢复运行时状态
     };
 
 } // namespace game::component::ai
\ No newline at end of file
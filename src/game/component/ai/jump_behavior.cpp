@@ -1,5 +1,6 @@
 #include "jump_behavior.h"
 #include "../ai_component.h"
+#include "../../../engine/utils/binary_stream.h"
 #include "../../../engine/component/animation_component.h"
 #include "../../../engine/component/physics_component.h"
 #include "../../../engine/component/transform_component.h"
@@ -74,3 +75,15 @@ void game::component::ai::JumpBehavior::update(float delta_time, AIComponent &ai
         }
     }
 }
+
+void game::component::ai::JumpBehavior::saveState(engine::utils::BinaryWriter &writer) const
+{
+    writer.write(_jump_timer);
+    writer.write(_jumping_right);
+}
+
+void game::component::ai::JumpBehavior::loadState(engine::utils::BinaryReader &reader)
+{
+    reader.read(_jump_timer);
+    reader.read(_jumping_right);
+}
@@ -1,5 +1,6 @@
 #include "patrol_behavior.h"
 #include "../ai_component.h"
+#include "../../../engine/utils/binary_stream.h"
 #include "../../../engine/component/animation_component.h"
 #include "../../../engine/component/physics_component.h"
 #include "../../../engine/component/transform_component.h"
@@ -49,3 +50,13 @@ void game::component::ai::PatrolBehavior::update(float delta_time, AIComponent &
     // 更新精灵翻转(向右移动时翻转)
     sc->setFlipped(_moving_right);
 }
+
+void game::component::ai::PatrolBehavior::saveState(engine::utils::BinaryWriter &writer) const
+{
+    writer.write(_moving_right);
+}
+
+void game::component::ai::PatrolBehavior::loadState(engine::utils::BinaryReader &reader)
+{
+    reader.read(_moving_right);
+}
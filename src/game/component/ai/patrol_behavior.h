@@ -25,6 +25,8 @@ namespace game::component::ai
     protected:
         void enter(AIComponent &ai_component) override;
         void update(float delta_time, AIComponent &ai_component) override;
+        void saveState(engine::utils::BinaryWriter &writer) const override;
+        void loadState(engine::utils::BinaryReader &reader) override;
     };
 
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "updown_behavior.h"
 #include "../ai_component.h"
+#include "../../../engine/utils/binary_stream.h"
 #include "../../../engine/component/transform_component.h"
 #include "../../../engine/component/physics_component.h"
 #include "../../../engine/component/sprite_component.h"
@@ -48,3 +49,13 @@ void game::component::ai::UpDownBehavior::update(float delta_time, AIComponent &
         _moving_down = false;
     }
 }
+
+void game::component::ai::UpDownBehavior::saveState(engine::utils::BinaryWriter &writer) const
+{
+    writer.write(_moving_down);
+}
+
+void game::component::ai::UpDownBehavior::loadState(engine::utils::BinaryReader &reader)
+{
+    reader.read(_moving_down);
+}
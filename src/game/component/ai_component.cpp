@@ -6,6 +6,7 @@
 #include "../../engine/component/health_component.h"
 #include "../../engine/component/animation_component.h"
 #include "../../engine/component/audio_component.h"
+#include "../../engine/utils/binary_stream.h"
 void game::component::AIComponent::setBehavior(std::unique_ptr<ai::AIBehavior> behavior)
 {
     _current_behavior = std::move(behavior);
@@ -52,3 +53,19 @@ void game::component::AIComponent::update(float delta_time, engine::core::Contex
         _current_behavior->update(delta_time, *this); // 委托给策略
     }
 }
+
+void game::component::AIComponent::saveState(engine::utils::BinaryWriter &writer) const
+{
+    if (_current_behavior)
+    {
+        _current_behavior->saveState(writer);
+    }
+}
+
+void game::component::AIComponent::loadState(engine::utils::BinaryReader &reader)
+{
+    if (_current_behavior)
+    {
+        _current_behavior->loadState(reader);
+    }
+}
@@ -25,6 +25,9 @@ namespace game::component
     {
         friend class engine::object::GameObject;
 
+    public:
+        static constexpr std::string_view TYPE_NAME = "AI";
+
     private:
         std::unique_ptr<ai::AIBehavior> _current_behavior = nullptr; ///< @brief 当前 AI 行为策略
 
@@ -49,6 +52,8 @@ namespace game::component
     private:
         void init() override;
         void update(float delta_time, engine::core::Context &) override;
+        void saveState(engine::utils::BinaryWriter &writer) const override;
+        void loadState(engine::utils::BinaryReader &reader) override;
     };
 
 } // namespace game::component
\ No newline at end of file
@@ -1,6 +1,10 @@
 #include "player_component.h"
 #include "state/player_state.h"
 #include "state/idle_state.h"
+#include "state/walk_state.h"
+#include "state/jump_state.h"
+#include "state/fall_state.h"
+#include "state/climb_state.h"
 #include "state/hurt_state.h"
 #include "state/dead_state.h"
 #include <spdlog/spdlog.h>
@@ -12,6 +16,7 @@
 #include "../../engine/component/health_component.h"
 #include "../../engine/input/input_manager.h"
 #include "../../engine/component/audio_component.h"
+#include "../../engine/utils/binary_stream.h"
 #include <utility>
 #include <typeinfo>
 #include <glm/glm.hpp>
@@ -38,15 +43,15 @@ void game::component::PlayerComponent::init()
         spdlog::error("PlayerComponent: component is not set.");
         return;
     }
-    _current_state = std::make_unique<game::component::state::IdleState>(this);
-    if (_current_state)
-    {
-        setState(std::move(_current_state));
-    }
-    else
-    {
-        spdlog::error("PlayerComponent: current state is not set.");
-    }
+    using state::PlayerStateId;
+    _states[static_cast<size_t>(PlayerStateId::IDLE)] = std::make_unique<state::IdleState>(this);
+    _states[static_cast<size_t>(PlayerStateId::WALK)] = std::make_unique<state::WalkState>(this);
+    _states[static_cast<size_t>(PlayerStateId::JUMP)] = std::make_unique<state::JumpState>(this);
+    _states[static_cast<size_t>(PlayerStateId::FALL)] = std::make_unique<state::FallState>(this);
+    _states[static_cast<size_t>(PlayerStateId::CLIMB)] = std::make_unique<state::ClimbState>(this);
+    _states[static_cast<size_t>(PlayerStateId::HURT)] = std::make_unique<state::HurtState>(this);
+    _states[static_cast<size_t>(PlayerStateId::DEAD)] = std::make_unique<state::DeadState>(this);
+    setState(PlayerStateId::IDLE);
 }
 
 game::component::PlayerComponent::~PlayerComponent() = default;
@@ -66,29 +71,35 @@ bool game::component::PlayerComponent::takeDamage(int damage_amount)
     if (_health_component->isAlive())
     {
         // 切换到受伤状态
-        setState(std::make_unique<state::HurtState>(this));
+        setState(state::PlayerStateId::HURT);
     }
     else
     {
         _is_dead = true;
         // 切换到死亡状态
-        setState(std::make_unique<state::DeadState>(this));
+        setState(state::PlayerStateId::DEAD);
     }
     return true;
 }
 
-void game::component::PlayerComponent::setState(std::unique_ptr<game::component::state::PlayerState> new_state)
+void game::component::PlayerComponent::setState(game::component::state::PlayerStateId state_id)
 {
+    if (state_id == state::PlayerStateId::NONE)
+    {
+        return;
+    }
+    auto *new_state = state_id < state::PlayerStateId::COUNT ? _states[static_cast<size_t>(state_id)].get() : nullptr;
     if (!new_state)
     {
-        spdlog::warn("new_state is nullptr");
+        spdlog::warn("PlayerComponent: state {} is not created", static_cast<int>(state_id));
         return;
     }
     if (_current_state)
     {
         _current_state->exit();
     }
-    _current_state = std::move(new_state);
+    _current_state = new_state;
+    _current_state_id = state_id;
     _current_state->enter();
 }
 
@@ -103,11 +114,7 @@ void game::component::PlayerComponent::handleInput(engine::core::Context &contex
     {
         return;
     }
-    auto next_state = _current_state->handleInput(context);
-    if (next_state)
-    {
-        setState(std::move(next_state));
-    }
+    setState(_current_state->handleInput(context));
 }
 
 void game::component::PlayerComponent::update(float dt, engine::core::Context &context)
@@ -146,9 +153,27 @@ void game::component::PlayerComponent::update(float dt, engine::core::Context &c
         _sprite_component->setHidden(false);
     }
 
-    auto next_state = _current_state->update(dt, context);
-    if (next_state)
-    {
-        setState(std::move(next_state));
+    setState(_current_state->update(dt, context));
+}
+
+void game::component::PlayerComponent::saveState(engine::utils::BinaryWriter &writer) const
+{
+    writer.write(_current_state_id);
+    writer.write(_is_dead);
+    writer.write(_coyote_timer);
+    writer.write(_flash_timer);
+}
+
+void game::component::PlayerComponent::loadState(engine::utils::BinaryReader &reader)
+{
+    auto state_id = reader.read<state::PlayerStateId>();
+    reader.read(_is_dead);
+    reader.read(_coyote_timer);
+    reader.read(_flash_timer);
+    // 直接切回快照时的状态,不调用exit/enter,避免重播音效;动画和物理状态由各自组件恢复
+    if (state_id > state::PlayerStateId::NONE && state_id < state::PlayerStateId::COUNT && _states[static_cast<size_t>(state_id)])
+    {
+        _current_state = _states[static_cast<size_t>(state_id)].get();
+        _current_state_id = state_id;
     }
 }
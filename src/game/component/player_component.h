@@ -1,5 +1,7 @@
 #pragma once
 #include "../../engine/component/component.h"
+#include "state/player_state.h"
+#include <array>
 #include <memory>
 
 namespace engine::input
@@ -17,17 +19,15 @@ namespace engine::component
     class AudioComponent;
 }
 
-namespace game::component::state
-{
-    class PlayerState;
-}
-
 namespace game::component
 {
     class PlayerComponent final : public engine::component::Component
     {
         friend class engine::object::GameObject;
 
+    public:
+        static constexpr std::string_view TYPE_NAME = "Player";
+
     private:
         engine::component::TransformComponent *_transform_component = nullptr;
         engine::component::PhysicsComponent *_physics_component = nullptr;
@@ -36,7 +36,10 @@ namespace game::component
         engine::component::HealthComponent *_health_component = nullptr;
         engine::component::AudioComponent *_audio_component = nullptr;
 
-        std::unique_ptr<state::PlayerState> _current_state = nullptr;
+        /// @brief 按PlayerStateId索引的状态对象,init时一次性创建,切换状态不再分配内存
+        std::array<std::unique_ptr<state::PlayerState>, static_cast<size_t>(state::PlayerStateId::COUNT)> _states;
+        state::PlayerState *_current_state = nullptr;
+        state::PlayerStateId _current_state_id = state::PlayerStateId::NONE;
         bool _is_dead = false;
 
         /// @brief 水平移动力
@@ -90,12 +93,16 @@ namespace game::component
         void setClimbSpeed(float speed) { _climb_speed = speed; }
         float getClimbSpeed() const { return _climb_speed; }
 
-        void setState(std::unique_ptr<state::PlayerState> new_state);
+        /// @brief 切换状态, NONE表示保持当前状态
+        void setState(state::PlayerStateId state_id);
+        state::PlayerStateId getStateId() const { return _current_state_id; }
         bool isOnGround() const;
 
     private:
         void init() override;
         void handleInput(engine::core::Context &context) override;
         void update(float dt, engine::core::Context &context) override;
+        void saveState(engine::utils::BinaryWriter &writer) const override;
+        void loadState(engine::utils::BinaryReader &reader) override;
     };
 }
\ No newline at end of file
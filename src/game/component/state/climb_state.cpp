@@ -1,6 +1,4 @@
 #include "climb_state.h"
-#include "jump_state.h"
-#include "fall_state.h"
 #include "../player_component.h"
 #include "../../../engine/physics/physics_engine.h"
 #include "../../../engine/core/context.h"
@@ -26,9 +24,9 @@ void game::component::state::ClimbState::exit()
     }
 }
 
-std::unique_ptr<game::component::state::PlayerState> game::component::state::ClimbState::handleInput(engine::core::Context &context)
+game::component::state::PlayerStateId game::component::state::ClimbState::handleInput(engine::core::Context &context)
 {
-    auto input_manager = context.getInputManager();
+    auto &input_manager = context.getInputManager();
     auto physics_component = _player_component->getPhysicsComponent();
     auto animation_component = _player_component->getAnimationComponent();
 
@@ -47,22 +45,22 @@ std::unique_ptr<game::component::state::PlayerState> game::component::state::Cli
 
     if (input_manager.isActionPressed("jump"))
     {
-        return std::make_unique<JumpState>(_player_component);
+        return PlayerStateId::JUMP;
     }
 
-    return nullptr;
+    return PlayerStateId::NONE;
 }
 
-std::unique_ptr<game::component::state::PlayerState> game::component::state::ClimbState::update(float dt, engine::core::Context &)
+game::component::state::PlayerStateId game::component::state::ClimbState::update(float dt, engine::core::Context &)
 {
     auto physics_component = _player_component->getPhysicsComponent();
     if (physics_component->getCollidedBelow())
     {
-        return std::make_unique<JumpState>(_player_component);
+        return PlayerStateId::JUMP;
     }
     if (!physics_component->getCollidedLoadder())
     {
-        return std::make_unique<FallState>(_player_component);
+        return PlayerStateId::FALL;
     }
-    return nullptr;
+    return PlayerStateId::NONE;
 }
@@ -29,12 +29,12 @@ void game::component::state::DeadState::exit()
 {
 }
 
-std::unique_ptr<game::component::state::PlayerState> game::component::state::DeadState::handleInput(engine::core::Context &)
+game::component::state::PlayerStateId game::component::state::DeadState::handleInput(engine::core::Context &)
 {
-    return nullptr;
+    return PlayerStateId::NONE;
 }
 
-std::unique_ptr<game::component::state::PlayerState> game::component::state::DeadState::update(float dt, engine::core::Context &)
+game::component::state::PlayerStateId game::component::state::DeadState::update(float dt, engine::core::Context &)
 {
-    return nullptr;
+    return PlayerStateId::NONE;
 }
@@ -1,8 +1,4 @@
 #include "fall_state.h"
-#include "jump_state.h"
-#include "idle_state.h"
-#include "walk_state.h"
-#include "climb_state.h"
 #include "../player_component.h"
 #include "../../../engine/physics/physics_engine.h"
 #include "../../../engine/core/context.h"
@@ -21,15 +17,15 @@ void game::component::state::FallState::exit()
 {
 }
 
-std::unique_ptr<game::component::state::PlayerState> game::component::state::FallState::handleInput(engine::core::Context &context)
+game::component::state::PlayerStateId game::component::state::FallState::handleInput(engine::core::Context &context)
 {
-    auto input_manager = context.getInputManager();
+    auto &input_manager = context.getInputManager();
     auto physics_component = _player_component->getPhysicsComponent();
     auto sprite_component = _player_component->getSpriteComponent();
 
     if (physics_component->getCollidedLoadder() && (input_manager.isActionDown("move_up") || input_manager.isActionDown("move_down")))
     {
-        return std::make_unique<ClimbState>(_player_component);
+        return PlayerStateId::CLIMB;
     }
 
     if (input_manager.isActionDown("move_left"))
@@ -50,10 +46,10 @@ std::unique_ptr<game::component::state::PlayerState> game::component::state::Fal
         physics_component->addForce({_player_component->getMoveForce(), 0.0f});
         sprite_component->setFlipped(false);
     }
-    return nullptr;
+    return PlayerStateId::NONE;
 }
 
-std::unique_ptr<game::component::state::PlayerState> game::component::state::FallState::update(float dt, engine::core::Context &)
+game::component::state::PlayerStateId game::component::state::FallState::update(float dt, engine::core::Context &)
 {
     auto physics_component = _player_component->getPhysicsComponent();
     auto max_speed = _player_component->getMoveSpeed();
@@ -64,12 +60,12 @@ std::unique_ptr<game::component::state::PlayerState> game::component::state::Fal
     {
         if (glm::abs(physics_component->_velocity.x) < 1.0f)
         {
-            return std::make_unique<IdleState>(_player_component);
+            return PlayerStateId::IDLE;
         }
         else
         {
-            return std::make_unique<WalkState>(_player_component);
+            return PlayerStateId::WALK;
         }
     }
-    return std::unique_ptr<PlayerState>();
+    return PlayerStateId::NONE;
 }
@@ -1,7 +1,4 @@
 #include "hurt_state.h"
-#include "idle_state.h"
-#include "walk_state.h"
-#include "fall_state.h"
 #include "../player_component.h"
 #include "../../../engine/physics/physics_engine.h"
 #include "../../../engine/core/context.h"
@@ -12,6 +9,8 @@
 #include "../../../engine/component/audio_component.h"
 void game::component::state::HurtState::enter()
 {
+    // 状态对象会被复用,进入时重置计时
+    _stunned_timer = 0.0f;
     playerAnimation("hurt");
 
     auto physics_component = _player_component->getPhysicsComponent();
@@ -33,12 +32,12 @@ void game::component::state::HurtState::exit()
 {
 }
 
-std::unique_ptr<game::component::state::PlayerState> game::component::state::HurtState::handleInput(engine::core::Context &)
+game::component::state::PlayerStateId game::component::state::HurtState::handleInput(engine::core::Context &)
 {
-    return nullptr;
+    return PlayerStateId::NONE;
 }
 
-std::unique_ptr<game::component::state::PlayerState> game::component::state::HurtState::update(float dt, engine::core::Context &)
+game::component::state::PlayerStateId game::component::state::HurtState::update(float dt, engine::core::Context &)
 {
     _stunned_timer += dt;
     auto physics_component = _player_component->getPhysicsComponent();
@@ -48,18 +47,18 @@ std::unique_ptr<game::component::state::PlayerState> game::component::state::Hur
         /* code */
         if (glm::abs(physics_component->_velocity.x) < 1.0f)
         {
-            return std::make_unique<IdleState>(_player_component);
+            return PlayerStateId::IDLE;
         }
         else
         {
-            return std::make_unique<WalkState>(_player_component);
+            return PlayerStateId::WALK;
         }
     }
     if (_stunned_timer > _player_component->getStunnedDuration())
     {
         _stunned_timer = 0.0f;
-        return std::make_unique<FallState>(_player_component);
+        return PlayerStateId::FALL;
     }
 
-    return nullptr;
+    return PlayerStateId::NONE;
 }
@@ -1,8 +1,4 @@
 #include "idle_state.h"
-#include "jump_state.h"
-#include "fall_state.h"
-#include "walk_state.h"
-#include "climb_state.h"
 #include "../player_component.h"
 #include "../../../engine/core/context.h"
 #include "../../../engine/input/input_manager.h"
@@ -20,36 +16,36 @@ void game::component::state::IdleState::exit()
 {
 }
 
-std::unique_ptr<game::component::state::PlayerState> game::component::state::IdleState::handleInput(engine::core::Context &context)
+game::component::state::PlayerStateId game::component::state::IdleState::handleInput(engine::core::Context &context)
 {
-    auto input_manager = context.getInputManager();
+    auto &input_manager = context.getInputManager();
     auto physics_component = _player_component->getPhysicsComponent();
     if (physics_component->getCollidedLoadder() && input_manager.isActionDown("move_up"))
     {
-        return std::make_unique<ClimbState>(_player_component);
+        return PlayerStateId::CLIMB;
     }
 
     if (physics_component->isOnTopLadder() && input_manager.isActionDown("move_down"))
     {
         _player_component->getTrasformComponent()->translate(glm::vec2(0, 2.0f));
-        return std::make_unique<ClimbState>(_player_component);
+        return PlayerStateId::CLIMB;
     }
 
     // 如果按下了左右移动,切换到行走状态
     if (input_manager.isActionDown("move_left") || input_manager.isActionDown("move_right"))
     {
-        return std::make_unique<WalkState>(_player_component);
+        return PlayerStateId::WALK;
     }
 
     // 如果按下了跳跃键,切换到跳跃状态
     if (input_manager.isActionPressed("jump"))
     {
-        return std::make_unique<JumpState>(_player_component);
+        return PlayerStateId::JUMP;
     }
-    return nullptr;
+    return PlayerStateId::NONE;
 }
 
-std::unique_ptr<game::component::state::PlayerState> game::component::state::IdleState::update(float dt, engine::core::Context &)
+game::component::state::PlayerStateId game::component::state::IdleState::update(float dt, engine::core::Context &)
 {
     auto physics_component = _player_component->getPhysicsComponent();
     auto friction_factor = _player_component->getFrictionFactor();
@@ -57,7 +53,7 @@ std::unique_ptr<game::component::state::PlayerState> game::component::state::Idl
     physics_component->_velocity.x *= friction_factor;
     if (!_player_component->isOnGround())
     {
-        return std::make_unique<FallState>(_player_component);
+        return PlayerStateId::FALL;
     }
-    return nullptr;
+    return PlayerStateId::NONE;
 }
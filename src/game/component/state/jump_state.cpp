@@ -1,6 +1,4 @@
 #include "jump_state.h"
-#include "fall_state.h"
-#include "climb_state.h"
 #include "../player_component.h"
 #include "../../../engine/physics/physics_engine.h"
 #include "../../../engine/core/context.h"
@@ -24,15 +22,15 @@ void game::component::state::JumpState::exit()
 {
 }
 
-std::unique_ptr<game::component::state::PlayerState> game::component::state::JumpState::handleInput(engine::core::Context &context)
+game::component::state::PlayerStateId game::component::state::JumpState::handleInput(engine::core::Context &context)
 {
-    auto input_manager = context.getInputManager();
+    auto &input_manager = context.getInputManager();
     auto physics_component = _player_component->getPhysicsComponent();
     auto sprite_component = _player_component->getSpriteComponent();
 
     if (physics_component->getCollidedLoadder() && (input_manager.isActionDown("move_up") || input_manager.isActionDown("move_down")))
     {
-        return std::make_unique<ClimbState>(_player_component);
+        return PlayerStateId::CLIMB;
     }
 
     if (input_manager.isActionDown("move_left"))
@@ -55,17 +53,17 @@ std::unique_ptr<game::component::state::PlayerState> game::component::state::Jum
         sprite_component->setFlipped(false);
     }
 
-    return nullptr;
+    return PlayerStateId::NONE;
 }
 
-std::unique_ptr<game::component::state::PlayerState> game::component::state::JumpState::update(float dt, engine::core::Context &)
+game::component::state::PlayerStateId game::component::state::JumpState::update(float dt, engine::core::Context &)
 {
     auto physics_component = _player_component->getPhysicsComponent();
     auto max_speed = _player_component->getMoveSpeed();
     physics_component->_velocity.x = glm::clamp(physics_component->_velocity.x, -max_speed, max_speed);
     if (physics_component->_velocity.y >= 0.0f)
     {
-        return std::make_unique<FallState>(_player_component);
+        return PlayerStateId::FALL;
     }
-    return nullptr;
+    return PlayerStateId::NONE;
 }
@@ -13,7 +13,7 @@ namespace game::component::state
     private:
         void enter() override;
         void exit() override;
-        std::unique_ptr<PlayerState> handleInput(engine::core::Context &) override;
-        std::unique_ptr<PlayerState> update(float dt, engine::core::Context &) override;
+        PlayerStateId handleInput(engine::core::Context &) override;
+        PlayerStateId update(float dt, engine::core::Context &) override;
     };
 }
\ No newline at end of file
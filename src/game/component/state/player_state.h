@@ -1,5 +1,5 @@
 #pragma once
-#include <memory>
+#include <cstddef>
 #include <string>
 
 namespace engine::core
@@ -14,6 +14,21 @@ namespace game::component
 
 namespace game::component::state
 {
+    /// @brief 玩家状态标识, handleInput/update返回NONE表示保持当前状态
+    enum class PlayerStateId
+    {
+        NONE,
+        IDLE,
+        WALK,
+        JUMP,
+        FALL,
+        CLIMB,
+        HURT,
+        DEAD,
+        COUNT
+    };
+
+    /// @brief 玩家状态基类,每个玩家的各状态对象只创建一次并反复切换
     class PlayerState
     {
         friend class game::component::PlayerComponent;
@@ -34,7 +49,7 @@ namespace game::component::state
     protected:
         virtual void enter() = 0;
         virtual void exit() = 0;
-        virtual std::unique_ptr<PlayerState> handleInput(engine::core::Context &) = 0;
-        virtual std::unique_ptr<PlayerState> update(float dt, engine::core::Context &) = 0;
+        virtual PlayerStateId handleInput(engine::core::Context &) = 0;
+        virtual PlayerStateId update(float dt, engine::core::Context &) = 0;
     };
 }
\ No newline at end of file
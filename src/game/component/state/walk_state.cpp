@@ -1,8 +1,4 @@
 #include "walk_state.h"
-#include "jump_state.h"
-#include "fall_state.h"
-#include "idle_state.h"
-#include "climb_state.h"
 #include "../player_component.h"
 #include "../../../engine/core/context.h"
 #include "../../../engine/input/input_manager.h"
@@ -19,21 +15,21 @@ void game::component::state::WalkState::exit()
 {
 }
 
-std::unique_ptr<game::component::state::PlayerState> game::component::state::WalkState::handleInput(engine::core::Context &context)
+game::component::state::PlayerStateId game::component::state::WalkState::handleInput(engine::core::Context &context)
 {
-    auto input_manager = context.getInputManager();
+    auto &input_manager = context.getInputManager();
     auto physics_component = _player_component->getPhysicsComponent();
     auto sprite_component = _player_component->getSpriteComponent();
 
     if (physics_component->getCollidedLoadder() && input_manager.isActionDown("move_up"))
     {
-        return std::make_unique<ClimbState>(_player_component);
+        return PlayerStateId::CLIMB;
     }
 
     // 如果按下“jump”键,切换到跳跃状态
     if (input_manager.isActionPressed("jump"))
     {
-        return std::make_unique<JumpState>(_player_component);
+        return PlayerStateId::JUMP;
     }
 
     // 左右移动
@@ -59,12 +55,12 @@ std::unique_ptr<game::component::state::PlayerState> game::component::state::Wal
     }
     else
     {
-        return std::make_unique<IdleState>(_player_component);
+        return PlayerStateId::IDLE;
     }
-    return nullptr;
+    return PlayerStateId::NONE;
 }
 
-std::unique_ptr<game::component::state::PlayerState> game::component::state::WalkState::update(float dt, engine::core::Context &)
+game::component::state::PlayerStateId game::component::state::WalkState::update(float dt, engine::core::Context &)
 {
     // 限制最大速度
     auto physics_compont = _player_component->getPhysicsComponent();
@@ -74,7 +70,7 @@ std::unique_ptr<game::component::state::PlayerState> game::component::state::Wal
     // 如果下方没有碰撞 切换到下落状态
     if (!_player_component->isOnGround())
     {
-        return std::make_unique<FallState>(_player_component);
+        return PlayerStateId::FALL;
     }
-    return nullptr;
+    return PlayerStateId::NONE;
 }
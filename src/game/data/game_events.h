@@ -0,0 +1,17 @@
+#pragma once
+
+namespace game::data
+{
+    /// @brief 当前分数发生变化
+    struct ScoreChangedEvent
+    {
+        int score{0};
+    };
+
+    /// @brief 玩家生命值发生变化
+    struct HealthChangedEvent
+    {
+        int current_health{0};
+        int max_health{0};
+    };
+}
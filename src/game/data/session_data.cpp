@@ -67,6 +67,10 @@ void game::data::SessionData::setNextLevel(const std::string &map_path)
 
 bool game::data::SessionData::saveToFile(const std::string &file_path) const
 {
+    if (!_persistence_enabled)
+    {
+        return false;
+    }
     nlohmann::json j;
     try
     {
@@ -123,6 +127,10 @@ bool game::data::SessionData::loadFromFile(const std::string &file_path)
 
 void game::data::SessionData::syncHighScore(const std::string &file_path)
 {
+    if (!_persistence_enabled)
+    {
+        return;
+    }
     try
     {
         // 打开文件进行读取
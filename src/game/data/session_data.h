@@ -18,6 +18,8 @@ namespace game::data
         int _current_round = 0;
         static constexpr int MAX_ROUNDS = 5;
         std::string _map_path = "assets/maps/level1.tmj";
+        /// @brief 为false时不读写存档文件(无头批量运行时避免多实例争用存档)
+        bool _persistence_enabled = true;
 
     public:
         SessionData() = default;
@@ -52,5 +54,6 @@ namespace game::data
         bool loadFromFile(const std::string &file_path);
 
         void syncHighScore(const std::string &file_path);
+        void setPersistenceEnabled(bool enabled) { _persistence_enabled = enabled; }
     };
 }
\ No newline at end of file
@@ -17,9 +17,11 @@ namespace game::scene
 
     EndScene::EndScene(engine::core::Context &context,
                        engine::scene::SceneManager &scene_manager,
-                       std::shared_ptr<game::data::SessionData> session_data)
+                       std::shared_ptr<game::data::SessionData> session_data,
+                       std::function<bool()> restart_handler)
         : engine::scene::Scene("EndScene", context, scene_manager),
-          _session_data(std::move(session_data))
+          _session_data(std::move(session_data)),
+          _restart_handler(std::move(restart_handler))
     {
         if (!_session_data)
         {
@@ -141,6 +143,12 @@ namespace game::scene
     {
         // 重新开始游戏
         _session_data->reset();
+        // 下层的游戏场景能从快照原地恢复时,直接弹出本场景即可
+        if (_restart_handler && _restart_handler())
+        {
+            _scene_manager.requestPopScene();
+            return;
+        }
         _scene_manager.requestReplaceScene(std::make_unique<GameScene>(_context, _scene_manager, _session_data));
     }
 
@@ -1,5 +1,6 @@
 #pragma once
 #include "../../engine/scene/scene.h"
+#include <functional>
 #include <memory>
 #include <string>
 
@@ -45,6 +46,7 @@ namespace game::scene
     {
     private:
         std::shared_ptr<game::data::SessionData> _session_data;
+        std::function<bool()> _restart_handler; ///< @brief 原地重新开始的回调,返回false时重新创建游戏场景
 
     public:
         /**
@@ -52,10 +54,12 @@ namespace game::scene
          * @param context 引擎上下文
          * @param scene_manager 场景管理器
          * @param session_data 指向游戏数据状态的共享指针
+         * @param restart_handler 可选的原地重新开始回调(会话数据重置后调用)
          */
         EndScene(engine::core::Context &context,
                  engine::scene::SceneManager &scene_manager,
-                 std::shared_ptr<game::data::SessionData> session_data);
+                 std::shared_ptr<game::data::SessionData> session_data,
+                 std::function<bool()> restart_handler = nullptr);
 
         ~EndScene() override = default;
 
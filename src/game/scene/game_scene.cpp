@@ -4,6 +4,7 @@
 #include "../../engine/scene/level_loader.h"
 #include "../../engine/input/input_manager.h"
 #include "../../engine/core/context.h"
+#include "../../engine/core/config.h"
 #include "../../engine/core/game_state.h"
 #include "../../engine/component/transform_component.h"
 #include "../../engine/component/sprite_component.h"
@@ -14,6 +15,8 @@
 #include "../../engine/component/health_component.h"
 #include "../component/player_component.h"
 #include "../../engine/object/game_object.h"
+#include "../../engine/render/particle_system.h"
+#include "../../engine/utils/binary_stream.h"
 #include "../../engine/render/camera.h"
 #include "../../engine/render/animation.h"
 #include "../../engine/ui/ui_manager.h"
@@ -29,12 +32,35 @@
 #include "../component/ai/updown_behavior.h"
 #include "../../engine/physics/physics_engine.h"
 #include "../../engine/physics/collider.h"
+#include "../../engine/physics/physics_events.h"
 #include "../../engine/audio/audio_player.h"
+#include "../../engine/resource/resource_manager.h"
 #include "../../engine/scene/scene_manager.h"
 #include "../data/session_data.h"
+#include "../data/game_events.h"
 #include <spdlog/spdlog.h>
+#include "../../engine/utils/log.h"
 #include <SDL3/SDL_rect.h>
 #include <iostream>
+#include <array>
+#include <charconv>
+#include <string_view>
+
+namespace
+{
+    /// @brief 场景逻辑中频繁比较的名称和标签,启动时驻留一次
+    const engine::utils::SymbolId PLAYER = engine::utils::intern("player");
+    const engine::utils::SymbolId WIN = engine::utils::intern("win");
+    const engine::utils::SymbolId EAGLE = engine::utils::intern("eagle");
+    const engine::utils::SymbolId FROG = engine::utils::intern("frog");
+    const engine::utils::SymbolId OPOSSUM = engine::utils::intern("opossum");
+    const engine::utils::SymbolId FRUIT = engine::utils::intern("fruit");
+    const engine::utils::SymbolId GEM = engine::utils::intern("gem");
+    const engine::utils::SymbolId TAG_ENEMY = engine::utils::intern("enemy");
+    const engine::utils::SymbolId TAG_ITEM = engine::utils::intern("item");
+    const engine::utils::SymbolId TAG_HAZARD = engine::utils::intern("hazard");
+    const engine::utils::SymbolId TAG_NEXT_LEVEL = engine::utils::intern("next_level");
+}
 game::scene::GameScene::GameScene(engine::core::Context &context, engine::scene::SceneManager &scene_manager, std::shared_ptr<game::data::SessionData> session_data)
     : Scene("GameScene", context, scene_manager), _game_session_data(std::move(session_data))
 {
@@ -55,6 +81,10 @@ void game::scene::GameScene::init()
     }
     spdlog::info("GameScene initializing ...");
     _context.getGameState().setState(engine::core::State::Playing);
+    if (!_particle_system->loadEffects("assets/effects.json", _context.getResourceManager()))
+    {
+        spdlog::warn("GameScene effects unavailable");
+    }
     _game_session_data->syncHighScore("assets/save.json");
     if (!initlevel())
     {
@@ -83,10 +113,21 @@ void game::scene::GameScene::init()
         _context.getInputManager().setShouldQuit(true);
         return;
     }
+    // 关卡、角色和UI用到的小纹理已全部加载,打包进图集以减少批处理的纹理切换;之前关卡已打包的纹理不会重复处理
+    _context.getResourceManager().packLoadedTextures();
+    subscribeEvents();
     _context.getAudioPlayer().setMusicVolume(0.2f);
     _context.getAudioPlayer().setSoundVolume(0.3f);
     _context.getAudioPlayer().playMusic("assets/audio/hurry_up_and_run.ogg", true, 1000);
     Scene::init();
+    // 记录开局状态,失败后重新开始时原地恢复,无需重新解析关卡和加载资源
+    captureSnapshot();
+    _snapshot_camera_position = _context.getCamera().getPosition();
+    // 时间回溯是调试功能,在配置的debug.rewind_seconds中开启
+    if (const auto &config = _context.getConfig(); config._rewind_seconds > 0.0f)
+    {
+        enableRewind(config._rewind_seconds, static_cast<size_t>(config._rewind_memory_kb) * 1024);
+    }
     spdlog::info("GameScene initialized");
 }
 
@@ -97,6 +138,18 @@ void game::scene::GameScene::update(float dt)
         return;
     }
 
+    // 按住回溯键时逐帧倒退,不推进模拟
+    if (_is_rewinding)
+    {
+        if (rewindStep())
+        {
+            updateHealthWithUI();
+            _context.getCamera().update(dt);
+        }
+        _ui_manager->update(dt, _context);
+        return;
+    }
+
     // 1. 更新物理引擎（生成碰撞对）
     if (_context.getGameState().isPlaying())
     {
@@ -104,29 +157,21 @@ void game::scene::GameScene::update(float dt)
         _context.getCamera().update(dt);
     }
 
-    // 2. 在清理死亡对象之前处理碰撞（碰撞对指针仍有效）
-    handleObjectCollisions();
-    handleTileTriggers();
+    // 2. 在清理死亡对象之前分发碰撞事件（事件中的对象指针仍有效）
+    _collisions_closed = false;
+    auto &event_bus = _context.getEventBus();
+    event_bus.dispatch<engine::physics::CollisionEvent>();
+    event_bus.dispatch<engine::physics::TileTriggerEvent>();
 
     // 3. 更新所有游戏对象（包括清理标记为删除的对象）
-    for (auto it = _game_objects.begin(); it != _game_objects.end();)
-    {
-        if (*it && !(*it)->getNeedRemove())
-        {
-            (*it)->update(dt, _context);
-            ++it;
-        }
-        else
-        {
-            if (*it)
-            {
-                (*it)->clean();
-            }
-            it = _game_objects.erase(it);
-        }
-    }
+    updateAnimations(dt);
+    updateGameObjects(dt);
+    updateParticles(dt);
     _ui_manager->update(dt, _context);
     processPendingAdditions();
+    processSpawnQueue();
+    resolveTransforms();
+    recordRewindFrame(dt);
 
     // 4. 检查玩家是否掉出世界
     if (_player)
@@ -147,6 +192,11 @@ void game::scene::GameScene::render()
 
 void game::scene::GameScene::handleInput()
 {
+    _is_rewinding = getRewindBuffer() && _context.getInputManager().isActionDown("rewind");
+    if (_is_rewinding)
+    {
+        return;
+    }
     Scene::handleInput();
     if (_context.getInputManager().isActionPressed("pause"))
     {
@@ -157,9 +207,54 @@ void game::scene::GameScene::handleInput()
 
 void game::scene::GameScene::clean()
 {
+    _subscriptions.clear();
     Scene::clean();
 }
 
+bool game::scene::GameScene::restoreSnapshot()
+{
+    if (!Scene::restoreSnapshot())
+    {
+        return false;
+    }
+    // 生命值以会话数据为准(重新开始时会话已被重置)
+    if (auto *health_component = _player->getComponent<engine::component::HealthComponent>(); health_component)
+    {
+        health_component->setCurrentHealth(_game_session_data->getCurrentHealth());
+    }
+    updateScoreWithUI();
+    updateHealthWithUI();
+    _context.getCamera().setPosition(_snapshot_camera_position);
+    _context.getGameState().setState(engine::core::State::Playing);
+    return true;
+}
+
+void game::scene::GameScene::saveRewindState(engine::utils::BinaryWriter &writer) const
+{
+    writer.write(_game_session_data->getCurrentScore());
+}
+
+bool game::scene::GameScene::loadRewindState(engine::utils::BinaryReader &reader)
+{
+    auto score = reader.read<int>();
+    if (reader.failed())
+    {
+        return false;
+    }
+    _game_session_data->addScore(score - _game_session_data->getCurrentScore());
+    updateScoreWithUI();
+    return true;
+}
+
+bool game::scene::GameScene::restartLevel()
+{
+    if (_game_session_data->getMapPath() != _level_path || !hasSnapshot())
+    {
+        return false;
+    }
+    return restoreSnapshot();
+}
+
 bool game::scene::GameScene::initlevel()
 {
     engine::scene::LevelLoader level_loader;
@@ -169,6 +264,7 @@ bool game::scene::GameScene::initlevel()
         spdlog::error("Failed to load level");
         return false;
     }
+    _level_path = level_path;
 
     auto *main_layer = findGameObjectByName("main");
     if (!main_layer)
@@ -197,7 +293,7 @@ bool game::scene::GameScene::initlevel()
 
 bool game::scene::GameScene::initplayer()
 {
-    _player = findGameObjectByName("player");
+    _player = findGameObjectByName(PLAYER);
     if (!_player)
     {
         spdlog::error("Failed to find player");
@@ -236,53 +332,59 @@ bool game::scene::GameScene::initplayer()
 bool game::scene::GameScene::initEnemyAndItem()
 {
     bool success = true;
-    for (auto &game_object : _game_objects)
+    for (auto *game_object : findGameObjectsByName(EAGLE))
     {
-        if (game_object->getName() == "eagle")
+        if (auto *ai_component = game_object->addComponent<game::component::AIComponent>(); ai_component)
         {
-            if (auto *ai_component = game_object->addComponent<game::component::AIComponent>(); ai_component)
-            {
-                auto y_max = game_object->getComponent<engine::component::TransformComponent>()->getPosition().y;
-                auto y_min = y_max - 80.0f;
-                ai_component->setBehavior(std::make_unique<game::component::ai::UpDownBehavior>(y_min, y_max));
-            }
+            auto y_max = game_object->getComponent<engine::component::TransformComponent>()->getPosition().y;
+            auto y_min = y_max - 80.0f;
+            ai_component->setBehavior(std::make_unique<game::component::ai::UpDownBehavior>(y_min, y_max));
         }
-        if (game_object->getName() == "frog")
+    }
+    for (auto *game_object : findGameObjectsByName(FROG))
+    {
+        if (auto *ai_component = game_object->addComponent<game::component::AIComponent>(); ai_component)
         {
-            if (auto *ai_component = game_object->addComponent<game::component::AIComponent>(); ai_component)
-            {
-                auto x_max = game_object->getComponent<engine::component::TransformComponent>()->getPosition().x - 10.0f;
-                auto x_min = x_max - 90.0f;
-                ai_component->setBehavior(std::make_unique<game::component::ai::JumpBehavior>(x_min, x_max));
-            }
+            auto x_max = game_object->getComponent<engine::component::TransformComponent>()->getPosition().x - 10.0f;
+            auto x_min = x_max - 90.0f;
+            ai_component->setBehavior(std::make_unique<game::component::ai::JumpBehavior>(x_min, x_max));
         }
-        if (game_object->getName() == "opossum")
+    }
+    for (auto *game_object : findGameObjectsByName(OPOSSUM))
+    {
+        if (auto *ai_component = game_object->addComponent<game::component::AIComponent>(); ai_component)
         {
-            if (auto *ai_component = game_object->addComponent<game::component::AIComponent>(); ai_component)
-            {
-                auto x_max = game_object->getComponent<engine::component::TransformComponent>()->getPosition().x;
-                auto x_min = x_max - 200.0f;
-                ai_component->setBehavior(std::make_unique<game::component::ai::PatrolBehavior>(x_min, x_max));
-            }
+            auto x_max = game_object->getComponent<engine::component::TransformComponent>()->getPosition().x;
+            auto x_min = x_max - 200.0f;
+            ai_component->setBehavior(std::make_unique<game::component::ai::PatrolBehavior>(x_min, x_max));
         }
-        if (game_object->getTarget() == "item")
+    }
+    for (auto *game_object : findGameObjectsByTag(TAG_ITEM))
+    {
+        if (auto *ac = game_object->getComponent<engine::component::AnimationComponent>(); ac)
+        {
+            /* code */
+            ac->playAnimation("idle");
+        }
+        else
         {
-            if (auto *ac = game_object->getComponent<engine::component::AnimationComponent>(); ac)
-            {
-                /* code */
-                ac->playAnimation("idle");
-            }
-            else
-            {
-                spdlog::error("Failed to find item animation component");
-                success = false;
-            }
+            spdlog::error("Failed to find item animation component");
+            success = false;
         }
     }
 
     return success;
 }
 
+void game::scene::GameScene::subscribeEvents()
+{
+    auto &event_bus = _context.getEventBus();
+    _subscriptions.push_back(event_bus.subscribe<engine::physics::CollisionEvent, &GameScene::onCollision>(this));
+    _subscriptions.push_back(event_bus.subscribe<engine::physics::TileTriggerEvent, &GameScene::onTileTrigger>(this));
+    _subscriptions.push_back(event_bus.subscribe<game::data::ScoreChangedEvent, &GameScene::onScoreChanged>(this));
+    _subscriptions.push_back(event_bus.subscribe<game::data::HealthChangedEvent, &GameScene::onHealthChanged>(this));
+}
+
 bool game::scene::GameScene::initUI()
 {
     if (!_ui_manager->init(_context.getGameState().getLogicalSize()))
@@ -294,62 +396,58 @@ bool game::scene::GameScene::initUI()
     return true;
 }
 
-void game::scene::GameScene::handleObjectCollisions()
+void game::scene::GameScene::onCollision(const engine::physics::CollisionEvent &event)
 {
-    auto &collision_pairs = _context.getPhysicsEngine().getCollisionPairs();
-    for (const auto &pair : collision_pairs)
+    auto objcet1 = event.first;
+    auto objcet2 = event.second;
+    if (_collisions_closed || !objcet1 || !objcet2)
     {
-        auto objcet1 = pair.first;
-        auto objcet2 = pair.second;
-        if (!objcet1 || !objcet2)
-        {
-            continue;
-        }
+        return;
+    }
 
-        if (objcet1->getName() == "player" && objcet2->getTarget() == "enemy")
-        {
-            playerVsEnemyCollision(objcet1, objcet2);
-        }
-        else if (objcet2->getName() == "player" && objcet1->getTarget() == "enemy")
-        {
-            playerVsEnemyCollision(objcet2, objcet1);
-        }
-        else if (objcet1->getName() == "player" && objcet2->getTarget() == "item")
-        {
-            playerVsItemCollision(objcet1, objcet2);
-        }
-        else if (objcet2->getName() == "player" && objcet1->getTarget() == "item")
-        {
-            playerVsItemCollision(objcet2, objcet1);
-        }
-        else if (objcet1->getName() == "player" && objcet2->getTarget() == "hazard")
-        {
-            handlePlayerDamage(1);
-        }
-        else if (objcet2->getName() == "player" && objcet1->getTarget() == "hazard")
-        {
-            handlePlayerDamage(1);
-        }
-        else if (objcet1->getName() == "player" && objcet2->getTarget() == "next_level")
-        {
-            toNextLevel(objcet2);
-            return;
-        }
-        else if (objcet2->getName() == "player" && objcet1->getTarget() == "next_level")
-        {
-            toNextLevel(objcet1);
-            return;
-        }
-        else if (objcet1->getName() == "player" && objcet2->getName() == "win")
-        {
-            handleWinTrigger();
-            return;
-        }
-        else if (objcet2->getName() == "player" && objcet1->getName() == "win")
-        {
-            handleWinTrigger();
-            return;
-        }
+    if (objcet1->getNameId() == PLAYER && objcet2->getTargetId() == TAG_ENEMY)
+    {
+        playerVsEnemyCollision(objcet1, objcet2);
+    }
+    else if (objcet2->getNameId() == PLAYER && objcet1->getTargetId() == TAG_ENEMY)
+    {
+        playerVsEnemyCollision(objcet2, objcet1);
+    }
+    else if (objcet1->getNameId() == PLAYER && objcet2->getTargetId() == TAG_ITEM)
+    {
+        playerVsItemCollision(objcet1, objcet2);
+    }
+    else if (objcet2->getNameId() == PLAYER && objcet1->getTargetId() == TAG_ITEM)
+    {
+        playerVsItemCollision(objcet2, objcet1);
+    }
+    else if (objcet1->getNameId() == PLAYER && objcet2->getTargetId() == TAG_HAZARD)
+    {
+        handlePlayerDamage(1);
+    }
+    else if (objcet2->getNameId() == PLAYER && objcet1->getTargetId() == TAG_HAZARD)
+    {
+        handlePlayerDamage(1);
+    }
+    else if (objcet1->getNameId() == PLAYER && objcet2->getTargetId() == TAG_NEXT_LEVEL)
+    {
+        toNextLevel(objcet2);
+        _collisions_closed = true;
+    }
+    else if (objcet2->getNameId() == PLAYER && objcet1->getTargetId() == TAG_NEXT_LEVEL)
+    {
+        toNextLevel(objcet1);
+        _collisions_closed = true;
+    }
+    else if (objcet1->getNameId() == PLAYER && objcet2->getNameId() == WIN)
+    {
+        handleWinTrigger();
+        _collisions_closed = true;
+    }
+    else if (objcet2->getNameId() == PLAYER && objcet1->getNameId() == WIN)
+    {
+        handleWinTrigger();
+        _collisions_closed = true;
     }
 }
 
@@ -365,7 +463,7 @@ void game::scene::GameScene::playerVsEnemyCollision(engine::object::GameObject *
     // 踩踏判断成功，敌人受伤
     if (overlap.x > overlap.y && player_center.y < enemy_center.y)
     {
-        spdlog::info("player {} attack {}", player->getName(), enemy->getName());
+        ENGINE_LOG_DEBUG("player {} attack {}", player->getName(), enemy->getName());
         auto enemy_health = enemy->getComponent<engine::component::HealthComponent>();
         if (!enemy_health)
         { /* ... */
@@ -393,11 +491,11 @@ void game::scene::GameScene::playerVsEnemyCollision(engine::object::GameObject *
 
 void game::scene::GameScene::playerVsItemCollision(engine::object::GameObject *player, engine::object::GameObject *item)
 {
-    if (item->getName() == "fruit")
+    if (item->getNameId() == FRUIT)
     {
         healWithUI(1);
     }
-    else if (item->getName() == "gem")
+    else if (item->getNameId() == GEM)
     {
         addScoreWithUI(10);
     }
@@ -407,21 +505,12 @@ void game::scene::GameScene::playerVsItemCollision(engine::object::GameObject *p
     _context.getAudioPlayer().playSound("assets/audio/poka01.mp3");
 }
 
-void game::scene::GameScene::handleTileTriggers()
+void game::scene::GameScene::onTileTrigger(const engine::physics::TileTriggerEvent &event)
 {
-    const auto &tile_trigger_events = _context.getPhysicsEngine().getTileTriggerEvents();
-    for (const auto &event : tile_trigger_events)
+    // 如果是玩家碰到了危险瓦片，就受伤
+    if (event.tile_type == engine::component::TileType::HAZARD && event.object && event.object->getNameId() == PLAYER)
     {
-        auto *obj = event.first;       // 触发事件的对象
-        auto tile_type = event.second; // 瓦片类型
-        if (tile_type == engine::component::TileType::HAZARD)
-        {
-            // 如果是玩家碰到了危险瓦片，就受伤
-            if (obj->getName() == "player")
-            {
-                handlePlayerDamage(1);
-            }
-        }
+        handlePlayerDamage(1);
     }
 }
 
@@ -441,42 +530,7 @@ void game::scene::GameScene::handlePlayerDamage(int damage)
 
 void game::scene::GameScene::createEffect(const glm::vec2 &center_pos, const std::string &tag)
 {
-    auto effect_obj = std::make_unique<engine::object::GameObject>("effect_" + tag);
-    effect_obj->addComponent<engine::component::TransformComponent>(center_pos);
-
-    // 根据标签创建不同的精灵组件和动画
-    auto animation = std::make_unique<engine::render::Animation>("effect", false); // false表示不循环
-    if (tag == "enemy")
-    {
-        effect_obj->addComponent<engine::component::SpriteComponent>("assets/textures/FX/enemy-deadth.png",
-                                                                     _context.getResourceManager(),
-                                                                     engine::utils::Alignment::CENTER);
-        for (auto i = 0; i < 5; ++i)
-        {
-            animation->addFrame({static_cast<int>(i * 40), 0, 40, 41}, 0.1f);
-        }
-    }
-    else if (tag == "item")
-    {
-        effect_obj->addComponent<engine::component::SpriteComponent>("assets/textures/FX/item-feedback.png", _context.getResourceManager(),
-                                                                     engine::utils::Alignment::CENTER);
-        for (auto i = 0; i < 4; ++i)
-        {
-            animation->addFrame({static_cast<int>(i * 32), 0, 32, 32}, 0.1f);
-        }
-    }
-    else
-    {
-        return;
-    }
-
-    // 添加动画组件，并设置为单次播放后自动移除
-    auto *animation_component = effect_obj->addComponent<engine::component::AnimationComponent>();
-    animation_component->addAnimation(std::move(animation));
-    animation_component->setOneShotRemoval(true); // 核心！
-    animation_component->playAnimation("effect");
-
-    safeAddGameObject(std::move(effect_obj)); // 安全添加特效对象
+    _particle_system->emit(tag, center_pos); // 特效名与标签相同,未定义的标签忽略
 }
 
 void game::scene::GameScene::toNextLevel(engine::object::GameObject *trigger)
@@ -506,7 +560,8 @@ void game::scene::GameScene::handleWinTrigger()
 void game::scene::GameScene::showEndScene(bool is_win)
 {
     _game_session_data->setIsWin(is_win);
-    auto end_scene = std::make_unique<game::scene::EndScene>(_context, _scene_manager, _game_session_data);
+    auto end_scene = std::make_unique<game::scene::EndScene>(_context, _scene_manager, _game_session_data,
+                                                             [this]() { return restartLevel(); });
     _scene_manager.requestPushScene(std::move(end_scene));
 }
 
@@ -560,9 +615,22 @@ void game::scene::GameScene::createHealthUI()
 void game::scene::GameScene::addScoreWithUI(int score)
 {
     _game_session_data->addScore(score);
-    auto score_text = "Score:" + std::to_string(_game_session_data->getCurrentScore());
-    spdlog::info("Score: {}", score_text);
-    _score_label->setText(score_text);
+    updateScoreWithUI();
+}
+
+void game::scene::GameScene::updateScoreWithUI()
+{
+    _context.getEventBus().publish(game::data::ScoreChangedEvent{_game_session_data->getCurrentScore()});
+}
+
+void game::scene::GameScene::onScoreChanged(const game::data::ScoreChangedEvent &event)
+{
+    // 在栈上拼接分数文本,避免每次加分都产生临时字符串
+    constexpr std::string_view prefix = "Score:";
+    std::array<char, 32> buffer{};
+    std::copy(prefix.begin(), prefix.end(), buffer.begin());
+    auto result = std::to_chars(buffer.data() + prefix.size(), buffer.data() + buffer.size(), event.score);
+    _score_label->setText(std::string_view(buffer.data(), static_cast<size_t>(result.ptr - buffer.data())));
 }
 
 void game::scene::GameScene::healWithUI(int amount)
@@ -581,10 +649,14 @@ void game::scene::GameScene::updateHealthWithUI()
 
     auto current_health = _player->getComponent<engine::component::HealthComponent>()->getCurrentHealth();
     _game_session_data->setCurrentHealth(current_health);
-    auto max_health = _game_session_data->getMaxHealth();
+    _context.getEventBus().publish(game::data::HealthChangedEvent{current_health, _game_session_data->getMaxHealth()});
+}
 
+void game::scene::GameScene::onHealthChanged(const game::data::HealthChangedEvent &event)
+{
+    auto max_health = event.max_health;
     for (auto i = max_health; i < max_health * 2; ++i)
     {
-        _health_panel->getChildren()[i]->setVisible(i - max_health < current_health);
+        _health_panel->getChildren()[i]->setVisible(i - max_health < event.current_health);
     }
 }
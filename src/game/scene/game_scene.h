@@ -1,6 +1,9 @@
 #pragma once
 #include "../../engine/scene/scene.h"
+#include "../../engine/core/event_bus.h"
 #include <memory>
+#include <string>
+#include <vector>
 #include <glm/glm.hpp>
 namespace engine::object
 {
@@ -9,6 +12,13 @@ namespace engine::object
 namespace game::data
 {
     class SessionData;
+    struct ScoreChangedEvent;
+    struct HealthChangedEvent;
+}
+namespace engine::physics
+{
+    struct CollisionEvent;
+    struct TileTriggerEvent;
 }
 namespace engine::ui
 {
@@ -26,6 +36,14 @@ namespace game::scene
         engine::ui::UILabel *_score_label{nullptr};
         engine::ui::UIPanel *_health_panel{nullptr};
 
+        std::string _level_path;             ///< @brief 本场景加载的关卡路径,用于判断快照能否复用
+        glm::vec2 _snapshot_camera_position{}; ///< @brief 快照时的相机位置
+        bool _is_rewinding{false};            ///< @brief 本帧是否按住回溯键
+        /// @brief 本帧已切换关卡或结束,忽略剩余的碰撞事件
+        bool _collisions_closed{false};
+        /// @brief 事件监听句柄,clean时注销
+        std::vector<engine::core::EventSubscription> _subscriptions;
+
     public:
         GameScene(engine::core::Context &context, engine::scene::SceneManager &scene_manager, std::shared_ptr<game::data::SessionData> session_data = nullptr);
         void init() override;
@@ -33,19 +51,32 @@ namespace game::scene
         void render() override;
         void handleInput() override;
         void clean() override;
+        /// @brief 恢复开局快照并同步会话数据、UI与相机
+        bool restoreSnapshot() override;
+        /// @brief 会话数据仍指向本关卡时,原地恢复开局状态
+        /// @return 无法复用快照时返回false,由调用者重新创建场景
+        bool restartLevel();
+
+    protected:
+        void saveRewindState(engine::utils::BinaryWriter &writer) const override;
+        bool loadRewindState(engine::utils::BinaryReader &reader) override;
 
     private:
         [[nodiscard]] bool initlevel();
         [[nodiscard]] bool initplayer();
         [[nodiscard]] bool initEnemyAndItem();
         [[nodiscard]] bool initUI();
+        void subscribeEvents();
 
-        void handleObjectCollisions();
+        void onCollision(const engine::physics::CollisionEvent &event);
+        void onTileTrigger(const engine::physics::TileTriggerEvent &event);
+        void onScoreChanged(const game::data::ScoreChangedEvent &event);
+        void onHealthChanged(const game::data::HealthChangedEvent &event);
         void playerVsEnemyCollision(engine::object::GameObject *player, engine::object::GameObject *enemy);
         void playerVsItemCollision(engine::object::GameObject *player, engine::object::GameObject *item);
 
-        void handleTileTriggers();
         void handlePlayerDamage(int damage);
+        /// @brief 在center_pos处发射与tag同名的粒子特效
         void createEffect(const glm::vec2 &center_pos, const std::string &tag);
         void toNextLevel(engine::object::GameObject *trigger);
         std::string levelNameToPath(const std::string &level_name) const { return "assets/maps/" + level_name + ".tmj"; };
@@ -55,6 +86,7 @@ namespace game::scene
         void createScoreUI();
         void createHealthUI();
         void addScoreWithUI(int score);
+        void updateScoreWithUI();
         void healWithUI(int amount);
         void updateHealthWithUI();
     };
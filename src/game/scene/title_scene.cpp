@@ -45,6 +45,8 @@ namespace game::scene
         }
         // 加载背景地图
         engine::scene::LevelLoader level_loader;
+        // 背景地图中的敌人和道具只是装饰,由生成队列在之后几帧内构造,缩短进入标题的卡顿
+        level_loader.setDeferObjects(true);
         if (!level_loader.loadLevel("assets/maps/level0.tmj", *this))
         {
             spdlog::error("loadLevel failed.");
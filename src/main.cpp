@@ -2,15 +2,124 @@
 #include <SDL3/SDL_main.h>
 #include <spdlog/spdlog.h>
 #include "engine/scene/scene_manager.h"
+#include "engine/core/config.h"
+#include "engine/core/context.h"
+#include "engine/core/headless_runner.h"
+#include "engine/utils/log.h"
+#include "engine/utils/alloc_counter.h"
+#include "engine/input/input_manager.h"
 #include "game/scene/splash_scene.h"
+#include "game/scene/game_scene.h"
+#include "game/data/session_data.h"
 #include <spdlog/sinks/basic_file_sink.h>
+#include <charconv>
+#include <chrono>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 void setupInitialScene(engine::scene::SceneManager &sceneManager)
 {
     auto splashScene = std::make_unique<game::scene::SplashScene>(sceneManager.getContext(), sceneManager);
     sceneManager.requestPushScene(std::move(splashScene));
 }
-int main(int, char **)
+
+/// @brief 解析正整数参数,格式错误、为0或带多余字符时抛出std::invalid_argument
+uint64_t parsePositive(const char *text, const char *name)
+{
+    const std::string_view str(text);
+    uint64_t value = 0;
+    auto [end, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+    if (ec != std::errc() || end != str.data() + str.size() || value == 0)
+    {
+        throw std::invalid_argument(std::string(name) + " must be a positive integer, got '" + std::string(str) + "'");
+    }
+    return value;
+}
+
+/// @brief 无头批量试玩: --headless [实例数] [最大帧数]
+/// 每个实例直接进入GameScene,由简单的脚本机器人一直向右走并周期性跳跃,玩家死亡或通关即结束
+int runHeadless(int argc, char **argv)
+{
+    engine::core::HeadlessRunner::Settings settings;
+    try
+    {
+        if (argc > 4)
+        {
+            throw std::invalid_argument("too many arguments");
+        }
+        settings.instance_count = argc > 2 ? static_cast<size_t>(parsePositive(argv[2], "instances")) : 4;
+        settings.max_frames = argc > 3 ? parsePositive(argv[3], "max_frames") : 3600;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Invalid arguments: " << e.what() << std::endl;
+        std::cerr << "Usage: " << argv[0] << " --headless [instances] [max_frames]" << std::endl;
+        return 1;
+    }
+
+    std::unique_ptr<engine::core::Config> config;
+    try
+    {
+        config = std::make_unique<engine::core::Config>("assets/config.json");
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Failed to load config: " << e.what() << std::endl;
+        return 1;
+    }
+    engine::core::HeadlessRunner runner(*config);
+    auto scene_factory = [](size_t, engine::core::Context &context, engine::scene::SceneManager &scene_manager)
+    {
+        auto session_data = std::make_shared<game::data::SessionData>();
+        session_data->setPersistenceEnabled(false);
+        return std::make_unique<game::scene::GameScene>(context, scene_manager, std::move(session_data));
+    };
+    auto input_script = [](const engine::core::HeadlessFrame &frame)
+    {
+        // 离开游戏场景(弹出结束界面)即视为本局结束
+        if (frame.frame > 0 && !dynamic_cast<game::scene::GameScene *>(frame.scene_manager.getCurrentScene()))
+        {
+            return false;
+        }
+        auto &input_manager = frame.context.getInputManager();
+        input_manager.setActionActive("move_right", true);
+        // 不同实例错开起跳时机,覆盖更多路线
+        input_manager.setActionActive("jump", (frame.frame + frame.instance * 7) % 45 < 10);
+        return true;
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    auto results = runner.run(settings, scene_factory, input_script);
+    const double wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    uint64_t total_frames = 0;
+    int failed = 0;
+    for (const auto &result : results)
+    {
+        if (!result.ok)
+        {
+            ++failed;
+            std::cout << "instance " << result.instance << " failed: " << result.error << std::endl;
+            continue;
+        }
+        total_frames += result.frames;
+        std::cout << "instance " << result.instance << ": " << result.frames << " frames in " << result.seconds << "s";
+        if constexpr (engine::utils::ALLOCATION_TRACKING_ENABLED)
+        {
+            std::cout << ", " << result.allocating_frames << " frames with heap allocations after warm-up (peak " << result.peak_frame_allocations << ")";
+        }
+        std::cout << std::endl;
+    }
+    // 总吞吐按墙钟时间计算(含实例创建),不同实例数之间对比即可看出并行扩展情况
+    const double frames_per_second = wall_seconds > 0.0 ? total_frames / wall_seconds : 0.0;
+    std::cout << settings.instance_count << " instances: " << total_frames << " frames in " << wall_seconds << "s wall, "
+              << frames_per_second << " frames/s aggregate, " << frames_per_second / static_cast<double>(settings.instance_count)
+              << " frames/s per instance" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
+
+int main(int argc, char **argv)
 {
 
     try
@@ -20,6 +129,8 @@ int main(int, char **)
         spdlog::set_level(spdlog::level::off);
         spdlog::set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] %v");
         spdlog::flush_on(spdlog::level::info);
+        // 文件写入交给后台线程,游戏线程只写环形缓冲
+        engine::utils::Log::init();
     }
     catch (const spdlog::spdlog_ex &ex)
     {
@@ -28,10 +139,28 @@ int main(int, char **)
         return 1;
     }
 
+    if (argc > 1 && std::string_view(argv[1]) == "--headless")
+    {
+        int exit_code = runHeadless(argc, argv);
+        engine::utils::Log::shutdown();
+        spdlog::shutdown();
+        return exit_code;
+    }
+
+    // --render-backend offscreen|null 可在无显示的机器上运行完整游戏, --max-frames 限定帧数后退出,
+    // --render-stats-csv 逐帧记录渲染统计
     engine::core::GameApp app;
     app.registerSceneSutep(setupInitialScene);
+    if (!app.parseCommandLine(argc, argv))
+    {
+        std::cerr << "Usage: " << argv[0] << " [--render-backend sdl|offscreen|null] [--max-frames N] [--render-stats-csv path]" << std::endl;
+        engine::utils::Log::shutdown();
+        spdlog::shutdown();
+        return 1;
+    }
     app.run();
 
+    engine::utils::Log::shutdown();
     spdlog::shutdown();
     return 0;
 }
\ No newline at end of file